@@ -28,8 +28,10 @@ $(TEST_OUTPUT)_SRC := \
 	tests/test_common/keycode_util.cpp \
 	tests/test_common/keycode_table.cpp \
 	tests/test_common/test_fixture.cpp \
+	tests/test_common/test_key_trace.cpp \
 	tests/test_common/test_keymap_key.cpp \
 	tests/test_common/test_logger.cpp \
+	tests/test_common/test_simulator.cpp \
 	$(patsubst $(ROOTDIR)/%,%,$(wildcard $(TEST_PATH)/*.cpp))
 
 $(TEST_OUTPUT)_DEFS := $(OPT_DEFS) "-DKEYMAP_C=\"keymap.c\""
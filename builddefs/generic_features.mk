@@ -35,7 +35,9 @@ GENERIC_FEATURES = \
     GRAVE_ESC \
     HAPTIC \
     KEY_LOCK \
+    KEYEVENT_QUEUE \
     KEY_OVERRIDE \
+    KEY_TRACE \
     LAYER_LOCK \
     LEADER \
     MAGIC \
@@ -123,3 +123,12 @@
 #ifndef EXTERNAL_EEPROM_WRITE_TIME
 #    define EXTERNAL_EEPROM_WRITE_TIME 5
 #endif
+
+/*
+    The time in milliseconds to wait for the EEPROM to complete a write cycle.
+    The EEPROM is polled until it acknowledges its address again, so this only
+    bounds the wait should it never do so.
+*/
+#ifndef EXTERNAL_EEPROM_WRITE_TIMEOUT
+#    define EXTERNAL_EEPROM_WRITE_TIMEOUT (EXTERNAL_EEPROM_WRITE_TIME * 2)
+#endif
@@ -0,0 +1,187 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <stdint.h>
+#include <string.h>
+
+#include "timer.h"
+#include "util.h"
+#include "eeprom.h"
+#include "eeprom_driver.h"
+#include "eeprom_page_cache.h"
+
+/*
+    Page cache for external EEPROMs:
+
+        Each write to an external EEPROM costs a bus transaction and a write
+        cycle of several milliseconds, regardless of how many bytes of the page
+        it covers. Bulk updates such as a VIA keymap upload arrive as many small
+        writes, so writing through spends most of its time waiting on the
+        EEPROM.
+
+        With EXTERNAL_EEPROM_PAGE_CACHE_COUNT pages cached, writes land in RAM
+        and the dirty part of each page is written in a single burst when the
+        page is evicted, EXTERNAL_EEPROM_PAGE_CACHE_TIMEOUT ms after the last
+        write, or when eeprom_driver_flush() is called. Pages are evicted least
+        recently used first.
+*/
+
+#if EXTERNAL_EEPROM_PAGE_CACHE_COUNT > 0
+
+typedef struct {
+    uintptr_t address;
+    uint16_t  last_used;
+    uint16_t  dirty_start;
+    uint16_t  dirty_end; // no dirty data if equal to dirty_start
+    bool      valid;
+    uint8_t   data[EXTERNAL_EEPROM_PAGE_SIZE];
+} eeprom_page_t;
+
+static eeprom_page_t pages[EXTERNAL_EEPROM_PAGE_CACHE_COUNT];
+static uint16_t      use_counter = 0;
+static uint16_t      last_write  = 0;
+
+static inline bool eeprom_page_is_dirty(const eeprom_page_t *page) {
+    return page->dirty_end > page->dirty_start;
+}
+
+static void eeprom_page_write_back(eeprom_page_t *page) {
+    if (eeprom_page_is_dirty(page)) {
+        external_eeprom_write_page(page->address + page->dirty_start, &page->data[page->dirty_start], page->dirty_end - page->dirty_start);
+        page->dirty_start = page->dirty_end = 0;
+    }
+}
+
+static eeprom_page_t *eeprom_page_find(uintptr_t address) {
+    for (uint8_t i = 0; i < EXTERNAL_EEPROM_PAGE_CACHE_COUNT; ++i) {
+        if (pages[i].valid && pages[i].address == address) {
+            pages[i].last_used = ++use_counter;
+            return &pages[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Makes room for a page in the cache, evicting the least recently used page. The contents are read from the EEPROM
+ * unless they're about to be overwritten in their entirety.
+ */
+static eeprom_page_t *eeprom_page_allocate(uintptr_t address, bool fill) {
+    eeprom_page_t *page = &pages[0];
+    for (uint8_t i = 0; i < EXTERNAL_EEPROM_PAGE_CACHE_COUNT; ++i) {
+        if (!pages[i].valid) {
+            page = &pages[i];
+            break;
+        }
+        if ((uint16_t)(use_counter - pages[i].last_used) > (uint16_t)(use_counter - page->last_used)) {
+            page = &pages[i];
+        }
+    }
+
+    if (page->valid) {
+        eeprom_page_write_back(page);
+    }
+
+    page->address     = address;
+    page->last_used   = ++use_counter;
+    page->dirty_start = page->dirty_end = 0;
+    page->valid       = true;
+    if (fill) {
+        external_eeprom_read(address, page->data, EXTERNAL_EEPROM_PAGE_SIZE);
+    }
+    return page;
+}
+
+void eeprom_driver_flush(void) {
+    for (uint8_t i = 0; i < EXTERNAL_EEPROM_PAGE_CACHE_COUNT; ++i) {
+        if (pages[i].valid) {
+            eeprom_page_write_back(&pages[i]);
+        }
+    }
+}
+
+void eeprom_driver_task(void) {
+    if (timer_elapsed(last_write) >= (EXTERNAL_EEPROM_PAGE_CACHE_TIMEOUT)) {
+        eeprom_driver_flush();
+    }
+}
+
+void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    uint8_t * out         = (uint8_t *)buf;
+    uintptr_t target_addr = (uintptr_t)addr;
+
+    while (len > 0) {
+        uintptr_t page_offset = target_addr % EXTERNAL_EEPROM_PAGE_SIZE;
+        size_t    read_length = MIN(len, EXTERNAL_EEPROM_PAGE_SIZE - page_offset);
+
+        eeprom_page_t *page = eeprom_page_find(target_addr - page_offset);
+        if (page) {
+            memcpy(out, &page->data[page_offset], read_length);
+        } else {
+            external_eeprom_read(target_addr, out, read_length);
+        }
+
+        out += read_length;
+        target_addr += read_length;
+        len -= read_length;
+    }
+}
+
+void eeprom_write_block(const void *buf, void *addr, size_t len) {
+    const uint8_t *in          = (const uint8_t *)buf;
+    uintptr_t      target_addr = (uintptr_t)addr;
+
+    while (len > 0) {
+        uintptr_t page_offset  = target_addr % EXTERNAL_EEPROM_PAGE_SIZE;
+        size_t    write_length = MIN(len, EXTERNAL_EEPROM_PAGE_SIZE - page_offset);
+
+        eeprom_page_t *page = eeprom_page_find(target_addr - page_offset);
+        if (!page) {
+            page = eeprom_page_allocate(target_addr - page_offset, write_length < EXTERNAL_EEPROM_PAGE_SIZE);
+        }
+
+        memcpy(&page->data[page_offset], in, write_length);
+        if (eeprom_page_is_dirty(page)) {
+            page->dirty_start = MIN(page->dirty_start, page_offset);
+            page->dirty_end   = MAX(page->dirty_end, page_offset + write_length);
+        } else {
+            page->dirty_start = page_offset;
+            page->dirty_end   = page_offset + write_length;
+        }
+
+        in += write_length;
+        target_addr += write_length;
+        len -= write_length;
+    }
+
+    last_write = timer_read();
+}
+
+#else // EXTERNAL_EEPROM_PAGE_CACHE_COUNT > 0
+
+void eeprom_driver_flush(void) {}
+
+void eeprom_driver_task(void) {}
+
+void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    external_eeprom_read((uintptr_t)addr, buf, len);
+}
+
+void eeprom_write_block(const void *buf, void *addr, size_t len) {
+    const uint8_t *in          = (const uint8_t *)buf;
+    uintptr_t      target_addr = (uintptr_t)addr;
+
+    while (len > 0) {
+        uintptr_t page_offset  = target_addr % EXTERNAL_EEPROM_PAGE_SIZE;
+        size_t    write_length = MIN(len, EXTERNAL_EEPROM_PAGE_SIZE - page_offset);
+
+        if (!external_eeprom_write_page(target_addr, in, write_length)) {
+            return;
+        }
+
+        in += write_length;
+        target_addr += write_length;
+        len -= write_length;
+    }
+}
+
+#endif // EXTERNAL_EEPROM_PAGE_CACHE_COUNT > 0
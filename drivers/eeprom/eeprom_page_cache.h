@@ -0,0 +1,34 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+    The number of EEPROM pages cached in RAM. Writes to cached pages are held
+    back and written out a page at a time, saving a write cycle per write to
+    the same page. Reads are served from the cache where possible. 0 disables
+    the cache, writing through instead.
+*/
+#ifndef EXTERNAL_EEPROM_PAGE_CACHE_COUNT
+#    define EXTERNAL_EEPROM_PAGE_CACHE_COUNT 0
+#endif
+
+/*
+    The time in milliseconds since the last write before cached pages are
+    written out.
+*/
+#ifndef EXTERNAL_EEPROM_PAGE_CACHE_TIMEOUT
+#    define EXTERNAL_EEPROM_PAGE_CACHE_TIMEOUT 100
+#endif
+
+/*
+    Implemented by the external EEPROM driver.
+
+    external_eeprom_write_page() is only ever given data within a single page,
+    and returns once the EEPROM has completed the write cycle.
+*/
+void external_eeprom_read(uintptr_t addr, void *buf, size_t len);
+bool external_eeprom_write_page(uintptr_t addr, const void *buf, size_t len);
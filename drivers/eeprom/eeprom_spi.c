@@ -37,6 +37,7 @@
 #include "eeprom.h"
 #include "eeprom_driver.h"
 #include "eeprom_spi.h"
+#include "eeprom_page_cache.h"
 
 #define CMD_WREN 6
 #define CMD_WRDI 4
@@ -110,13 +111,14 @@ void eeprom_driver_erase(void) {
     for (uint32_t addr = 0; addr < EXTERNAL_EEPROM_BYTE_COUNT; addr += EXTERNAL_EEPROM_PAGE_SIZE) {
         eeprom_write_block(buf, (void *)(uintptr_t)addr, EXTERNAL_EEPROM_PAGE_SIZE);
     }
+    eeprom_driver_flush();
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
     dprintf("EEPROM erase took %ldms to complete\n", ((long)(timer_read32() - start)));
 #endif
 }
 
-void eeprom_read_block(void *buf, const void *addr, size_t len) {
+void external_eeprom_read(uintptr_t addr, void *buf, size_t len) {
     //-------------------------------------------------
     // Wait for the write-in-progress bit to be cleared
     spi_status_t response = spi_eeprom_wait_while_busy(EXTERNAL_EEPROM_SPI_TIMEOUT);
@@ -138,11 +140,11 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
     }
 
     spi_write(CMD_READ);
-    spi_eeprom_transmit_address((uintptr_t)addr);
+    spi_eeprom_transmit_address(addr);
     spi_receive(buf, len);
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
-    dprintf("[EEPROM R] 0x%08lX: ", ((uint32_t)(uintptr_t)addr));
+    dprintf("[EEPROM R] 0x%08lX: ", ((uint32_t)addr));
     for (size_t i = 0; i < len; ++i) {
         dprintf(" %02X", (int)(((uint8_t *)buf)[i]));
     }
@@ -152,74 +154,59 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
     spi_stop();
 }
 
-void eeprom_write_block(const void *buf, void *addr, size_t len) {
-    bool      res;
-    uint8_t * read_buf    = (uint8_t *)buf;
-    uintptr_t target_addr = (uintptr_t)addr;
+bool external_eeprom_write_page(uintptr_t addr, const void *buf, size_t len) {
+    bool res;
 
-    while (len > 0) {
-        uintptr_t page_offset  = target_addr % EXTERNAL_EEPROM_PAGE_SIZE;
-        int       write_length = EXTERNAL_EEPROM_PAGE_SIZE - page_offset;
-        if (write_length > len) {
-            write_length = len;
-        }
-
-        //-------------------------------------------------
-        // Wait for the write-in-progress bit to be cleared
-        spi_status_t response = spi_eeprom_wait_while_busy(EXTERNAL_EEPROM_SPI_TIMEOUT);
-        if (response != SPI_STATUS_SUCCESS) {
-            spi_stop();
-            dprint("SPI timeout for WIP check\n");
-            return;
-        }
-
-        //-------------------------------------------------
-        // Enable writes
-        res = spi_eeprom_start();
-        if (!res) {
-            spi_stop();
-            dprint("failed to start SPI for write-enable\n");
-            return;
-        }
-
-        spi_write(CMD_WREN);
+    //-------------------------------------------------
+    // Wait for the write-in-progress bit to be cleared
+    spi_status_t response = spi_eeprom_wait_while_busy(EXTERNAL_EEPROM_SPI_TIMEOUT);
+    if (response != SPI_STATUS_SUCCESS) {
         spi_stop();
+        dprint("SPI timeout for WIP check\n");
+        return false;
+    }
 
-        //-------------------------------------------------
-        // Perform the write
-        res = spi_eeprom_start();
-        if (!res) {
-            spi_stop();
-            dprint("failed to start SPI for write\n");
-            return;
-        }
-
-#if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
-        dprintf("[EEPROM W] 0x%08lX: ", ((uint32_t)(uintptr_t)target_addr));
-        for (size_t i = 0; i < write_length; i++) {
-            dprintf(" %02X", (int)(uint8_t)(read_buf[i]));
-        }
-        dprintf("\n");
-#endif // DEBUG_EEPROM_OUTPUT
-
-        spi_write(CMD_WRITE);
-        spi_eeprom_transmit_address(target_addr);
-        spi_transmit(read_buf, write_length);
+    //-------------------------------------------------
+    // Enable writes
+    res = spi_eeprom_start();
+    if (!res) {
         spi_stop();
-
-        read_buf += write_length;
-        target_addr += write_length;
-        len -= write_length;
+        dprint("failed to start SPI for write-enable\n");
+        return false;
     }
 
+    spi_write(CMD_WREN);
+    spi_stop();
+
     //-------------------------------------------------
-    // Disable writes
+    // Perform the write
     res = spi_eeprom_start();
     if (!res) {
-        dprint("failed to start SPI for write-disable\n");
-        return;
+        spi_stop();
+        dprint("failed to start SPI for write\n");
+        return false;
+    }
+
+#if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
+    dprintf("[EEPROM W] 0x%08lX: ", ((uint32_t)addr));
+    for (size_t i = 0; i < len; i++) {
+        dprintf(" %02X", (int)(((const uint8_t *)buf)[i]));
     }
+    dprintf("\n");
+#endif // DEBUG_EEPROM_OUTPUT
 
-    spi_write(CMD_WRDI);
+    spi_write(CMD_WRITE);
+    spi_eeprom_transmit_address(addr);
+    spi_transmit(buf, len);
     spi_stop();
+
+    //-------------------------------------------------
+    // Wait for the write cycle to complete, the write enable latch is cleared along with the write-in-progress bit
+    response = spi_eeprom_wait_while_busy(EXTERNAL_EEPROM_SPI_TIMEOUT);
+    if (response != SPI_STATUS_SUCCESS) {
+        spi_stop();
+        dprint("SPI timeout for WIP check\n");
+        return false;
+    }
+    return true;
 }
@@ -4,9 +4,62 @@
 #include <string.h>
 
 #include "eeprom_driver.h"
+#include "eeprom_wear_leveling.h"
 #include "wear_leveling.h"
+#include "timer.h"
+#include "util.h"
+
+/*
+    Write combining:
+
+        Each write to the wear-leveling layer consumes a write log entry, so
+        eeprom_update_byte() calls to adjacent addresses in quick succession,
+        such as the two halves of a dynamic keymap keycode, would otherwise
+        each take up their own entry.
+
+        Instead, writes are held back in a small buffer for up to
+        EEPROM_WRITE_COMBINE_TIMEOUT milliseconds. Subsequent writes which
+        overlap or are adjacent to the buffered data are merged into it, as
+        long as the result fits in a single multi-byte log entry. The buffer
+        is written out once it times out, or when an incompatible write comes
+        along. Reads are served from the buffer where it overlaps, so there's
+        no need to write it out beforehand.
+*/
+
+static struct {
+    uint32_t address;
+    uint16_t last_write;
+    uint8_t  length;
+    uint8_t  data[EEPROM_WRITE_COMBINE_SIZE];
+} write_combine;
+
+/**
+ * Merges a write into the buffer, if it overlaps or is adjacent to the buffered data and the result still fits.
+ */
+static bool eeprom_write_combine(uint32_t address, const uint8_t *buf, size_t len) {
+    uint32_t end         = address + len;
+    uint32_t pending_end = write_combine.address + write_combine.length;
+    if (write_combine.length == 0 || address > pending_end || end < write_combine.address) {
+        return false;
+    }
+
+    uint32_t start = MIN(address, write_combine.address);
+    if (MAX(end, pending_end) - start > (EEPROM_WRITE_COMBINE_SIZE)) {
+        return false;
+    }
+
+    // Make room for data before the buffered data
+    if (start < write_combine.address) {
+        memmove(&write_combine.data[write_combine.address - start], write_combine.data, write_combine.length);
+        write_combine.address = start;
+    }
+    memcpy(&write_combine.data[address - start], buf, len);
+    write_combine.length = MAX(end, pending_end) - start;
+    return true;
+}
 
 void eeprom_driver_init(void) {
+    write_combine.length = 0;
     wear_leveling_init();
 }
 
@@ -17,13 +70,46 @@ void eeprom_driver_format(bool erase) {
 }
 
 void eeprom_driver_erase(void) {
+    write_combine.length = 0;
     wear_leveling_erase();
 }
 
+void eeprom_driver_flush(void) {
+    if (write_combine.length > 0) {
+        wear_leveling_write(write_combine.address, write_combine.data, write_combine.length);
+        write_combine.length = 0;
+    }
+}
+
+void eeprom_driver_task(void) {
+    if (write_combine.length > 0 && timer_elapsed(write_combine.last_write) >= (EEPROM_WRITE_COMBINE_TIMEOUT)) {
+        eeprom_driver_flush();
+    }
+}
+
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
-    wear_leveling_read((uint32_t)addr, buf, len);
+    uint32_t address = (uint32_t)(uintptr_t)addr;
+    wear_leveling_read(address, buf, len);
+
+    // Overlay anything still waiting to be written
+    uint32_t start = MAX(address, write_combine.address);
+    uint32_t end   = MIN(address + len, write_combine.address + write_combine.length);
+    if (start < end) {
+        memcpy((uint8_t *)buf + (start - address), &write_combine.data[start - write_combine.address], end - start);
+    }
 }
 
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
-    wear_leveling_write((uint32_t)addr, buf, len);
+    uint32_t address = (uint32_t)(uintptr_t)addr;
+    if (!eeprom_write_combine(address, buf, len)) {
+        eeprom_driver_flush();
+        if (len > (EEPROM_WRITE_COMBINE_SIZE)) {
+            wear_leveling_write(address, buf, len);
+            return;
+        }
+        write_combine.address = address;
+        write_combine.length  = len;
+        memcpy(write_combine.data, buf, len);
+    }
+    write_combine.last_write = timer_read();
 }
@@ -0,0 +1,17 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    The time in milliseconds writes are held back for, in case adjacent writes follow.
+*/
+#ifndef EEPROM_WRITE_COMBINE_TIMEOUT
+#    define EEPROM_WRITE_COMBINE_TIMEOUT 50
+#endif // EEPROM_WRITE_COMBINE_TIMEOUT
+
+/*
+    The most bytes combined into a single write, by default what fits in one wear-leveling log entry.
+*/
+#ifndef EEPROM_WRITE_COMBINE_SIZE
+#    define EEPROM_WRITE_COMBINE_SIZE 5
+#endif // EEPROM_WRITE_COMBINE_SIZE
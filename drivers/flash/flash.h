@@ -71,6 +71,28 @@ flash_status_t flash_wait_erase_chip(void);
  */
 flash_status_t flash_erase_chip(void);
 
+/**
+ * @brief Initiates a block erase operation.
+ *
+ * This function does not wait for the flash to become ready, completion can be polled with flash_is_busy().
+ *
+ * @param addr The address of the block to erase.
+ *
+ * @return FLASH_STATUS_SUCCESS if the erase command was successfully sent, FLASH_STATUS_TIMEOUT if the flash is busy, or FLASH_STATUS_ERROR if an error occurred.
+ */
+flash_status_t flash_begin_erase_block(uint32_t addr);
+
+/**
+ * @brief Initiates a sector erase operation.
+ *
+ * This function does not wait for the flash to become ready, completion can be polled with flash_is_busy().
+ *
+ * @param addr The address of the sector to erase.
+ *
+ * @return FLASH_STATUS_SUCCESS if the erase command was successfully sent, FLASH_STATUS_TIMEOUT if the flash is busy, or FLASH_STATUS_ERROR if an error occurred.
+ */
+flash_status_t flash_begin_erase_sector(uint32_t addr);
+
 /**
  * @brief Erases a block of flash memory.
  *
@@ -209,33 +209,46 @@ flash_status_t flash_erase_chip(void) {
     return flash_wait_erase_chip();
 }
 
-flash_status_t flash_erase_sector(uint32_t addr) {
+static flash_status_t spi_flash_begin_erase(uint8_t cmd, uint32_t addr) {
     flash_status_t response = FLASH_STATUS_SUCCESS;
 
-    /* Check that the address exceeds the limit. */
-    if ((addr + (EXTERNAL_FLASH_SECTOR_SIZE)) >= (EXTERNAL_FLASH_SIZE) || ((addr % (EXTERNAL_FLASH_SECTOR_SIZE)) != 0)) {
-        dprintf("Flash erase sector address over limit! [addr:0x%lx]\n", (uint32_t)addr);
-        return FLASH_STATUS_ERROR;
-    }
-
     /* Wait for the write-in-progress bit to be cleared. */
     response = spi_flash_wait_while_busy();
     if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to check WIP flag! [spi flash erase sector]\n");
+        dprint("Failed to check WIP flag! [spi flash erase]\n");
         return response;
     }
 
     /* Enable writes. */
     response = spi_flash_write_enable();
     if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to write-enable! [spi flash erase sector]\n");
+        dprint("Failed to write-enable! [spi flash erase]\n");
         return response;
     }
 
-    /* Erase Sector. */
-    response = spi_flash_transaction(FLASH_CMD_SE, addr, NULL, 0);
+    /* Erase Sector/Block. */
+    response = spi_flash_transaction(cmd, addr, NULL, 0);
+    if (response != FLASH_STATUS_SUCCESS) {
+        dprint("Failed to erase! [spi flash erase]\n");
+    }
+
+    return response;
+}
+
+flash_status_t flash_begin_erase_sector(uint32_t addr) {
+    /* Check that the address exceeds the limit. */
+    if ((addr + (EXTERNAL_FLASH_SECTOR_SIZE)) >= (EXTERNAL_FLASH_SIZE) || ((addr % (EXTERNAL_FLASH_SECTOR_SIZE)) != 0)) {
+        dprintf("Flash erase sector address over limit! [addr:0x%lx]\n", (uint32_t)addr);
+        return FLASH_STATUS_ERROR;
+    }
+
+    return spi_flash_begin_erase(FLASH_CMD_SE, addr);
+}
+
+flash_status_t flash_erase_sector(uint32_t addr) {
+    flash_status_t response = flash_begin_erase_sector(addr);
     if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to erase sector! [spi flash erase sector]\n");
+        dprint("Failed to begin erase sector! [spi flash erase sector]\n");
         return response;
     }
 
@@ -249,33 +262,20 @@ flash_status_t flash_erase_sector(uint32_t addr) {
     return response;
 }
 
-flash_status_t flash_erase_block(uint32_t addr) {
-    flash_status_t response = FLASH_STATUS_SUCCESS;
-
+flash_status_t flash_begin_erase_block(uint32_t addr) {
     /* Check that the address exceeds the limit. */
     if ((addr + (EXTERNAL_FLASH_BLOCK_SIZE)) >= (EXTERNAL_FLASH_SIZE) || ((addr % (EXTERNAL_FLASH_BLOCK_SIZE)) != 0)) {
         dprintf("Flash erase block address over limit! [addr:0x%lx]\n", (uint32_t)addr);
         return FLASH_STATUS_ERROR;
     }
 
-    /* Wait for the write-in-progress bit to be cleared. */
-    response = spi_flash_wait_while_busy();
-    if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to check WIP flag! [spi flash erase block]\n");
-        return response;
-    }
-
-    /* Enable writes. */
-    response = spi_flash_write_enable();
-    if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to write-enable! [spi flash erase block]\n");
-        return response;
-    }
+    return spi_flash_begin_erase(FLASH_CMD_BE, addr);
+}
 
-    /* Erase Block. */
-    response = spi_flash_transaction(FLASH_CMD_BE, addr, NULL, 0);
+flash_status_t flash_erase_block(uint32_t addr) {
+    flash_status_t response = flash_begin_erase_block(addr);
     if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to erase block! [spi flash erase block]\n");
+        dprint("Failed to begin erase block! [spi flash erase block]\n");
         return response;
     }
 
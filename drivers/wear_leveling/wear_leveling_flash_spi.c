@@ -41,6 +41,49 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+static uint32_t erase_offset = 0;
+static uint32_t erase_end    = 0;
+
+bool backing_store_begin_erase_range(uint32_t address, uint32_t length) {
+    erase_offset = (WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_OFFSET) * (EXTERNAL_FLASH_BLOCK_SIZE) + address;
+    erase_end    = erase_offset + length;
+    return flash_begin_erase_sector(erase_offset) == FLASH_STATUS_SUCCESS;
+}
+
+backing_store_erase_status_t backing_store_poll_erase(void) {
+    flash_status_t status = flash_is_busy();
+    if (status == FLASH_STATUS_BUSY) {
+        return BACKING_STORE_ERASE_BUSY;
+    }
+    if (status != FLASH_STATUS_SUCCESS) {
+        return BACKING_STORE_ERASE_FAILED;
+    }
+
+    // Move on to the next sector of the range, if any
+    erase_offset += (EXTERNAL_FLASH_SECTOR_SIZE);
+    if (erase_offset >= erase_end) {
+        return BACKING_STORE_ERASE_DONE;
+    }
+    if (flash_begin_erase_sector(erase_offset) != FLASH_STATUS_SUCCESS) {
+        return BACKING_STORE_ERASE_FAILED;
+    }
+    return BACKING_STORE_ERASE_BUSY;
+}
+
+bool backing_store_erase_range(uint32_t address, uint32_t length) {
+    if (!backing_store_begin_erase_range(address, length)) {
+        return false;
+    }
+
+    backing_store_erase_status_t status;
+    do {
+        status = backing_store_poll_erase();
+    } while (status == BACKING_STORE_ERASE_BUSY);
+    return status == BACKING_STORE_ERASE_DONE;
+}
+#endif // WEAR_LEVELING_DUAL_BANK
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
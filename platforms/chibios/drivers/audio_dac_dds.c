@@ -0,0 +1,198 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "audio.h"
+#include "audio_dds.h"
+#include "gpio.h"
+#include "util.h"
+#include <ch.h>
+#include <hal.h>
+
+/*
+  Audio Driver: DAC DDS
+
+  Polyphonic synthesis with the fixed-point engine in quantum/audio/audio_dds.c.
+  The DMA callback renders the free half of a ping-pong buffer with integer
+  math only and wakes a thread, which advances the audio state and converts
+  the active frequencies to phase increments outside of the interrupt.
+
+  GPT6 runs at three times AUDIO_DAC_SAMPLE_RATE and triggers a conversion
+  every second tick, same as the additive driver.
+*/
+
+#if !defined(AUDIO_PIN)
+#    error "Audio feature enabled, but no suitable pin selected as AUDIO_PIN - see docs/feature_audio under 'ARM (DAC DDS)' for available options."
+#endif
+#if defined(AUDIO_PIN_ALT) && !defined(AUDIO_PIN_ALT_AS_NEGATIVE)
+#    pragma message "Audio feature: AUDIO_PIN_ALT set, but not AUDIO_PIN_ALT_AS_NEGATIVE - pin will be left unused; audio might still work though."
+#endif
+
+#if !defined(AUDIO_PIN_ALT)
+// no ALT pin defined is valid, but the c-ifs below need some value set
+#    define AUDIO_PIN_ALT PAL_NOLINE
+#endif
+
+#define DAC_DDS_AMPLITUDE MIN(AUDIO_DAC_OFF_VALUE, AUDIO_DAC_SAMPLE_MAX - AUDIO_DAC_OFF_VALUE)
+
+static dacsample_t dac_buffer[AUDIO_DAC_BUFFER_SIZE];
+
+static binary_semaphore_t dds_update_sem;
+static bool               dds_stopping      = false;
+static uint8_t            dds_silent_halves = 0;
+
+/**
+ * DAC streaming callback, called for the half and the full buffer event.
+ * Renders the half that has just been played while DMA works on the other.
+ */
+static void dac_end(DACDriver *dacp) {
+    dacsample_t *sample_p = (dacp)->samples;
+
+    if (dacIsBufferComplete(dacp)) {
+        sample_p += AUDIO_DAC_BUFFER_SIZE / 2;
+    }
+
+    // a half only counts as silent if no voice was left when it started, a release may end midway
+    bool silent = !audio_dds_is_active();
+
+    // render in place, dacsample_t and int16_t share their size
+    int16_t *pcm = (int16_t *)sample_p;
+    audio_dds_render(pcm, AUDIO_DAC_BUFFER_SIZE / 2);
+    for (uint16_t s = 0; s < AUDIO_DAC_BUFFER_SIZE / 2; s++) {
+        sample_p[s] = AUDIO_DAC_OFF_VALUE + ((int32_t)pcm[s] * (int32_t)DAC_DDS_AMPLITUDE) / 32768;
+    }
+
+    chSysLockFromISR();
+    if (dds_stopping && silent) {
+        // both halves hold AUDIO_DAC_OFF_VALUE once they have been rendered silent
+        if (++dds_silent_halves >= 2) {
+            gptStopTimerI(&GPTD6);
+        }
+    } else {
+        dds_silent_halves = 0;
+    }
+    chBSemSignalI(&dds_update_sem);
+    chSysUnlockFromISR();
+}
+
+static void dac_error(DACDriver *dacp, dacerror_t err) {
+    (void)dacp;
+    (void)err;
+
+    chSysHalt("DAC failure. halp");
+}
+
+/**
+ * Copies the tones of the audio core onto the voices, converting their
+ * frequencies to phase increments. Tones are told apart by their unprocessed
+ * frequency, so each keeps its voice while others start and stop.
+ */
+static void dds_update_voices(void) {
+    uint32_t keys[AUDIO_DDS_VOICES];
+    uint32_t increments[AUDIO_DDS_VOICES];
+    uint8_t  active_tones = MIN(AUDIO_DDS_VOICES, audio_get_number_of_active_tones());
+
+    for (uint8_t i = 0; i < active_tones; i++) {
+        keys[i]       = audio_dds_increment(audio_get_frequency(i));
+        increments[i] = audio_dds_increment(audio_get_processed_frequency(i));
+    }
+
+    chSysLock();
+    audio_dds_set_tones(keys, increments, active_tones);
+    chSysUnlock();
+}
+
+static THD_WORKING_AREA(waDdsThread, 256);
+static THD_FUNCTION(DdsThread, arg) {
+    (void)arg;
+    chRegSetThreadName("audio_dds");
+
+    while (true) {
+        chBSemWait(&dds_update_sem);
+        if (!dds_stopping && audio_update_state()) {
+            dds_update_voices();
+        }
+    }
+}
+
+static const GPTConfig gpt6cfg1 = {.frequency = AUDIO_DAC_SAMPLE_RATE * 3,
+                                   .callback  = NULL,
+                                   .cr2       = TIM_CR2_MMS_1, /* MMS = 010 = TRGO on Update Event.  */
+                                   .dier      = 0U};
+
+static const DACConfig dac_conf = {.init = AUDIO_DAC_OFF_VALUE, .datamode = DAC_DHRM_12BIT_RIGHT};
+
+/**
+ * @note The DAC_TRG(0) here selects the Timer 6 TRGO event, see the additive
+ * driver for the other timers available.
+ */
+static const DACConversionGroup dac_conv_cfg = {.num_channels = 1U, .end_cb = dac_end, .error_cb = dac_error, .trigger = DAC_TRG(0b000)};
+
+void audio_driver_initialize_impl(void) {
+    if ((AUDIO_PIN == A4) || (AUDIO_PIN_ALT == A4)) {
+        palSetLineMode(A4, PAL_MODE_INPUT_ANALOG);
+        dacStart(&DACD1, &dac_conf);
+    }
+    if ((AUDIO_PIN == A5) || (AUDIO_PIN_ALT == A5)) {
+        palSetLineMode(A5, PAL_MODE_INPUT_ANALOG);
+        dacStart(&DACD2, &dac_conf);
+    }
+
+    // enable the output buffer, see the additive driver
+    DACD1.params->dac->CR &= ~DAC_CR_BOFF1;
+    DACD2.params->dac->CR &= ~DAC_CR_BOFF2;
+
+    for (size_t i = 0; i < AUDIO_DAC_BUFFER_SIZE; i++) {
+        dac_buffer[i] = AUDIO_DAC_OFF_VALUE;
+    }
+
+    audio_dds_init();
+    chBSemObjectInit(&dds_update_sem, true);
+    chThdCreateStatic(waDdsThread, sizeof(waDdsThread), NORMALPRIO + 1, DdsThread, NULL);
+
+    if (AUDIO_PIN == A4) {
+        dacStartConversion(&DACD1, &dac_conv_cfg, dac_buffer, AUDIO_DAC_BUFFER_SIZE);
+    } else if (AUDIO_PIN == A5) {
+        dacStartConversion(&DACD2, &dac_conv_cfg, dac_buffer, AUDIO_DAC_BUFFER_SIZE);
+    }
+
+#if defined(AUDIO_PIN_ALT_AS_NEGATIVE)
+    if (AUDIO_PIN_ALT == A4) {
+        dacPutChannelX(&DACD1, 0, AUDIO_DAC_OFF_VALUE);
+    } else if (AUDIO_PIN_ALT == A5) {
+        dacPutChannelX(&DACD2, 0, AUDIO_DAC_OFF_VALUE);
+    }
+#endif
+
+    gptStart(&GPTD6, &gpt6cfg1);
+}
+
+void audio_driver_stop_impl(void) {
+    // let the voices fade out through their release, the callback stops the timer once silent
+    chSysLock();
+    dds_stopping = true;
+    audio_dds_stop_all();
+    chSysUnlock();
+}
+
+void audio_driver_start_impl(void) {
+    chSysLock();
+    dds_stopping      = false;
+    dds_silent_halves = 0;
+    chSysUnlock();
+
+    dds_update_voices();
+    gptStartContinuous(&GPTD6, 2U);
+}
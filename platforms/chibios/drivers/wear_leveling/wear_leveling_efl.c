@@ -100,6 +100,28 @@ bool backing_store_init(void) {
 
 #endif // defined(WEAR_LEVELING_EFL_FIRST_SECTOR)
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+    // Each bank needs to be erased without touching the other, one BACKING_STORE_ERASE_SIZE sector at a time
+    bool bank_boundary = false;
+    for (flash_sector_t i = 0; i < sector_count; ++i) {
+        flash_offset_t offset = flashGetSectorOffset(flash, first_sector + i) - base_offset;
+        if (offset >= (WEAR_LEVELING_BACKING_SIZE)) {
+            break;
+        }
+        if (flashGetSectorSize(flash, first_sector + i) != (BACKING_STORE_ERASE_SIZE)) {
+            bs_dprintf("Sector %d is not BACKING_STORE_ERASE_SIZE bytes\n", (int)(first_sector + i));
+            return false;
+        }
+        if (offset == (WEAR_LEVELING_BANK_SIZE)) {
+            bank_boundary = true;
+        }
+    }
+    if (!bank_boundary) {
+        bs_dprintf("Bank boundary is not on a sector boundary\n");
+        return false;
+    }
+#endif // WEAR_LEVELING_DUAL_BANK
+
     return true;
 }
 
@@ -133,6 +155,61 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+static flash_sector_t erase_sector = 0;
+static uint32_t       erase_begin  = 0;
+static uint32_t       erase_end    = 0;
+
+// Kicks off the erase of the next sector starting within the requested range -- banks need to be aligned with sector boundaries
+static backing_store_erase_status_t backing_store_erase_next_sector(void) {
+    for (; erase_sector < sector_count; ++erase_sector) {
+        flash_offset_t offset = flashGetSectorOffset(flash, first_sector + erase_sector) - base_offset;
+        if (offset < erase_begin || offset >= erase_end) {
+            continue;
+        }
+
+        flash_error_t status = flashStartEraseSector(flash, first_sector + erase_sector++);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            return BACKING_STORE_ERASE_FAILED;
+        }
+        return BACKING_STORE_ERASE_BUSY;
+    }
+    return BACKING_STORE_ERASE_DONE;
+}
+
+bool backing_store_begin_erase_range(uint32_t address, uint32_t length) {
+    erase_sector = 0;
+    erase_begin  = address;
+    erase_end    = address + length;
+    // Nothing to erase means the range does not start on a sector boundary
+    return backing_store_erase_next_sector() == BACKING_STORE_ERASE_BUSY;
+}
+
+backing_store_erase_status_t backing_store_poll_erase(void) {
+    uint32_t      msec;
+    flash_error_t status = flashQueryErase(flash, &msec);
+    if (status == FLASH_BUSY_ERASING) {
+        return BACKING_STORE_ERASE_BUSY;
+    }
+    if (status != FLASH_NO_ERROR) {
+        return BACKING_STORE_ERASE_FAILED;
+    }
+    return backing_store_erase_next_sector();
+}
+
+bool backing_store_erase_range(uint32_t address, uint32_t length) {
+    if (!backing_store_begin_erase_range(address, length)) {
+        return false;
+    }
+
+    backing_store_erase_status_t status;
+    do {
+        status = backing_store_poll_erase();
+    } while (status == BACKING_STORE_ERASE_BUSY);
+    return status == BACKING_STORE_ERASE_DONE;
+}
+#endif // WEAR_LEVELING_DUAL_BANK
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = (base_offset + address);
     bs_dprintf("Write ");
@@ -45,6 +45,26 @@
 #    endif
 #endif
 
+// Work out how many bytes are erased at a time, so that dual-bank mode erases one sector per step instead of a whole bank
+#ifndef BACKING_STORE_ERASE_SIZE
+// These need to match the sector size used by EFL, see associated code in `lib/chibios/os/hal/ports/**/hal_efl_lld.c`,
+// or associated `stm32_registry.h` for the MCU in question (or equivalent for the family).
+#    if defined(QMK_MCU_SERIES_GD32VF103)
+#        define BACKING_STORE_ERASE_SIZE 1024 // from hal_efl_lld.c
+#    elif defined(QMK_MCU_FAMILY_NUC123)
+#        define BACKING_STORE_ERASE_SIZE 512 // from hal_efl_lld.c
+#    elif defined(QMK_MCU_FAMILY_WB32)
+#        define BACKING_STORE_ERASE_SIZE 256 // from hal_efl_lld.c
+#    elif defined(QMK_MCU_FAMILY_STM32) && defined(STM32_FLASH_SECTOR_SIZE) // from some family's stm32_registry.h file
+#        define BACKING_STORE_ERASE_SIZE (STM32_FLASH_SECTOR_SIZE)
+#    endif
+#endif // BACKING_STORE_ERASE_SIZE
+
+// Sectors of differing sizes usually leave both banks within one sector, so erasing either of them would lose the other
+#if defined(WEAR_LEVELING_DUAL_BANK) && !defined(BACKING_STORE_ERASE_SIZE)
+#    error "WEAR_LEVELING_DUAL_BANK needs flash sectors of a fixed size, define BACKING_STORE_ERASE_SIZE if the sectors used by wear-leveling are all the same size"
+#endif
+
 // 2kB backing space allocated
 #ifndef WEAR_LEVELING_BACKING_SIZE
 #    define WEAR_LEVELING_BACKING_SIZE 2048
@@ -52,5 +72,9 @@
 
 // 1kB logical EEPROM
 #ifndef WEAR_LEVELING_LOGICAL_SIZE
-#    define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    ifdef WEAR_LEVELING_DUAL_BANK
+#        define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 4)
+#    else
+#        define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    endif
 #endif // WEAR_LEVELING_LOGICAL_SIZE
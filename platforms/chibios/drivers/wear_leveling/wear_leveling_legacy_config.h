@@ -47,6 +47,11 @@
 #    endif
 #endif
 
+// Erase a page at a time when dual-bank mode is enabled
+#ifndef BACKING_STORE_ERASE_SIZE
+#    define BACKING_STORE_ERASE_SIZE (WEAR_LEVELING_LEGACY_EMULATION_PAGE_SIZE)
+#endif // BACKING_STORE_ERASE_SIZE
+
 // 2-byte writes
 #ifndef BACKING_STORE_WRITE_SIZE
 #    define BACKING_STORE_WRITE_SIZE 2
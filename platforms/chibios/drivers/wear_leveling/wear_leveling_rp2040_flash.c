@@ -159,6 +159,19 @@ static void __no_inline_not_in_flash_func(pico_program_bulk)(uint32_t flash_addr
 
 static int interrupts;
 
+// Ensure the backing size can be cleanly subtracted from the flash size without alignment issues.
+_Static_assert((WEAR_LEVELING_BACKING_SIZE) % (FLASH_SECTOR_SIZE) == 0, "Backing size must be a multiple of FLASH_SECTOR_SIZE");
+#ifdef WEAR_LEVELING_DUAL_BANK
+// flash_range_erase() only takes whole sectors, anything else trips its parameter checks.
+_Static_assert((BACKING_STORE_ERASE_SIZE) % (FLASH_SECTOR_SIZE) == 0, "Erase size must be a multiple of FLASH_SECTOR_SIZE");
+#endif // WEAR_LEVELING_DUAL_BANK
+
+static void pico_erase_range(uint32_t offset, uint32_t length) {
+    interrupts = save_and_disable_interrupts();
+    flash_range_erase(offset, length);
+    restore_interrupts(interrupts);
+}
+
 bool backing_store_init(void) {
     bs_dprintf("Init\n");
     memcpy(BOOT2_ROM_RAM, BOOT2_ROM, sizeof(BOOT2_ROM));
@@ -176,17 +189,19 @@ bool backing_store_erase(void) {
     uint32_t start = timer_read32();
 #endif
 
-    // Ensure the backing size can be cleanly subtracted from the flash size without alignment issues.
-    _Static_assert((WEAR_LEVELING_BACKING_SIZE) % (FLASH_SECTOR_SIZE) == 0, "Backing size must be a multiple of FLASH_SECTOR_SIZE");
-
-    interrupts = save_and_disable_interrupts();
-    flash_range_erase((WEAR_LEVELING_RP2040_FLASH_BASE), (WEAR_LEVELING_BACKING_SIZE));
-    restore_interrupts(interrupts);
+    pico_erase_range((WEAR_LEVELING_RP2040_FLASH_BASE), (WEAR_LEVELING_BACKING_SIZE));
 
     bs_dprintf("Backing store erase took %ldms to complete\n", ((long)(timer_read32() - start)));
     return true;
 }
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+bool backing_store_erase_range(uint32_t address, uint32_t length) {
+    pico_erase_range((WEAR_LEVELING_RP2040_FLASH_BASE) + address, length);
+    return true;
+}
+#endif // WEAR_LEVELING_DUAL_BANK
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
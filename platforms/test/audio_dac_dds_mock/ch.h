@@ -0,0 +1,41 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+// Stand-in for the parts of ChibiOS used by audio_dac_dds.c, see audio_dac_dds_tests.cpp
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    bool signaled;
+} binary_semaphore_t;
+
+typedef void (*tfunc_t)(void *arg);
+typedef struct {
+    tfunc_t function;
+} thread_t;
+
+#define NORMALPRIO 128
+#define THD_WORKING_AREA(name, size) uint8_t name[size]
+#define THD_FUNCTION(name, arg) void name(void *arg)
+
+void      chSysLock(void);
+void      chSysUnlock(void);
+void      chSysLockFromISR(void);
+void      chSysUnlockFromISR(void);
+void      chSysHalt(const char *reason);
+void      chRegSetThreadName(const char *name);
+thread_t *chThdCreateStatic(void *wsp, size_t size, int prio, tfunc_t pf, void *arg);
+void      chBSemObjectInit(binary_semaphore_t *bsp, bool taken);
+void      chBSemWait(binary_semaphore_t *bsp);
+void      chBSemSignalI(binary_semaphore_t *bsp);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,106 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+// Stand-in for the DAC, GPT and PAL drivers used by audio_dac_dds.c, see audio_dac_dds_tests.cpp
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t ioline_t;
+#define GPIOA 0U
+#define PAL_LINE(port, pad) ((ioline_t)((port) << 16 | (pad)))
+#define PAL_NOLINE 0xFFFFFFFFU
+#define PAL_MODE_INPUT_ANALOG 3U
+void palSetLineMode(ioline_t line, uint32_t mode);
+
+typedef uint16_t dacsample_t;
+typedef uint32_t dacerror_t;
+
+typedef enum {
+    DAC_UNINIT,
+    DAC_STOP,
+    DAC_READY,
+    DAC_ACTIVE,
+    DAC_COMPLETE,
+    DAC_ERROR,
+} dacstate_t;
+
+typedef struct DACDriver DACDriver;
+typedef void (*daccallback_t)(DACDriver *dacp);
+typedef void (*dacerrorcallback_t)(DACDriver *dacp, dacerror_t err);
+
+typedef struct {
+    uint32_t           num_channels;
+    daccallback_t      end_cb;
+    dacerrorcallback_t error_cb;
+    uint32_t           trigger;
+} DACConversionGroup;
+
+typedef struct {
+    dacsample_t init;
+    uint32_t    datamode;
+} DACConfig;
+
+typedef struct {
+    volatile uint32_t CR;
+} DAC_TypeDef;
+
+typedef struct {
+    DAC_TypeDef *dac;
+} dacparams_t;
+
+struct DACDriver {
+    dacstate_t                state;
+    const DACConfig *         config;
+    const DACConversionGroup *grpp;
+    dacsample_t *             samples;
+    size_t                    depth;
+    const dacparams_t *       params;
+};
+
+#define DAC_DHRM_12BIT_RIGHT 0U
+#define DAC_TRG(n) ((n) << 3)
+#define DAC_CR_BOFF1 (1U << 1)
+#define DAC_CR_BOFF2 (1U << 17)
+#define dacIsBufferComplete(dacp) ((bool)((dacp)->state == DAC_COMPLETE))
+
+extern DACDriver DACD1;
+extern DACDriver DACD2;
+
+void dacStart(DACDriver *dacp, const DACConfig *config);
+void dacStartConversion(DACDriver *dacp, const DACConversionGroup *grpp, dacsample_t *samples, size_t depth);
+void dacPutChannelX(DACDriver *dacp, uint32_t channel, dacsample_t sample);
+
+typedef struct GPTDriver GPTDriver;
+typedef void (*gptcallback_t)(GPTDriver *gptp);
+
+typedef struct {
+    uint32_t      frequency;
+    gptcallback_t callback;
+    uint32_t      cr2;
+    uint32_t      dier;
+} GPTConfig;
+
+struct GPTDriver {
+    const GPTConfig *config;
+    bool             running;
+    uint32_t         interval;
+};
+
+#define TIM_CR2_MMS_1 (1U << 5)
+
+extern GPTDriver GPTD6;
+
+void gptStart(GPTDriver *gptp, const GPTConfig *config);
+void gptStartContinuous(GPTDriver *gptp, uint32_t interval);
+void gptStopTimerI(GPTDriver *gptp);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,269 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <algorithm>
+#include <csetjmp>
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include <ch.h>
+#include <hal.h>
+#include "audio_dac.h"
+#include "audio_dds.h"
+
+void audio_driver_initialize_impl(void);
+void audio_driver_start_impl(void);
+void audio_driver_stop_impl(void);
+}
+
+namespace {
+
+/* The audio core, as seen by the driver */
+struct AudioCore {
+    std::vector<float> frequencies;
+    bool               state_changed = false;
+    int                updates       = 0;
+};
+
+AudioCore core;
+
+/* The driver's thread, run until it blocks */
+tfunc_t      thread_function = nullptr;
+std::jmp_buf thread_blocked;
+bool         in_thread  = false;
+int          lock_depth = 0;
+
+} // namespace
+
+extern "C" {
+
+DACDriver DACD1;
+DACDriver DACD2;
+GPTDriver GPTD6;
+
+static DAC_TypeDef       dac_registers;
+static const dacparams_t dac_params = {&dac_registers};
+
+bool audio_update_state(void) {
+    core.updates++;
+    bool changed       = core.state_changed;
+    core.state_changed = false;
+    return changed;
+}
+
+uint8_t audio_get_number_of_active_tones(void) {
+    return core.frequencies.size();
+}
+
+float audio_get_frequency(uint8_t tone_index) {
+    return core.frequencies[tone_index];
+}
+
+float audio_get_processed_frequency(uint8_t tone_index) {
+    return core.frequencies[tone_index];
+}
+
+void chSysLock(void) {
+    lock_depth++;
+}
+
+void chSysUnlock(void) {
+    lock_depth--;
+}
+
+void chSysLockFromISR(void) {
+    lock_depth++;
+}
+
+void chSysUnlockFromISR(void) {
+    lock_depth--;
+}
+
+void chSysHalt(const char *reason) {
+    ADD_FAILURE() << "chSysHalt: " << reason;
+}
+
+void chRegSetThreadName(const char *) {}
+
+thread_t *chThdCreateStatic(void *, size_t, int, tfunc_t pf, void *) {
+    static thread_t thread;
+    thread_function = pf;
+    thread.function = pf;
+    return &thread;
+}
+
+void chBSemObjectInit(binary_semaphore_t *bsp, bool taken) {
+    bsp->signaled = !taken;
+}
+
+void chBSemWait(binary_semaphore_t *bsp) {
+    EXPECT_TRUE(in_thread);
+    EXPECT_EQ(lock_depth, 0);
+    if (!bsp->signaled) {
+        std::longjmp(thread_blocked, 1);
+    }
+    bsp->signaled = false;
+}
+
+void chBSemSignalI(binary_semaphore_t *bsp) {
+    EXPECT_GT(lock_depth, 0);
+    bsp->signaled = true;
+}
+
+void palSetLineMode(ioline_t, uint32_t) {}
+
+void dacStart(DACDriver *dacp, const DACConfig *config) {
+    dacp->state  = DAC_READY;
+    dacp->config = config;
+}
+
+void dacStartConversion(DACDriver *dacp, const DACConversionGroup *grpp, dacsample_t *samples, size_t depth) {
+    dacp->state   = DAC_ACTIVE;
+    dacp->grpp    = grpp;
+    dacp->samples = samples;
+    dacp->depth   = depth;
+}
+
+void dacPutChannelX(DACDriver *, uint32_t, dacsample_t) {}
+
+void gptStart(GPTDriver *gptp, const GPTConfig *config) {
+    gptp->config = config;
+}
+
+void gptStartContinuous(GPTDriver *gptp, uint32_t interval) {
+    gptp->running  = true;
+    gptp->interval = interval;
+}
+
+void gptStopTimerI(GPTDriver *gptp) {
+    EXPECT_GT(lock_depth, 0);
+    gptp->running = false;
+}
+
+} // extern "C"
+
+using samples_t = std::vector<dacsample_t>;
+
+class AudioDacDds : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        core            = AudioCore();
+        thread_function = nullptr;
+        lock_depth      = 0;
+        DACD1           = DACDriver();
+        DACD2           = DACDriver();
+        // set up by halInit() on the real thing, whether or not the channel is started
+        DACD1.params = &dac_params;
+        DACD2.params = &dac_params;
+        GPTD6           = GPTDriver();
+        second_half     = false;
+        audio_driver_initialize_impl();
+        run_thread();
+    }
+
+    /* Runs the driver thread until it waits for the next DMA callback */
+    static void run_thread() {
+        ASSERT_NE(thread_function, nullptr);
+        in_thread = true;
+        if (setjmp(thread_blocked) == 0) {
+            thread_function(nullptr);
+        }
+        in_thread = false;
+    }
+
+    /* Has DMA finish one half of the buffer, followed by the thread, returning the half which was rendered */
+    samples_t dma_half() {
+        EXPECT_TRUE(GPTD6.running);
+        DACD2.state = second_half ? DAC_COMPLETE : DAC_ACTIVE;
+        DACD2.grpp->end_cb(&DACD2);
+        EXPECT_EQ(lock_depth, 0);
+        run_thread();
+
+        dacsample_t *begin = DACD2.samples + (second_half ? AUDIO_DAC_BUFFER_SIZE / 2 : 0);
+        second_half        = !second_half;
+        return samples_t(begin, begin + AUDIO_DAC_BUFFER_SIZE / 2);
+    }
+
+    bool second_half;
+
+    static bool is_silent(const samples_t &samples) {
+        return std::all_of(samples.begin(), samples.end(), [](dacsample_t s) { return s == AUDIO_DAC_OFF_VALUE; });
+    }
+};
+
+TEST_F(AudioDacDds, InitStreamsSilenceFromTheAudioPin) {
+    EXPECT_EQ(DACD2.state, DAC_ACTIVE);
+    EXPECT_EQ(DACD2.depth, AUDIO_DAC_BUFFER_SIZE);
+    EXPECT_EQ(DACD2.grpp->num_channels, 1U);
+    EXPECT_TRUE(is_silent(samples_t(DACD2.samples, DACD2.samples + AUDIO_DAC_BUFFER_SIZE)));
+    EXPECT_EQ(DACD1.state, DAC_UNINIT);
+    EXPECT_EQ(GPTD6.config->frequency, AUDIO_DAC_SAMPLE_RATE * 3);
+    EXPECT_FALSE(GPTD6.running);
+
+    audio_driver_start_impl();
+    EXPECT_TRUE(GPTD6.running);
+    EXPECT_EQ(GPTD6.interval, 2U);
+    EXPECT_TRUE(is_silent(dma_half()));
+    EXPECT_TRUE(is_silent(dma_half()));
+}
+
+TEST_F(AudioDacDds, EachCallbackRendersTheHalfJustPlayed) {
+    core.frequencies = {440.0f};
+    audio_driver_start_impl();
+
+    samples_t buffer_before(DACD2.samples, DACD2.samples + AUDIO_DAC_BUFFER_SIZE);
+    samples_t first = dma_half();
+    EXPECT_FALSE(is_silent(first));
+    // the second half, which DMA is playing, is left alone
+    EXPECT_TRUE(std::equal(buffer_before.begin() + AUDIO_DAC_BUFFER_SIZE / 2, buffer_before.end(), DACD2.samples + AUDIO_DAC_BUFFER_SIZE / 2));
+
+    samples_t second = dma_half();
+    EXPECT_FALSE(is_silent(second));
+    EXPECT_TRUE(std::equal(first.begin(), first.end(), DACD2.samples));
+
+    for (int i = 0; i < 100; i++) {
+        for (dacsample_t s : dma_half()) {
+            ASSERT_LE(s, AUDIO_DAC_SAMPLE_MAX);
+        }
+    }
+}
+
+TEST_F(AudioDacDds, ThreadPicksUpNewTones) {
+    audio_driver_start_impl();
+    EXPECT_TRUE(is_silent(dma_half()));
+
+    // the thread advances the audio state once per callback
+    int updates = core.updates;
+    dma_half();
+    EXPECT_EQ(core.updates, updates + 1);
+
+    core.frequencies   = {880.0f};
+    core.state_changed = true;
+    dma_half();
+    EXPECT_FALSE(is_silent(dma_half()));
+}
+
+TEST_F(AudioDacDds, StopFadesOutAndStopsTheTimer) {
+    core.frequencies = {440.0f};
+    audio_driver_start_impl();
+    for (int i = 0; i < 10; i++) {
+        dma_half();
+    }
+
+    audio_driver_stop_impl();
+    int updates = core.updates;
+    int halves  = 0;
+    while (GPTD6.running) {
+        ASSERT_LT(++halves, 1000) << "timer never stopped";
+        dma_half();
+    }
+    // no new tones are picked up while stopping
+    EXPECT_EQ(core.updates, updates);
+    // the release ran its course, and both halves were left silent
+    EXPECT_GT(halves, 2);
+    EXPECT_TRUE(is_silent(samples_t(DACD2.samples, DACD2.samples + AUDIO_DAC_BUFFER_SIZE)));
+
+    // starting again plays the current tones
+    audio_driver_start_impl();
+    EXPECT_FALSE(is_silent(dma_half()));
+}
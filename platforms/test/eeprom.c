@@ -18,6 +18,9 @@
 
 static uint8_t buffer[TOTAL_EEPROM_BYTE_COUNT];
 
+// Number of bytes written, for tests to check how often the EEPROM is touched
+uint32_t eeprom_write_count = 0;
+
 uint8_t eeprom_read_byte(const uint8_t *addr) {
     uintptr_t offset = (uintptr_t)addr;
     return buffer[offset];
@@ -26,6 +29,7 @@ uint8_t eeprom_read_byte(const uint8_t *addr) {
 void eeprom_write_byte(uint8_t *addr, uint8_t value) {
     uintptr_t offset = (uintptr_t)addr;
     buffer[offset]   = value;
+    eeprom_write_count++;
 }
 
 uint16_t eeprom_read_word(const uint16_t *addr) {
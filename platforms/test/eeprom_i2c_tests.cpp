@@ -0,0 +1,209 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "eeprom.h"
+#include "eeprom_driver.h"
+#include "eeprom_page_cache.h"
+#include "i2c_master.h"
+#include "timer.h"
+void advance_time(uint32_t ms);
+void set_time(uint32_t t);
+}
+
+/* Simulated I2C EEPROM with page write semantics:
+ *  - writes wrap around within a page, as on the real thing
+ *  - each write starts a write cycle of EXTERNAL_EEPROM_WRITE_TIME ms, during which the device doesn't acknowledge
+ *  - each unacknowledged poll takes 1ms of simulated time
+ */
+class SimulatedEeprom {
+   public:
+    std::array<uint8_t, EXTERNAL_EEPROM_BYTE_COUNT> memory;
+    uint32_t                                        pointer;
+    uint32_t                                        busy_until;
+    uint32_t                                        write_cycles;
+    uint32_t                                        transactions;
+    uint32_t                                        nacks;
+
+    void reset() {
+        memory.fill(0xFF);
+        pointer      = 0;
+        busy_until   = 0;
+        write_cycles = 0;
+        transactions = 0;
+        nacks        = 0;
+    }
+
+    bool busy() {
+        if (timer_read32() < busy_until) {
+            ++nacks;
+            advance_time(1);
+            return true;
+        }
+        return false;
+    }
+
+    i2c_status_t transmit(const uint8_t* data, uint16_t length) {
+        ++transactions;
+        if (busy()) {
+            return I2C_STATUS_ERROR;
+        }
+
+        EXPECT_GE(length, EXTERNAL_EEPROM_ADDRESS_SIZE);
+        pointer = 0;
+        for (int i = 0; i < EXTERNAL_EEPROM_ADDRESS_SIZE; ++i) {
+            pointer = (pointer << 8) | data[i];
+        }
+
+        uint16_t count = length - EXTERNAL_EEPROM_ADDRESS_SIZE;
+        if (count > 0) {
+            uint32_t page_base = pointer - (pointer % EXTERNAL_EEPROM_PAGE_SIZE);
+            EXPECT_LE(pointer % EXTERNAL_EEPROM_PAGE_SIZE + count, EXTERNAL_EEPROM_PAGE_SIZE) << "Write wrapped around within the page";
+            for (uint16_t i = 0; i < count; ++i) {
+                memory[page_base + (pointer + i) % EXTERNAL_EEPROM_PAGE_SIZE] = data[EXTERNAL_EEPROM_ADDRESS_SIZE + i];
+            }
+            ++write_cycles;
+            busy_until = timer_read32() + EXTERNAL_EEPROM_WRITE_TIME;
+        }
+        return I2C_STATUS_SUCCESS;
+    }
+
+    i2c_status_t receive(uint8_t* data, uint16_t length) {
+        ++transactions;
+        if (busy()) {
+            return I2C_STATUS_ERROR;
+        }
+        for (uint16_t i = 0; i < length; ++i) {
+            data[i] = memory[pointer];
+            pointer = (pointer + 1) % EXTERNAL_EEPROM_BYTE_COUNT;
+        }
+        return I2C_STATUS_SUCCESS;
+    }
+};
+
+static SimulatedEeprom device;
+
+extern "C" void i2c_init(void) {}
+
+extern "C" i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    EXPECT_EQ(address, EXTERNAL_EEPROM_I2C_BASE_ADDRESS);
+    return device.transmit(data, length);
+}
+
+extern "C" i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    EXPECT_EQ(address, EXTERNAL_EEPROM_I2C_BASE_ADDRESS);
+    return device.receive(data, length);
+}
+
+class EepromI2c : public testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        device.reset();
+        eeprom_driver_init();
+        eeprom_driver_erase();
+        device.write_cycles = device.transactions = device.nacks = 0;
+    }
+
+    void TearDown() override {
+        // Nothing may be left behind in the cache for the next test
+        eeprom_driver_flush();
+    }
+};
+
+TEST_F(EepromI2c, WritesReadBackAcrossPages) {
+    std::array<uint8_t, EXTERNAL_EEPROM_PAGE_SIZE * 3> data;
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = (uint8_t)(i * 7 + 3);
+    }
+    const uintptr_t address = EXTERNAL_EEPROM_PAGE_SIZE / 2 + 1;
+    eeprom_write_block(data.data(), (void*)address, data.size());
+
+    std::array<uint8_t, EXTERNAL_EEPROM_PAGE_SIZE * 3> actual;
+    eeprom_read_block(actual.data(), (const void*)address, actual.size());
+    EXPECT_EQ(actual, data);
+
+    eeprom_driver_flush();
+    EXPECT_EQ(device.write_cycles, 4u) << "Each page should be written in a single burst";
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), device.memory.begin() + address));
+    EXPECT_EQ(device.memory[address - 1], 0);
+    EXPECT_EQ(device.memory[address + data.size()], 0);
+}
+
+TEST_F(EepromI2c, WriteCycleIsAckPolled) {
+    eeprom_update_byte((uint8_t*)10, 0x42);
+    eeprom_driver_flush();
+    EXPECT_EQ(device.write_cycles, 1u);
+    EXPECT_EQ(device.nacks, (uint32_t)EXTERNAL_EEPROM_WRITE_TIME) << "Should poll until the write cycle completes, and no longer";
+    EXPECT_EQ(eeprom_read_byte((const uint8_t*)10), 0x42);
+}
+
+#if EXTERNAL_EEPROM_PAGE_CACHE_COUNT > 0
+TEST_F(EepromI2c, WritesAreHeldBackUntilTimeout) {
+    eeprom_update_word((uint16_t*)20, 0x1234);
+    eeprom_update_byte((uint8_t*)22, 0x56);
+    EXPECT_EQ(device.write_cycles, 0u);
+    EXPECT_EQ(device.memory[20], 0);
+    EXPECT_EQ(eeprom_read_word((const uint16_t*)20), 0x1234);
+    EXPECT_EQ(eeprom_read_byte((const uint8_t*)22), 0x56);
+
+    advance_time(EXTERNAL_EEPROM_PAGE_CACHE_TIMEOUT - 1);
+    eeprom_driver_task();
+    EXPECT_EQ(device.write_cycles, 0u);
+
+    advance_time(1);
+    eeprom_driver_task();
+    EXPECT_EQ(device.write_cycles, 1u);
+    EXPECT_EQ(device.memory[20], 0x34);
+    EXPECT_EQ(device.memory[21], 0x12);
+    EXPECT_EQ(device.memory[22], 0x56);
+}
+
+TEST_F(EepromI2c, LeastRecentlyUsedPageIsEvicted) {
+    for (uintptr_t page = 0; page < EXTERNAL_EEPROM_PAGE_CACHE_COUNT; ++page) {
+        eeprom_update_byte((uint8_t*)(page * EXTERNAL_EEPROM_PAGE_SIZE), 0x10 + page);
+    }
+    // Touch the first page, leaving the second as least recently used
+    eeprom_update_byte((uint8_t*)1, 0x01);
+    EXPECT_EQ(device.write_cycles, 0u);
+
+    eeprom_update_byte((uint8_t*)(EXTERNAL_EEPROM_PAGE_CACHE_COUNT * EXTERNAL_EEPROM_PAGE_SIZE), 0x20);
+    EXPECT_EQ(device.write_cycles, 1u);
+    EXPECT_EQ(device.memory[EXTERNAL_EEPROM_PAGE_SIZE], 0x11);
+    EXPECT_EQ(device.memory[0], 0);
+}
+#endif // EXTERNAL_EEPROM_PAGE_CACHE_COUNT > 0
+
+TEST_F(EepromI2c, KeymapUploadBenchmark) {
+    // Same as dynamic_keymap_set_buffer(), a byte at a time in VIA sized chunks
+    const size_t keymap_size = 1024;
+    const size_t chunk_size  = 28;
+
+    uint32_t start = timer_read32();
+    for (size_t offset = 0; offset < keymap_size; offset += chunk_size) {
+        for (size_t i = offset; i < offset + chunk_size && i < keymap_size; ++i) {
+            eeprom_update_byte((uint8_t*)i, (uint8_t)(i * 13 + 1));
+        }
+        eeprom_driver_task();
+    }
+    eeprom_driver_flush();
+    uint32_t elapsed = timer_read32() - start;
+
+    for (size_t i = 0; i < keymap_size; ++i) {
+        ASSERT_EQ(device.memory[i], (uint8_t)(i * 13 + 1));
+    }
+#if EXTERNAL_EEPROM_PAGE_CACHE_COUNT > 0
+    EXPECT_EQ(device.write_cycles, keymap_size / EXTERNAL_EEPROM_PAGE_SIZE);
+#else
+    // Bytes which were already correct aren't written
+    EXPECT_EQ(device.write_cycles, keymap_size - std::count(device.memory.begin(), device.memory.begin() + keymap_size, 0));
+#endif
+
+    RecordProperty("write_cycles", (int)device.write_cycles);
+    RecordProperty("simulated_ms", (int)elapsed);
+    std::printf("[ BENCHMARK] %zu byte keymap upload: %u write cycles, %u bus transactions, %ums simulated\n", keymap_size, (unsigned)device.write_cycles, (unsigned)device.transactions, (unsigned)elapsed);
+}
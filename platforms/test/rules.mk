@@ -23,3 +23,34 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+
+eeprom_i2c_DEFS := -DEEPROM_DRIVER -DEEPROM_I2C -DEEPROM_I2C_24LC64 -DNO_PRINT
+eeprom_i2c_write_through_DEFS := $(eeprom_i2c_DEFS)
+eeprom_i2c_page_cache_DEFS := $(eeprom_i2c_DEFS) \
+	-DEXTERNAL_EEPROM_PAGE_CACHE_COUNT=2
+
+eeprom_i2c_INC := \
+	$(DRIVER_PATH)/eeprom
+eeprom_i2c_write_through_INC := $(eeprom_i2c_INC)
+eeprom_i2c_page_cache_INC := $(eeprom_i2c_INC)
+
+eeprom_i2c_SRC := \
+	$(DRIVER_PATH)/eeprom/eeprom_driver.c \
+	$(DRIVER_PATH)/eeprom/eeprom_i2c.c \
+	$(DRIVER_PATH)/eeprom/eeprom_page_cache.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/eeprom_i2c_tests.cpp \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+eeprom_i2c_write_through_SRC := $(eeprom_i2c_SRC)
+eeprom_i2c_page_cache_SRC := $(eeprom_i2c_SRC)
+
+audio_dac_dds_DEFS := -DAUDIO_DRIVER_DAC -DAUDIO_DDS_ENABLE -DAUDIO_PIN=A5
+
+audio_dac_dds_INC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/audio_dac_dds_mock \
+	$(PLATFORM_PATH)/chibios/drivers \
+	$(QUANTUM_PATH)/audio
+
+audio_dac_dds_SRC := \
+	$(PLATFORM_PATH)/chibios/drivers/audio_dac_dds.c \
+	$(QUANTUM_PATH)/audio/audio_dds.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/audio_dac_dds_tests.cpp
@@ -59,17 +59,27 @@ __attribute__((weak)) bool get_hold_on_other_key_press(uint16_t keycode, keyreco
 #        include "process_auto_shift.h"
 #    endif
 
-static keyrecord_t tapping_key                         = {};
-static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
-static uint8_t     waiting_buffer_head                 = 0;
-static uint8_t     waiting_buffer_tail                 = 0;
+#    if WAITING_BUFFER_SIZE < 2 || WAITING_BUFFER_SIZE > 255
+#        error "WAITING_BUFFER_SIZE must be between 2 and 255"
+#    endif
+#    define WAITING_BUFFER_NO_PAIR WAITING_BUFFER_SIZE
+
+static keyrecord_t tapping_key                              = {};
+static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE]      = {};
+static uint8_t     waiting_buffer_pair[WAITING_BUFFER_SIZE] = {};
+static uint8_t     waiting_buffer_head                      = 0;
+static uint8_t     waiting_buffer_tail                      = 0;
+static uint8_t     waiting_buffer_presses                   = 0;
 
 static bool process_tapping(keyrecord_t *record);
 static bool waiting_buffer_enq(keyrecord_t record);
+static void waiting_buffer_deq(void);
 static void waiting_buffer_clear(void);
+static void waiting_buffer_process(void);
+static void waiting_buffer_resolve_overflow(void);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
-static void waiting_buffer_scan_tap(void);
+static void waiting_buffer_scan_tap(keyrecord_t *keyp);
 static void debug_tapping_key(void);
 static void debug_waiting_buffer(void);
 
@@ -86,11 +96,16 @@ void action_tapping_process(keyrecord_t record) {
         }
     } else {
         if (!waiting_buffer_enq(record)) {
-            // clear all in case of overflow.
-            ac_dprintf("OVERFLOW: CLEAR ALL STATES\n");
-            clear_keyboard();
-            waiting_buffer_clear();
-            tapping_key = (keyrecord_t){0};
+            // make room by settling the oldest pending tap-hold key.
+            ac_dprintf("OVERFLOW: RESOLVE TAPPING KEY\n");
+            waiting_buffer_resolve_overflow();
+            if (!waiting_buffer_enq(record)) {
+                // clear all in case the overflow could not be resolved.
+                ac_dprintf("OVERFLOW: CLEAR ALL STATES\n");
+                clear_keyboard();
+                waiting_buffer_clear();
+                tapping_key = (keyrecord_t){0};
+            }
         }
     }
 
@@ -98,15 +113,7 @@ void action_tapping_process(keyrecord_t record) {
     if (IS_EVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         ac_dprintf("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
-        if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
-            ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
-            debug_record(waiting_buffer[waiting_buffer_tail]);
-            ac_dprintf("\n\n");
-        } else {
-            break;
-        }
-    }
+    waiting_buffer_process();
     if (IS_EVENT(record.event)) {
         ac_dprintf("\n");
     }
@@ -177,7 +184,7 @@ bool process_tapping(keyrecord_t *keyp) {
             ac_dprintf("Tapping: Start(Press tap key).\n");
             tapping_key = *keyp;
             process_record_tap_hint(&tapping_key);
-            waiting_buffer_scan_tap();
+            waiting_buffer_scan_tap(keyp);
             debug_tapping_key();
         } else {
             // the current key is just a regular key, pass it on for regular
@@ -317,7 +324,7 @@ bool process_tapping(keyrecord_t *keyp) {
                         ac_dprintf("Tapping: Start while last tap(1).\n");
                     }
                     tapping_key = *keyp;
-                    waiting_buffer_scan_tap();
+                    waiting_buffer_scan_tap(keyp);
                     debug_tapping_key();
                     return true;
                 } else {
@@ -368,7 +375,7 @@ bool process_tapping(keyrecord_t *keyp) {
                         ac_dprintf("Tapping: Start while last timeout tap(1).\n");
                     }
                     tapping_key = *keyp;
-                    waiting_buffer_scan_tap();
+                    waiting_buffer_scan_tap(keyp);
                     debug_tapping_key();
                     return true;
                 } else {
@@ -405,7 +412,7 @@ bool process_tapping(keyrecord_t *keyp) {
                     // Sequential tap can be interfered with other tap key.
                     ac_dprintf("Tapping: Start with interfering other tap.\n");
                     tapping_key = *keyp;
-                    waiting_buffer_scan_tap();
+                    waiting_buffer_scan_tap(keyp);
                     debug_tapping_key();
                     return true;
                 } else {
@@ -446,21 +453,80 @@ bool waiting_buffer_enq(keyrecord_t record) {
         return false;
     }
 
-    waiting_buffer[waiting_buffer_head] = record;
-    waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
+    uint8_t slot              = waiting_buffer_head;
+    waiting_buffer[slot]      = record;
+    waiting_buffer_pair[slot] = WAITING_BUFFER_NO_PAIR;
+    if (record.event.pressed) {
+        waiting_buffer_presses++;
+    } else {
+        // pair the release with the press of the same key, if it is still queued
+        for (uint8_t i = slot; i != waiting_buffer_tail;) {
+            i = (i + WAITING_BUFFER_SIZE - 1) % WAITING_BUFFER_SIZE;
+            if (KEYEQ(record.event.key, waiting_buffer[i].event.key)) {
+                if (waiting_buffer[i].event.pressed) {
+                    waiting_buffer_pair[i] = slot;
+                }
+                break;
+            }
+        }
+    }
+    waiting_buffer_head = (slot + 1) % WAITING_BUFFER_SIZE;
 
     ac_dprintf("waiting_buffer_enq: ");
     debug_waiting_buffer();
     return true;
 }
 
+/** \brief Waiting buffer deq
+ *
+ * Drops the oldest record, which must already have been processed.
+ */
+void waiting_buffer_deq(void) {
+    if (waiting_buffer[waiting_buffer_tail].event.pressed) {
+        waiting_buffer_presses--;
+    }
+    waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE;
+}
+
 /** \brief Waiting buffer clear
  *
  * FIXME: Needs docs
  */
 void waiting_buffer_clear(void) {
-    waiting_buffer_head = 0;
-    waiting_buffer_tail = 0;
+    waiting_buffer_head    = 0;
+    waiting_buffer_tail    = 0;
+    waiting_buffer_presses = 0;
+}
+
+/** \brief Waiting buffer process
+ *
+ * Processes queued records in order until one has to wait for the tapping key to settle.
+ */
+void waiting_buffer_process(void) {
+    while (waiting_buffer_tail != waiting_buffer_head) {
+        if (!process_tapping(&waiting_buffer[waiting_buffer_tail])) {
+            break;
+        }
+        ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
+        debug_record(waiting_buffer[waiting_buffer_tail]);
+        ac_dprintf("\n\n");
+        waiting_buffer_deq();
+    }
+}
+
+/** \brief Waiting buffer overflow resolution
+ *
+ * Settles the pending tapping key as held, the same as if TAPPING_TERM had passed,
+ * then processes the queued records so that at least one slot is freed.
+ */
+void waiting_buffer_resolve_overflow(void) {
+    if (IS_EVENT(tapping_key.event) && tapping_key.event.pressed && tapping_key.tap.count == 0) {
+        ac_dprintf("Tapping: End. No tap. Waiting buffer overflow\n");
+        process_record(&tapping_key);
+        tapping_key = (keyrecord_t){0};
+        debug_tapping_key();
+    }
+    waiting_buffer_process();
 }
 
 /** \brief Waiting buffer typed
@@ -468,6 +534,11 @@ void waiting_buffer_clear(void) {
  * FIXME: Needs docs
  */
 bool waiting_buffer_typed(keyevent_t event) {
+    // only a queued press can pair with a release, and vice versa
+    uint8_t queued = (waiting_buffer_head + WAITING_BUFFER_SIZE - waiting_buffer_tail) % WAITING_BUFFER_SIZE;
+    if (waiting_buffer_presses == (event.pressed ? queued : 0)) {
+        return false;
+    }
     for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
         if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed != waiting_buffer[i].event.pressed) {
             return true;
@@ -481,17 +552,14 @@ bool waiting_buffer_typed(keyevent_t event) {
  * FIXME: Needs docs
  */
 __attribute__((unused)) bool waiting_buffer_has_anykey_pressed(void) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (waiting_buffer[i].event.pressed) return true;
-    }
-    return false;
+    return waiting_buffer_presses > 0;
 }
 
 /** \brief Scan buffer for tapping
  *
  * FIXME: Needs docs
  */
-void waiting_buffer_scan_tap(void) {
+void waiting_buffer_scan_tap(keyrecord_t *keyp) {
     // early return if:
     // - tapping already is settled
     // - invalid state: tapping_key released && tap.count == 0
@@ -502,7 +570,17 @@ void waiting_buffer_scan_tap(void) {
 #    if (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT))
     TAP_DEFINE_KEYCODE;
 #    endif
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+    uint8_t first = waiting_buffer_tail;
+    uint8_t last  = waiting_buffer_head;
+    if (waiting_buffer_tail != waiting_buffer_head && keyp == &waiting_buffer[waiting_buffer_tail]) {
+        // a queued press already knows where its release is queued
+        first = waiting_buffer_pair[waiting_buffer_tail];
+        if (first == WAITING_BUFFER_NO_PAIR) {
+            return;
+        }
+        last = (first + 1) % WAITING_BUFFER_SIZE;
+    }
+    for (uint8_t i = first; i != last; i = (i + 1) % WAITING_BUFFER_SIZE) {
         keyrecord_t *candidate = &waiting_buffer[i];
         // clang-format off
         if (IS_EVENT(candidate->event) && KEYEQ(candidate->event.key, tapping_key.event.key) && !candidate->event.pressed && (
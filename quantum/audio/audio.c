@@ -82,7 +82,7 @@ bool playing_note   = false; // or (possibly multiple simultaneous) tones
 bool state_changed  = false; // global flag, which is set if anything changes with the active_tones
 
 // melody/SONG related state variables
-float (*notes_pointer)[][2];                           // SONG, an array of MUSICAL_NOTEs
+musical_note_t (*notes_pointer)[];                     // SONG, an array of MUSICAL_NOTEs
 uint16_t notes_count;                                  // length of the notes_pointer array
 bool     notes_repeat;                                 // PLAY_SONG or PLAY_LOOP?
 uint16_t melody_current_note_duration = 0;             // duration of the currently playing note from the active melody, in ms
@@ -90,6 +90,9 @@ uint8_t  note_tempo                   = TEMPO_DEFAULT; // beats-per-minute
 uint16_t current_note                 = 0;             // index into the array at notes_pointer
 bool     note_resting                 = false;         // if a short pause was introduced between two notes with the same frequency while playing a melody
 uint16_t last_timestamp               = 0;
+#ifdef AUDIO_PACKED_SONGS
+uint16_t note_tempo_scale = 1 << 12; // TEMPO_DEFAULT / note_tempo in Q12, scales the packed durations to the tempo
+#endif
 
 #ifdef AUDIO_ENABLE_TONE_MULTIPLEXING
 #    ifndef AUDIO_MAX_SIMULTANEOUS_TONES
@@ -114,9 +117,9 @@ extern uint16_t voices_timer;
 #ifndef AUDIO_OFF_SONG
 #    define AUDIO_OFF_SONG SONG(AUDIO_OFF_SOUND)
 #endif
-float startup_song[][2]   = STARTUP_SONG;
-float audio_on_song[][2]  = AUDIO_ON_SONG;
-float audio_off_song[][2] = AUDIO_OFF_SONG;
+musical_note_t startup_song[]   = STARTUP_SONG;
+musical_note_t audio_on_song[]  = AUDIO_ON_SONG;
+musical_note_t audio_off_song[] = AUDIO_OFF_SONG;
 
 static bool    audio_initialized    = false;
 static bool    audio_driver_stopped = true;
@@ -148,10 +151,20 @@ void audio_driver_start(void) {
     audio_driver_start_impl();
 }
 
+static eeconfig_section_t audio_eeconfig_section = {
+    .data    = &audio_config.raw,
+    .address = EECONFIG_AUDIO,
+    .size    = sizeof(audio_config.raw),
+};
+
 void eeconfig_update_audio_current(void) {
     eeconfig_update_audio(audio_config.raw);
 }
 
+void eeconfig_flag_audio(void) {
+    eeconfig_flag_section(&audio_eeconfig_section);
+}
+
 void eeconfig_update_audio_default(void) {
     audio_config.valid         = true;
     audio_config.enable        = AUDIO_DEFAULT_ON;
@@ -196,7 +209,7 @@ void audio_toggle(void) {
         stop_all_notes();
     }
     audio_config.enable ^= 1;
-    eeconfig_update_audio(audio_config.raw);
+    eeconfig_flag_audio();
     if (audio_config.enable) {
         audio_on_user();
     } else {
@@ -206,7 +219,7 @@ void audio_toggle(void) {
 
 void audio_on(void) {
     audio_config.enable = 1;
-    eeconfig_update_audio(audio_config.raw);
+    eeconfig_flag_audio();
     audio_on_user();
     PLAY_SONG(audio_on_song);
 }
@@ -217,7 +230,7 @@ void audio_off(void) {
     wait_ms(100);
     audio_stop_all();
     audio_config.enable = 0;
-    eeconfig_update_audio(audio_config.raw);
+    eeconfig_flag_audio();
 }
 
 bool audio_is_on(void) {
@@ -339,7 +352,38 @@ void audio_play_tone(float pitch) {
     audio_play_note(pitch, 0xffff);
 }
 
-void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat) {
+/**
+ * Pitch of a note of the playing melody, in Hz.
+ */
+static inline float melody_note_pitch(uint16_t index) {
+#ifdef AUDIO_PACKED_SONGS
+    return (*notes_pointer)[index].pitch * (1.0f / AUDIO_PACKED_PITCH_SCALE);
+#else
+    return (*notes_pointer)[index][0];
+#endif
+}
+
+/**
+ * Duration of a note of the playing melody, in milliseconds at the current tempo.
+ */
+static inline uint16_t melody_note_duration(uint16_t index) {
+#ifdef AUDIO_PACKED_SONGS
+    uint32_t duration = ((uint32_t)(*notes_pointer)[index].duration * note_tempo_scale) >> 12;
+    return MIN(duration, UINT16_MAX);
+#else
+    return audio_duration_to_ms((*notes_pointer)[index][1]);
+#endif
+}
+
+static inline bool melody_notes_same_pitch(uint16_t a, uint16_t b) {
+#ifdef AUDIO_PACKED_SONGS
+    return (*notes_pointer)[a].pitch == (*notes_pointer)[b].pitch;
+#else
+    return (*notes_pointer)[a][0] == (*notes_pointer)[b][0];
+#endif
+}
+
+void audio_play_melody(musical_note_t (*np)[], uint16_t n_count, bool n_repeat) {
     if (!audio_config.enable) {
         audio_stop_all();
         return;
@@ -367,29 +411,25 @@ void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat) {
 
     // start first note manually, which also starts the audio_driver
     // all following/remaining notes are played by 'audio_update_state'
-    audio_play_note((*notes_pointer)[current_note][0], audio_duration_to_ms((*notes_pointer)[current_note][1]));
-    last_timestamp               = timer_read();
-    melody_current_note_duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+    melody_current_note_duration = melody_note_duration(current_note);
+    audio_play_note(melody_note_pitch(current_note), melody_current_note_duration);
+    last_timestamp = timer_read();
 }
 
-float click[2][2];
-void  audio_play_click(uint16_t delay, float pitch, uint16_t duration) {
+musical_note_t click[2];
+void           audio_play_click(uint16_t delay, float pitch, uint16_t duration) {
     uint16_t duration_tone  = audio_ms_to_duration(duration);
     uint16_t duration_delay = audio_ms_to_duration(delay);
 
     if (delay <= 0.0f) {
-        click[0][0] = pitch;
-        click[0][1] = duration_tone;
-        click[1][0] = 0.0f;
-        click[1][1] = 0.0f;
+        MUSICAL_NOTE_SET(click[0], pitch, duration_tone);
+        MUSICAL_NOTE_SET(click[1], 0.0f, 0);
         audio_play_melody(&click, 1, false);
     } else {
         // first note is a rest/pause
-        click[0][0] = 0.0f;
-        click[0][1] = duration_delay;
+        MUSICAL_NOTE_SET(click[0], 0.0f, duration_delay);
         // second note is the actual click
-        click[1][0] = pitch;
-        click[1][1] = duration_tone;
+        MUSICAL_NOTE_SET(click[1], pitch, duration_tone);
         audio_play_melody(&click, 2, false);
     }
 }
@@ -460,7 +500,7 @@ bool audio_update_state(void) {
                 }
             }
 
-            if (!note_resting && (*notes_pointer)[previous_note][0] == (*notes_pointer)[current_note][0]) {
+            if (!note_resting && melody_notes_same_pitch(previous_note, current_note)) {
                 note_resting = true;
 
                 // special handling for successive notes of the same frequency:
@@ -484,13 +524,13 @@ bool audio_update_state(void) {
 
                 // '- delta': Skip forward in the next note's length if we've over shot
                 //            the last, so the overall length of the song is the same
-                uint16_t duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+                uint16_t duration = melody_note_duration(current_note);
 
                 // Skip forward past any completely missed notes
                 while (delta > duration && current_note < notes_count - 1) {
                     delta -= duration;
                     current_note++;
-                    duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+                    duration = melody_note_duration(current_note);
                 }
 
                 if (delta < duration) {
@@ -501,7 +541,7 @@ bool audio_update_state(void) {
                     duration = 1;
                 }
 
-                audio_play_note((*notes_pointer)[current_note][0], duration);
+                audio_play_note(melody_note_pitch(current_note), duration);
                 melody_current_note_duration = duration;
             }
         }
@@ -563,12 +603,19 @@ void audio_decrease_tone_multiplexing_rate(uint16_t change) {
 
 // Tempo functions
 
+static void audio_tempo_changed(void) {
+#ifdef AUDIO_PACKED_SONGS
+    note_tempo_scale = MIN(((uint32_t)TEMPO_DEFAULT << 12) / note_tempo, UINT16_MAX);
+#endif
+}
+
 void audio_set_tempo(uint8_t tempo) {
     if (tempo < 10) note_tempo = 10;
     //  else if (tempo > 250)
     //      note_tempo = 250;
     else
         note_tempo = tempo;
+    audio_tempo_changed();
 }
 
 void audio_increase_tempo(uint8_t tempo_change) {
@@ -576,6 +623,7 @@ void audio_increase_tempo(uint8_t tempo_change) {
         note_tempo = 255;
     else
         note_tempo += tempo_change;
+    audio_tempo_changed();
 }
 
 void audio_decrease_tempo(uint8_t tempo_change) {
@@ -583,6 +631,7 @@ void audio_decrease_tempo(uint8_t tempo_change) {
         note_tempo = 10;
     else
         note_tempo -= tempo_change;
+    audio_tempo_changed();
 }
 
 /**
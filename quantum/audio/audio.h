@@ -60,6 +60,11 @@ typedef struct {
  */
 void eeconfig_update_audio_current(void);
 
+/**
+ * @brief Save the current choices to the eeprom once things have been quiet for a while
+ */
+void eeconfig_flag_audio(void);
+
 /**
  * @brief one-time initialization called by quantum/quantum.c
  * @details usually done lazy, when some tones are to be played
@@ -131,13 +136,14 @@ void audio_stop_tone(float pitch);
  * @brief play a melody
  *
  * @details starts playback of a melody passed in from a SONG definition - an
- *          array of {pitch, duration} float-tuples
+ *          array of musical_note_t, which are {pitch, duration} float-tuples
+ *          unless AUDIO_PACKED_SONGS is enabled
  *
  * @param[in] np note-pointer to the SONG array
  * @param[in] n_count number of MUSICAL_NOTES of the SONG
  * @param[in] n_repeat false for onetime, true for looped playback
  */
-void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat);
+void audio_play_melody(musical_note_t (*np)[], uint16_t n_count, bool n_repeat);
 
 /**
  * @brief play a short tone of a specific frequency to emulate a 'click'
@@ -172,7 +178,7 @@ bool audio_is_playing_melody(void);
 
 // These macros are used to allow audio_play_melody to play an array of indeterminate
 // length. This works around the limitation of C's sizeof operation on pointers.
-// The global float array for the song must be used here.
+// The global musical_note_t array for the song must be used here.
 #define NOTE_ARRAY_SIZE(x) ((int16_t)(sizeof(x) / (sizeof(x[0]))))
 
 /**
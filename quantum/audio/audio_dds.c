@@ -0,0 +1,313 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "audio.h"
+#include "audio_dds.h"
+#include "progmem.h"
+#include "util.h"
+
+/* envelope levels are Q15 in the upper half, with 16 bits of fraction below for the slopes */
+#define DDS_LEVEL_MAX (32767UL << 16)
+#define DDS_MS_TO_SAMPLES(ms) ((uint32_t)(ms) * AUDIO_DDS_SAMPLE_RATE / 1000 > 0 ? (uint32_t)(ms) * AUDIO_DDS_SAMPLE_RATE / 1000 : 1)
+
+#define DDS_ATTACK_STEP (DDS_LEVEL_MAX / DDS_MS_TO_SAMPLES(AUDIO_DDS_ATTACK_MS))
+#define DDS_SUSTAIN_LEVEL (DDS_LEVEL_MAX / 100 * AUDIO_DDS_SUSTAIN_PERCENT)
+#define DDS_DECAY_STEP ((DDS_LEVEL_MAX - DDS_SUSTAIN_LEVEL) / DDS_MS_TO_SAMPLES(AUDIO_DDS_DECAY_MS))
+#define DDS_RELEASE_STEP (DDS_LEVEL_MAX / DDS_MS_TO_SAMPLES(AUDIO_DDS_RELEASE_MS))
+
+/* the top bits of the phase index the wavetable, the next 16 interpolate between entries */
+#define DDS_WAVETABLE_BITS 8
+#define DDS_INDEX_SHIFT (32 - DDS_WAVETABLE_BITS)
+#define DDS_FRACTION_SHIFT (DDS_INDEX_SHIFT - 16)
+
+typedef enum {
+    DDS_IDLE,
+    DDS_ATTACK,
+    DDS_DECAY,
+    DDS_SUSTAIN,
+    DDS_RELEASE,
+} dds_stage_t;
+
+typedef struct {
+    uint32_t    phase;
+    uint32_t    increment;
+    uint32_t    level;
+    uint32_t    key; // the tone played, see audio_dds_set_tones
+    dds_stage_t stage;
+} dds_voice_t;
+
+// clang-format off
+/* one period of sin() in Q15, with the first entry repeated at the end for interpolation */
+static const int16_t dds_sine[(1 << DDS_WAVETABLE_BITS) + 1] PROGMEM = {
+    0, 804, 1608, 2410, 3212, 4011, 4808, 5602, 6393, 7179, 7962, 8739, 9512, 10278, 11039, 11793,
+    12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530, 18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+    23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790, 27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971, 32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+    32767, 32757, 32728, 32678, 32609, 32521, 32412, 32285, 32137, 31971, 31785, 31580, 31356, 31113, 30852, 30571,
+    30273, 29956, 29621, 29268, 28898, 28510, 28105, 27683, 27245, 26790, 26319, 25832, 25329, 24811, 24279, 23731,
+    23170, 22594, 22005, 21403, 20787, 20159, 19519, 18868, 18204, 17530, 16846, 16151, 15446, 14732, 14010, 13279,
+    12539, 11793, 11039, 10278, 9512, 8739, 7962, 7179, 6393, 5602, 4808, 4011, 3212, 2410, 1608, 804,
+    0, -804, -1608, -2410, -3212, -4011, -4808, -5602, -6393, -7179, -7962, -8739, -9512, -10278, -11039, -11793,
+    -12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530, -18204, -18868, -19519, -20159, -20787, -21403, -22005, -22594,
+    -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790, -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956,
+    -30273, -30571, -30852, -31113, -31356, -31580, -31785, -31971, -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+    -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285, -32137, -31971, -31785, -31580, -31356, -31113, -30852, -30571,
+    -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683, -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731,
+    -23170, -22594, -22005, -21403, -20787, -20159, -19519, -18868, -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+    -12539, -11793, -11039, -10278, -9512, -8739, -7962, -7179, -6393, -5602, -4808, -4011, -3212, -2410, -1608, -804,
+    0,
+};
+// clang-format on
+
+static dds_voice_t dds_voices[AUDIO_DDS_VOICES];
+
+void audio_dds_init(void) {
+    for (uint8_t i = 0; i < AUDIO_DDS_VOICES; i++) {
+        dds_voices[i] = (dds_voice_t){.stage = DDS_IDLE};
+    }
+}
+
+/**
+ * @brief Converts a frequency to the phase increment per sample
+ *
+ * This is the only float math of the synthesis, so it should be done
+ * whenever a tone changes rather than while rendering.
+ *
+ * @param[in] frequency float in Hz
+ * @return uint32_t phase increment, 0 for rests
+ */
+uint32_t audio_dds_increment(float frequency) {
+    if (frequency <= 0.0f) {
+        return 0;
+    }
+    // keep below the nyquist frequency, which also keeps the conversion in range
+    if (frequency >= AUDIO_DDS_SAMPLE_RATE / 2) {
+        return UINT32_MAX / 2;
+    }
+    return (uint32_t)(frequency * (4294967296.0f / AUDIO_DDS_SAMPLE_RATE));
+}
+
+/**
+ * @brief Starts or retunes a voice
+ *
+ * A silent voice starts from the beginning of its attack, a sounding one keeps
+ * its phase and envelope so that changing the pitch does not click; a voice
+ * that is being released attacks again from its current level.
+ *
+ * @param[in] voice uint8_t index below AUDIO_DDS_VOICES
+ * @param[in] increment uint32_t from audio_dds_increment
+ */
+void audio_dds_voice_start(uint8_t voice, uint32_t increment) {
+    if (voice >= AUDIO_DDS_VOICES) {
+        return;
+    }
+    dds_voice_t *v = &dds_voices[voice];
+
+    v->increment = increment;
+    if (v->stage == DDS_IDLE) {
+        v->phase = 0;
+        v->level = 0;
+    }
+    if (v->stage == DDS_IDLE || v->stage == DDS_RELEASE) {
+        v->stage = DDS_ATTACK;
+    }
+}
+
+/**
+ * @brief Releases a voice, which fades out and then falls silent
+ *
+ * @param[in] voice uint8_t index below AUDIO_DDS_VOICES
+ */
+void audio_dds_voice_stop(uint8_t voice) {
+    if (voice >= AUDIO_DDS_VOICES) {
+        return;
+    }
+    if (dds_voices[voice].stage != DDS_IDLE) {
+        dds_voices[voice].stage = DDS_RELEASE;
+    }
+}
+
+void audio_dds_stop_all(void) {
+    for (uint8_t i = 0; i < AUDIO_DDS_VOICES; i++) {
+        audio_dds_voice_stop(i);
+    }
+}
+
+/**
+ * @brief Picks a voice for a new tone: a silent one, or else the quietest in its release
+ *
+ * @param[in] taken bool* for each voice, true if it already plays a tone
+ * @return uint8_t voice index
+ */
+static uint8_t dds_free_voice(const bool *taken) {
+    uint8_t best = AUDIO_DDS_VOICES;
+    for (uint8_t i = 0; i < AUDIO_DDS_VOICES; i++) {
+        if (taken[i]) {
+            continue;
+        }
+        if (dds_voices[i].stage == DDS_IDLE) {
+            return i;
+        }
+        if (best == AUDIO_DDS_VOICES || (dds_voices[i].stage == DDS_RELEASE && (dds_voices[best].stage != DDS_RELEASE || dds_voices[i].level < dds_voices[best].level))) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Plays a set of tones, keeping each on the voice it already has
+ *
+ * A tone is identified by its key, for example the phase increment of its
+ * unprocessed frequency, so that it stays on the same voice and keeps its
+ * phase while its increment changes through vibrato, and while other tones
+ * start and stop. New tones take a silent voice if there is one, otherwise the
+ * quietest voice being released. Voices whose tone is gone are released.
+ *
+ * @param[in] keys uint32_t* identifying each tone, 0 for rests
+ * @param[in] increments uint32_t* from audio_dds_increment, for each tone
+ * @param[in] count uint8_t number of tones, at most AUDIO_DDS_VOICES are played
+ */
+void audio_dds_set_tones(const uint32_t *keys, const uint32_t *increments, uint8_t count) {
+    bool    kept[AUDIO_DDS_VOICES] = {false};
+    uint8_t voice_of[AUDIO_DDS_VOICES];
+
+    count = MIN(count, AUDIO_DDS_VOICES);
+    for (uint8_t t = 0; t < count; t++) {
+        voice_of[t] = AUDIO_DDS_VOICES;
+        if (!keys[t] || !increments[t]) {
+            continue;
+        }
+        for (uint8_t i = 0; i < AUDIO_DDS_VOICES; i++) {
+            if (!kept[i] && dds_voices[i].stage != DDS_IDLE && dds_voices[i].key == keys[t]) {
+                kept[i]     = true;
+                voice_of[t] = i;
+                break;
+            }
+        }
+    }
+
+    for (uint8_t t = 0; t < count; t++) {
+        if (!keys[t] || !increments[t]) {
+            continue;
+        }
+        if (voice_of[t] == AUDIO_DDS_VOICES) {
+            voice_of[t]       = dds_free_voice(kept);
+            kept[voice_of[t]] = true;
+        }
+        dds_voices[voice_of[t]].key = keys[t];
+        audio_dds_voice_start(voice_of[t], increments[t]);
+    }
+
+    for (uint8_t i = 0; i < AUDIO_DDS_VOICES; i++) {
+        if (!kept[i]) {
+            audio_dds_voice_stop(i);
+        }
+    }
+}
+
+/**
+ * @brief Checks whether any voice is still audible, including its release
+ *
+ * @return true if rendering would produce anything but silence
+ */
+bool audio_dds_is_active(void) {
+    for (uint8_t i = 0; i < AUDIO_DDS_VOICES; i++) {
+        if (dds_voices[i].stage != DDS_IDLE) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Advances the envelope of a voice by one sample
+ *
+ * @param[in] v dds_voice_t* to advance
+ * @return false once the voice has fallen silent
+ */
+static inline bool dds_envelope_step(dds_voice_t *v) {
+    switch (v->stage) {
+        case DDS_ATTACK:
+            if (v->level >= DDS_LEVEL_MAX - DDS_ATTACK_STEP) {
+                v->level = DDS_LEVEL_MAX;
+                v->stage = DDS_DECAY;
+            } else {
+                v->level += DDS_ATTACK_STEP;
+            }
+            break;
+        case DDS_DECAY:
+            if (v->level <= DDS_SUSTAIN_LEVEL + DDS_DECAY_STEP) {
+                v->level = DDS_SUSTAIN_LEVEL;
+                v->stage = DDS_SUSTAIN;
+            } else {
+                v->level -= DDS_DECAY_STEP;
+            }
+            break;
+        case DDS_RELEASE:
+            if (v->level <= DDS_RELEASE_STEP) {
+                v->level = 0;
+                v->stage = DDS_IDLE;
+                return false;
+            }
+            v->level -= DDS_RELEASE_STEP;
+            break;
+        case DDS_SUSTAIN:
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Renders all voices into signed 16 bit PCM
+ *
+ * Every voice contributes at most 1/AUDIO_DDS_VOICES of full scale, so the
+ * mix never clips no matter how many voices are sounding.
+ *
+ * @param[out] buffer int16_t* samples to fill
+ * @param[in] length size_t number of samples
+ */
+void audio_dds_render(int16_t *buffer, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        buffer[i] = 0;
+    }
+
+    for (uint8_t i = 0; i < AUDIO_DDS_VOICES; i++) {
+        dds_voice_t *v = &dds_voices[i];
+        if (v->stage == DDS_IDLE) {
+            continue;
+        }
+
+        uint32_t phase = v->phase;
+        for (size_t s = 0; s < length; s++) {
+            if (!dds_envelope_step(v)) {
+                break;
+            }
+
+            uint16_t index    = phase >> DDS_INDEX_SHIFT;
+            int32_t  fraction = (uint16_t)(phase >> DDS_FRACTION_SHIFT);
+            int32_t  a        = (int16_t)pgm_read_word(&dds_sine[index]);
+            int32_t  b        = (int16_t)pgm_read_word(&dds_sine[index + 1]);
+            int32_t  sample   = a + (((b - a) * fraction) >> 16);
+
+            buffer[s] += ((sample * (int32_t)(v->level >> 16)) >> 15) / AUDIO_DDS_VOICES;
+            phase += v->increment;
+        }
+        v->phase = phase;
+    }
+}
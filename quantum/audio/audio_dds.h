@@ -0,0 +1,91 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Fixed-point direct digital synthesis
+ *
+ * Every voice owns a 32 bit phase accumulator which is advanced by a
+ * precomputed increment each sample; the top bits index a sine wavetable in
+ * flash and the bits below interpolate between neighbouring entries. Each
+ * voice is shaped by a linear ADSR envelope, and all voices are mixed into
+ * signed 16 bit PCM. Rendering uses integer math only, so it is safe to call
+ * from an interrupt; the conversion from a frequency to a phase increment is
+ * the only float operation and is meant to happen outside of it.
+ */
+
+/* check settings and set defaults */
+#ifndef AUDIO_DDS_ENABLE
+#    error "AUDIO_DDS_ENABLE not defined! check config settings"
+#endif
+
+#ifndef AUDIO_DDS_SAMPLE_RATE
+#    ifdef AUDIO_DAC_SAMPLE_RATE
+/* the DAC is triggered on every second tick of a timer running at three times AUDIO_DAC_SAMPLE_RATE */
+#        define AUDIO_DDS_SAMPLE_RATE (AUDIO_DAC_SAMPLE_RATE * 3 / 2)
+#    else
+#        define AUDIO_DDS_SAMPLE_RATE 16384U
+#    endif
+#endif
+
+#ifndef AUDIO_DDS_VOICES
+#    ifdef AUDIO_MAX_SIMULTANEOUS_TONES
+#        define AUDIO_DDS_VOICES AUDIO_MAX_SIMULTANEOUS_TONES
+#    else
+#        define AUDIO_DDS_VOICES 4
+#    endif
+#endif
+
+#ifndef AUDIO_DDS_ATTACK_MS
+#    define AUDIO_DDS_ATTACK_MS 5
+#endif
+#ifndef AUDIO_DDS_DECAY_MS
+#    define AUDIO_DDS_DECAY_MS 40
+#endif
+#ifndef AUDIO_DDS_SUSTAIN_PERCENT
+#    define AUDIO_DDS_SUSTAIN_PERCENT 70
+#endif
+#ifndef AUDIO_DDS_RELEASE_MS
+#    define AUDIO_DDS_RELEASE_MS 20
+#endif
+
+#if AUDIO_DDS_VOICES < 1 || AUDIO_DDS_VOICES > 16
+#    error "AUDIO_DDS_VOICES must be between 1 and 16"
+#endif
+#if AUDIO_DDS_SUSTAIN_PERCENT < 0 || AUDIO_DDS_SUSTAIN_PERCENT > 100
+#    error "AUDIO_DDS_SUSTAIN_PERCENT must be between 0 and 100"
+#endif
+
+/* ----------For Controlling Voices---------------------------------------------------------------- */
+/*
+ * These must not run concurrently with audio_dds_render; a driver rendering
+ * from an interrupt has to lock it out while calling them.
+ */
+void     audio_dds_init(void);
+uint32_t audio_dds_increment(float frequency);
+void     audio_dds_voice_start(uint8_t voice, uint32_t increment);
+void     audio_dds_voice_stop(uint8_t voice);
+void     audio_dds_stop_all(void);
+void     audio_dds_set_tones(const uint32_t *keys, const uint32_t *increments, uint8_t count);
+bool     audio_dds_is_active(void);
+
+/* ----------For Rendering------------------------------------------------------------------------- */
+void audio_dds_render(int16_t *buffer, size_t length);
@@ -16,6 +16,8 @@
  */
 #pragma once
 
+#include <stdint.h>
+
 #ifndef TEMPO_DEFAULT
 #    define TEMPO_DEFAULT 120
 // in beats-per-minute
@@ -24,9 +26,52 @@
 #define SONG(notes...) \
     { notes }
 
+/* A single note of a SONG, declare songs as 'musical_note_t my_song[] = SONG(...);'
+ *
+ * With AUDIO_PACKED_SONGS the notes are converted to integers by the compiler:
+ * the pitch in 1/AUDIO_PACKED_PITCH_SCALE Hz, and the duration in milliseconds
+ * at TEMPO_DEFAULT, which playback scales to the current tempo. Otherwise a
+ * note is a {pitch, duration} float pair, the same as 'float my_song[][2]'.
+ */
+#ifdef AUDIO_PACKED_SONGS
+#    define AUDIO_PACKED_PITCH_SCALE 8
+typedef struct {
+    uint16_t pitch;
+    uint16_t duration;
+} musical_note_t;
+
+/* Pitches above UINT16_MAX / AUDIO_PACKED_PITCH_SCALE (8191.875 Hz) and durations beyond 65535 ms are clamped */
+#    define AUDIO_PACK_PITCH(pitch) ((pitch) <= 0 ? 0 : (pitch) >= (float)UINT16_MAX / AUDIO_PACKED_PITCH_SCALE ? UINT16_MAX : (uint16_t)((pitch) * AUDIO_PACKED_PITCH_SCALE + 0.5f))
+#    define AUDIO_PACK_DURATION_MS(duration) (((uint32_t)(duration) * 1875 + TEMPO_DEFAULT) / (TEMPO_DEFAULT * 2))
+#    define AUDIO_PACK_DURATION(duration) (AUDIO_PACK_DURATION_MS(duration) > UINT16_MAX ? UINT16_MAX : (uint16_t)AUDIO_PACK_DURATION_MS(duration))
+
+/* Evaluates a pitch computed at runtime only once */
+static inline uint16_t audio_pack_pitch(float pitch) {
+    return AUDIO_PACK_PITCH(pitch);
+}
+
+#    define MUSICAL_NOTE_SET(note, pitch_hz, duration_bpm)        \
+        do {                                                     \
+            (note).pitch    = audio_pack_pitch(pitch_hz);        \
+            (note).duration = AUDIO_PACK_DURATION(duration_bpm); \
+        } while (0)
+
 // Note Types
-#define MUSICAL_NOTE(note, duration) \
-    { (NOTE##note), duration }
+#    define MUSICAL_NOTE(note, duration) \
+        { AUDIO_PACK_PITCH(NOTE##note), AUDIO_PACK_DURATION(duration) }
+#else
+typedef float musical_note_t[2];
+
+#    define MUSICAL_NOTE_SET(note, pitch_hz, duration_bpm) \
+        do {                                               \
+            (note)[0] = (pitch_hz);                        \
+            (note)[1] = (duration_bpm);                    \
+        } while (0)
+
+// Note Types
+#    define MUSICAL_NOTE(note, duration) \
+        { (NOTE##note), duration }
+#endif
 
 #define BREVE_NOTE(note) MUSICAL_NOTE(note, 128)
 #define WHOLE_NOTE(note) MUSICAL_NOTE(note, 64)
@@ -9,6 +9,8 @@
 #    define MAX_DEFERRED_EXECUTORS 8
 #endif
 
+_Static_assert(MAX_DEFERRED_EXECUTORS <= DEFERRED_EXEC_MAX_TABLE_COUNT, "MAX_DEFERRED_EXECUTORS is too large");
+
 //------------------------------------
 // Helpers
 //
@@ -27,6 +29,25 @@ static inline bool token_can_be_used(deferred_executor_t *table, size_t table_co
     return true;
 }
 
+// The first slot of each table holds the index of the executor due soonest, so that each tick only has to check that one.
+// Executors never move, so the ones due on the same tick still run in slot order. While a table's executors are running
+// they may be changed freely, and the index is worked out again afterwards.
+static deferred_executor_t *running_table = NULL;
+
+static inline bool executor_is_earlier(const deferred_executor_t *a, const deferred_executor_t *b) {
+    return ((int32_t)TIMER_DIFF_32(a->trigger_time, b->trigger_time)) < 0;
+}
+
+static void find_next_executor(deferred_executor_t *table, size_t table_count) {
+    uint8_t next = 0;
+    for (size_t i = 1; i < table_count; ++i) {
+        if (table[i].token != INVALID_DEFERRED_TOKEN && (table[next].token == INVALID_DEFERRED_TOKEN || executor_is_earlier(&table[i], &table[next]))) {
+            next = i;
+        }
+    }
+    table[0].next = next;
+}
+
 static inline deferred_token allocate_token(deferred_executor_t *table, size_t table_count) {
     deferred_token first = ++current_token;
     while (!token_can_be_used(table, table_count, current_token)) {
@@ -45,7 +66,7 @@ static inline deferred_token allocate_token(deferred_executor_t *table, size_t t
 
 deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_count, uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg) {
     // Ignore queueing if the table isn't valid, it's a zero-time delay, or the token is not valid
-    if (!table || table_count == 0 || delay_ms == 0 || !callback) {
+    if (!table || table_count == 0 || table_count > DEFERRED_EXEC_MAX_TABLE_COUNT || delay_ms == 0 || !callback) {
         return INVALID_DEFERRED_TOKEN;
     }
 
@@ -64,6 +85,12 @@ deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_coun
             entry->trigger_time = timer_read32() + delay_ms;
             entry->callback     = callback;
             entry->cb_arg       = cb_arg;
+            if (table != running_table) {
+                deferred_executor_t *next = &table[table[0].next];
+                if (next->token == INVALID_DEFERRED_TOKEN || executor_is_earlier(entry, next)) {
+                    table[0].next = i;
+                }
+            }
             return current_token;
         }
     }
@@ -74,7 +101,7 @@ deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_coun
 
 bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token, uint32_t delay_ms) {
     // Ignore queueing if the table isn't valid, it's a zero-time delay, or the token is not valid
-    if (!table || table_count == 0 || delay_ms == 0 || token == INVALID_DEFERRED_TOKEN) {
+    if (!table || table_count == 0 || table_count > DEFERRED_EXEC_MAX_TABLE_COUNT || delay_ms == 0 || token == INVALID_DEFERRED_TOKEN) {
         return false;
     }
 
@@ -84,6 +111,13 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
         if (entry->token == token) {
             // Found it, extend the delay
             entry->trigger_time = timer_read32() + delay_ms;
+            if (table != running_table) {
+                if (i == table[0].next) {
+                    find_next_executor(table, table_count);
+                } else if (executor_is_earlier(entry, &table[table[0].next])) {
+                    table[0].next = i;
+                }
+            }
             return true;
         }
     }
@@ -94,7 +128,7 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
 
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
     // Ignore request if the table/token are not valid
-    if (!table || table_count == 0 || token == INVALID_DEFERRED_TOKEN) {
+    if (!table || table_count == 0 || table_count > DEFERRED_EXEC_MAX_TABLE_COUNT || token == INVALID_DEFERRED_TOKEN) {
         return false;
     }
 
@@ -107,6 +141,9 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
             entry->trigger_time = 0;
             entry->callback     = NULL;
             entry->cb_arg       = NULL;
+            if (i == table[0].next && table != running_table) {
+                find_next_executor(table, table_count);
+            }
             return true;
         }
     }
@@ -116,12 +153,24 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
 }
 
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
+    // Nothing can have been queued in a table that isn't valid
+    if (!table || table_count == 0 || table_count > DEFERRED_EXEC_MAX_TABLE_COUNT) {
+        return;
+    }
+
     uint32_t now = timer_read32();
 
     // Throttle only once per millisecond
     if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
         *last_execution_time = now;
 
+        // Nothing is due if the soonest executor isn't
+        deferred_executor_t *next = &table[table[0].next];
+        if (next->token == INVALID_DEFERRED_TOKEN || ((int32_t)TIMER_DIFF_32(next->trigger_time, now)) > 0) {
+            return;
+        }
+        running_table = table;
+
         // Run through each of the executors
         for (int i = 0; i < table_count; ++i) {
             deferred_executor_t *entry      = &table[i];
@@ -153,6 +202,9 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
                 }
             }
         }
+
+        running_table = NULL;
+        find_next_executor(table, table_count);
     }
 }
 
@@ -76,16 +76,23 @@ void deferred_exec_task(void);
  */
 typedef struct deferred_executor_t {
     deferred_token         token;
+    uint8_t                next; // only used in the first slot of a table
     uint32_t               trigger_time;
     deferred_exec_callback callback;
     void *                 cb_arg;
 } deferred_executor_t;
 
+/**
+ * The largest table accepted by the advanced API, as each table keeps the index of its soonest executor in a byte. There
+ * are no more tokens than that either.
+ */
+#define DEFERRED_EXEC_MAX_TABLE_COUNT UINT8_MAX
+
 /**
  * Configures the supplied deferred executor to be executed after the required number of milliseconds.
  *
  * @param table[in] the custom table used for storage
- * @param table_count[in] the number of available items in the table
+ * @param table_count[in] the number of available items in the table, at most DEFERRED_EXEC_MAX_TABLE_COUNT
  * @param delay_ms[in] the number of milliseconds before executing the callback
  * @param callback[in] the executor to invoke
  * @param cb_arg[in] the argument to pass to the executor, may be NULL if unused by the executor
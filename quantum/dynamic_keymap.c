@@ -18,6 +18,7 @@
 #include "keymap_introspection.h"
 #include "action.h"
 #include "eeprom.h"
+#include "matrix.h"
 #include "progmem.h"
 #include "send_string.h"
 #include "keycodes.h"
@@ -68,9 +69,33 @@
 #    define DYNAMIC_KEYMAP_EEPROM_ADDR DYNAMIC_KEYMAP_EEPROM_START
 #endif
 
+#ifdef DYNAMIC_KEYMAP_COMPRESSED
+// Compressed keymaps store each layer on its own: one bit per key, set for
+// the keys which are not KC_TRANSPARENT, the keycodes of just those keys in
+// row/column order, and a checksum of both. The first
+// DYNAMIC_KEYMAP_COMPRESSED_FULL_LAYERS layers have room for every key, the
+// others for DYNAMIC_KEYMAP_COMPRESSED_LAYER_KEYCODE_COUNT keycodes.
+#    ifndef DYNAMIC_KEYMAP_COMPRESSED_FULL_LAYERS
+#        define DYNAMIC_KEYMAP_COMPRESSED_FULL_LAYERS 1
+#    endif
+#    ifndef DYNAMIC_KEYMAP_COMPRESSED_LAYER_KEYCODE_COUNT
+#        define DYNAMIC_KEYMAP_COMPRESSED_LAYER_KEYCODE_COUNT ((MATRIX_ROWS * MATRIX_COLS) / 4)
+#    endif
+#    define DYNAMIC_KEYMAP_ROW_SIZE ((MATRIX_COLS + 7) / 8)
+#    define DYNAMIC_KEYMAP_LAYER_BITMAP_SIZE (MATRIX_ROWS * DYNAMIC_KEYMAP_ROW_SIZE)
+#    define DYNAMIC_KEYMAP_LAYER_EEPROM_SIZE(keycode_count) (DYNAMIC_KEYMAP_LAYER_BITMAP_SIZE + ((keycode_count) * 2) + 2)
+#    define DYNAMIC_KEYMAP_FULL_LAYER_EEPROM_SIZE DYNAMIC_KEYMAP_LAYER_EEPROM_SIZE(MATRIX_ROWS * MATRIX_COLS)
+#    define DYNAMIC_KEYMAP_SMALL_LAYER_EEPROM_SIZE DYNAMIC_KEYMAP_LAYER_EEPROM_SIZE(DYNAMIC_KEYMAP_COMPRESSED_LAYER_KEYCODE_COUNT)
+#    define DYNAMIC_KEYMAP_KEYMAP_EEPROM_SIZE ((DYNAMIC_KEYMAP_COMPRESSED_FULL_LAYERS * DYNAMIC_KEYMAP_FULL_LAYER_EEPROM_SIZE) + ((DYNAMIC_KEYMAP_LAYER_COUNT - DYNAMIC_KEYMAP_COMPRESSED_FULL_LAYERS) * DYNAMIC_KEYMAP_SMALL_LAYER_EEPROM_SIZE))
+_Static_assert(DYNAMIC_KEYMAP_COMPRESSED_FULL_LAYERS <= DYNAMIC_KEYMAP_LAYER_COUNT, "DYNAMIC_KEYMAP_COMPRESSED_FULL_LAYERS must not exceed DYNAMIC_KEYMAP_LAYER_COUNT");
+_Static_assert(DYNAMIC_KEYMAP_COMPRESSED_LAYER_KEYCODE_COUNT <= MATRIX_ROWS * MATRIX_COLS, "DYNAMIC_KEYMAP_COMPRESSED_LAYER_KEYCODE_COUNT must not exceed the number of keys");
+#else
+#    define DYNAMIC_KEYMAP_KEYMAP_EEPROM_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+#endif
+
 // Dynamic encoders starts after dynamic keymaps
 #ifndef DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR
-#    define DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR (DYNAMIC_KEYMAP_EEPROM_ADDR + (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2))
+#    define DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR (DYNAMIC_KEYMAP_EEPROM_ADDR + DYNAMIC_KEYMAP_KEYMAP_EEPROM_SIZE)
 #endif
 
 // Dynamic macro starts after dynamic encoders, but only when using ENCODER_MAP
@@ -105,6 +130,272 @@ uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
 
+#ifdef DYNAMIC_KEYMAP_COMPRESSED
+
+#    define DYNAMIC_KEYMAP_KEY_COUNT (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS)
+#    define DYNAMIC_KEYMAP_ROW_MASK ((MATRIX_ROW_SHIFTER << (MATRIX_COLS - 1) << 1) - 1)
+
+// Number of keys handled at once by dynamic_keymap_set_buffer()
+#    define DYNAMIC_KEYMAP_BUFFER_KEYS 16
+
+// RAM copy of the bitmap, so that looking up a transparent key takes no
+// EEPROM reads, and any other key the same two as the uncompressed keymap
+static bool         keymap_index_loaded = false;
+static matrix_row_t keymap_stored[DYNAMIC_KEYMAP_LAYER_COUNT][MATRIX_ROWS];
+// Pool index of the first keycode of each row, and the number stored in the
+// layer after the last row, so a lookup only counts bits within its own row
+static uint16_t keymap_row_start[DYNAMIC_KEYMAP_LAYER_COUNT][MATRIX_ROWS + 1];
+
+static uint8_t row_popcount(matrix_row_t bits) {
+    uint8_t count = 0;
+    while (bits) {
+        bits &= bits - 1;
+        count++;
+    }
+    return count;
+}
+
+static uint16_t keymap_layer_capacity(uint8_t layer) {
+    return layer < DYNAMIC_KEYMAP_COMPRESSED_FULL_LAYERS ? MATRIX_ROWS * MATRIX_COLS : DYNAMIC_KEYMAP_COMPRESSED_LAYER_KEYCODE_COUNT;
+}
+
+static uintptr_t keymap_layer_address(uint8_t layer) {
+    if (layer < DYNAMIC_KEYMAP_COMPRESSED_FULL_LAYERS) {
+        return DYNAMIC_KEYMAP_EEPROM_ADDR + (layer * DYNAMIC_KEYMAP_FULL_LAYER_EEPROM_SIZE);
+    }
+    return DYNAMIC_KEYMAP_EEPROM_ADDR + (DYNAMIC_KEYMAP_COMPRESSED_FULL_LAYERS * DYNAMIC_KEYMAP_FULL_LAYER_EEPROM_SIZE) + ((layer - DYNAMIC_KEYMAP_COMPRESSED_FULL_LAYERS) * DYNAMIC_KEYMAP_SMALL_LAYER_EEPROM_SIZE);
+}
+
+static void *keymap_bitmap_address(uint8_t layer, uint8_t row) {
+    return (void *)(keymap_layer_address(layer) + (row * DYNAMIC_KEYMAP_ROW_SIZE));
+}
+
+static void *keymap_pool_address(uint8_t layer, uint16_t index) {
+    return (void *)(keymap_layer_address(layer) + DYNAMIC_KEYMAP_LAYER_BITMAP_SIZE + (index * 2));
+}
+
+static void *keymap_checksum_address(uint8_t layer) {
+    return keymap_pool_address(layer, keymap_layer_capacity(layer));
+}
+
+static uint16_t keymap_pool_read(uint8_t layer, uint16_t index) {
+    void *address = keymap_pool_address(layer, index);
+    // Big endian, same as the uncompressed keymap
+    uint16_t keycode = eeprom_read_byte(address) << 8;
+    keycode |= eeprom_read_byte(address + 1);
+    return keycode;
+}
+
+static void keymap_pool_write(uint8_t layer, uint16_t index, uint16_t keycode) {
+    void *address = keymap_pool_address(layer, index);
+    eeprom_update_byte(address, (uint8_t)(keycode >> 8));
+    eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+}
+
+static void keymap_write_bitmap_row(uint8_t layer, uint8_t row) {
+    uint8_t *    address = keymap_bitmap_address(layer, row);
+    matrix_row_t bits    = keymap_stored[layer][row];
+    for (uint8_t i = 0; i < DYNAMIC_KEYMAP_ROW_SIZE; i++) {
+        eeprom_update_byte(address + i, (uint8_t)(bits >> (i * 8)));
+    }
+}
+
+// Called whenever the bitmap of a layer changes
+static void keymap_update_row_starts(uint8_t layer) {
+    uint16_t count = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        keymap_row_start[layer][row] = count;
+        count += row_popcount(keymap_stored[layer][row]);
+    }
+    keymap_row_start[layer][MATRIX_ROWS] = count;
+}
+
+static uint16_t keymap_layer_used(uint8_t layer) {
+    return keymap_row_start[layer][MATRIX_ROWS];
+}
+
+// Fletcher-16 of the bitmap and the stored keycodes of a layer, seeded so that
+// a blank layer does not pass
+static uint16_t keymap_layer_checksum(uint8_t layer) {
+    uint16_t sum1  = 0x5A;
+    uint16_t sum2  = 0xA5;
+    uint16_t count = keymap_layer_used(layer);
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t i = 0; i < DYNAMIC_KEYMAP_ROW_SIZE; i++) {
+            sum1 = (sum1 + (uint8_t)(keymap_stored[layer][row] >> (i * 8))) % 255;
+            sum2 = (sum2 + sum1) % 255;
+        }
+    }
+    for (uint16_t index = 0; index < count; index++) {
+        uint16_t keycode = keymap_pool_read(layer, index);
+        sum1             = (sum1 + (keycode >> 8)) % 255;
+        sum2             = (sum2 + sum1) % 255;
+        sum1             = (sum1 + (keycode & 0xFF)) % 255;
+        sum2             = (sum2 + sum1) % 255;
+    }
+    return (sum2 << 8) | sum1;
+}
+
+// Written last, so that a layer left half written by a power loss is detected
+static void keymap_commit_layer(uint8_t layer) {
+    uint16_t checksum = keymap_layer_checksum(layer);
+    uint8_t *address  = keymap_checksum_address(layer);
+    eeprom_update_byte(address, (uint8_t)(checksum >> 8));
+    eeprom_update_byte(address + 1, (uint8_t)(checksum & 0xFF));
+}
+
+static bool keymap_layer_valid(uint8_t layer) {
+    if (keymap_layer_used(layer) > keymap_layer_capacity(layer)) {
+        return false;
+    }
+    uint8_t *address  = keymap_checksum_address(layer);
+    uint16_t checksum = eeprom_read_byte(address) << 8;
+    checksum |= eeprom_read_byte(address + 1);
+    return checksum == keymap_layer_checksum(layer);
+}
+
+static void keymap_reset_layer(uint8_t layer) {
+    uint16_t count = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        keymap_stored[layer][row] = 0;
+        for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+            uint16_t keycode = keycode_at_keymap_location_raw(layer, row, column);
+            // Keys which do not fit the layer are left transparent
+            if (keycode != KC_TRANSPARENT && count < keymap_layer_capacity(layer)) {
+                keymap_pool_write(layer, count++, keycode);
+                keymap_stored[layer][row] |= MATRIX_ROW_SHIFTER << column;
+            }
+        }
+        keymap_write_bitmap_row(layer, row);
+    }
+    keymap_update_row_starts(layer);
+    keymap_commit_layer(layer);
+}
+
+static void keymap_load_index(void) {
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            uint8_t *    address = keymap_bitmap_address(layer, row);
+            matrix_row_t bits    = 0;
+            for (uint8_t i = 0; i < DYNAMIC_KEYMAP_ROW_SIZE; i++) {
+                bits |= (matrix_row_t)eeprom_read_byte(address + i) << (i * 8);
+            }
+            keymap_stored[layer][row] = bits & DYNAMIC_KEYMAP_ROW_MASK;
+        }
+        keymap_update_row_starts(layer);
+
+        // Not a compressed layer, e.g. blank EEPROM, or one whose update was interrupted
+        if (!keymap_layer_valid(layer)) {
+            keymap_reset_layer(layer);
+        }
+    }
+    keymap_index_loaded = true;
+}
+
+void dynamic_keymap_reload(void) {
+    keymap_load_index();
+}
+
+static inline void keymap_ensure_index(void) {
+    if (!keymap_index_loaded) {
+        keymap_load_index();
+    }
+}
+
+// Pool index of the keycode of a key, or of the next stored key if it is transparent
+static uint16_t keymap_pool_index(uint8_t layer, uint8_t row, uint8_t column) {
+    return keymap_row_start[layer][row] + row_popcount(keymap_stored[layer][row] & ((MATRIX_ROW_SHIFTER << column) - 1));
+}
+
+static uint16_t keymap_get_key(uint16_t key) {
+    uint8_t layer  = key / (MATRIX_ROWS * MATRIX_COLS);
+    uint8_t row    = (key / MATRIX_COLS) % MATRIX_ROWS;
+    uint8_t column = key % MATRIX_COLS;
+
+    if (!(keymap_stored[layer][row] & (MATRIX_ROW_SHIFTER << column))) {
+        return KC_TRANSPARENT;
+    }
+    return keymap_pool_read(layer, keymap_pool_index(layer, row, column));
+}
+
+// Sets a run of consecutive keys within one layer, moving the keycodes after
+// them along the layer at most once. Returns false, changing nothing, if the
+// keycodes do not fit the layer.
+static bool keymap_set_keys(uint16_t first, uint8_t count, const uint16_t *keycodes) {
+    uint8_t  layer        = first / (MATRIX_ROWS * MATRIX_COLS);
+    uint8_t  row          = (first / MATRIX_COLS) % MATRIX_ROWS;
+    uint8_t  column       = first % MATRIX_COLS;
+    uint16_t start        = keymap_pool_index(layer, row, column);
+    uint16_t stored_count = keymap_layer_used(layer);
+    uint8_t  old_count    = 0;
+    uint8_t  new_count    = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        uint16_t key = first + i;
+        if (keymap_stored[layer][(key / MATRIX_COLS) % MATRIX_ROWS] & (MATRIX_ROW_SHIFTER << (key % MATRIX_COLS))) {
+            old_count++;
+        }
+        if (keycodes[i] != KC_TRANSPARENT) {
+            new_count++;
+        }
+    }
+
+    if (stored_count - old_count + new_count > keymap_layer_capacity(layer)) {
+        return false;
+    }
+
+    // Move the keycodes of the following keys to where they are going to be
+    if (new_count > old_count) {
+        for (uint16_t index = stored_count; index > start + old_count; index--) {
+            keymap_pool_write(layer, index - 1 + new_count - old_count, keymap_pool_read(layer, index - 1));
+        }
+    } else if (new_count < old_count) {
+        for (uint16_t index = start + old_count; index < stored_count; index++) {
+            keymap_pool_write(layer, index + new_count - old_count, keymap_pool_read(layer, index));
+        }
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (keycodes[i] != KC_TRANSPARENT) {
+            keymap_pool_write(layer, start++, keycodes[i]);
+            keymap_stored[layer][row] |= MATRIX_ROW_SHIFTER << column;
+        } else {
+            keymap_stored[layer][row] &= ~(MATRIX_ROW_SHIFTER << column);
+        }
+        if (++column == MATRIX_COLS || i == count - 1) {
+            keymap_write_bitmap_row(layer, row);
+            column = 0;
+            row++;
+        }
+    }
+
+    keymap_update_row_starts(layer);
+    keymap_commit_layer(layer);
+    return true;
+}
+
+uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+    if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+    keymap_ensure_index();
+    return keymap_get_key((layer * MATRIX_ROWS + row) * MATRIX_COLS + column);
+}
+
+bool dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
+    if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return true;
+    keymap_ensure_index();
+    return keymap_set_keys((layer * MATRIX_ROWS + row) * MATRIX_COLS + column, 1, &keycode);
+}
+
+static void dynamic_keymap_reset_keycodes(void) {
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        keymap_reset_layer(layer);
+    }
+    keymap_index_loaded = true;
+}
+
+#else // DYNAMIC_KEYMAP_COMPRESSED
+
 void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t column) {
     // TODO: optimize this with some left shifts
     return ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
@@ -119,14 +410,27 @@ uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column)
     return keycode;
 }
 
-void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
-    if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
+bool dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
+    if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return true;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    return true;
 }
 
+static void dynamic_keymap_reset_keycodes(void) {
+    for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        for (int row = 0; row < MATRIX_ROWS; row++) {
+            for (int column = 0; column < MATRIX_COLS; column++) {
+                dynamic_keymap_set_keycode(layer, row, column, keycode_at_keymap_location_raw(layer, row, column));
+            }
+        }
+    }
+}
+
+#endif // DYNAMIC_KEYMAP_COMPRESSED
+
 #ifdef ENCODER_MAP_ENABLE
 void *dynamic_keymap_encoder_to_eeprom_address(uint8_t layer, uint8_t encoder_id) {
     return ((void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR) + (layer * NUM_ENCODERS * 2 * 2) + (encoder_id * 2 * 2);
@@ -152,24 +456,71 @@ void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwis
 
 void dynamic_keymap_reset(void) {
     // Reset the keymaps in EEPROM to what is in flash.
-    for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
-        for (int row = 0; row < MATRIX_ROWS; row++) {
-            for (int column = 0; column < MATRIX_COLS; column++) {
-                dynamic_keymap_set_keycode(layer, row, column, keycode_at_keymap_location_raw(layer, row, column));
-            }
-        }
+    dynamic_keymap_reset_keycodes();
 #ifdef ENCODER_MAP_ENABLE
+    for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
         for (int encoder = 0; encoder < NUM_ENCODERS; encoder++) {
             dynamic_keymap_set_encoder(layer, encoder, true, keycode_at_encodermap_location_raw(layer, encoder, true));
             dynamic_keymap_set_encoder(layer, encoder, false, keycode_at_encodermap_location_raw(layer, encoder, false));
         }
+    }
 #endif // ENCODER_MAP_ENABLE
+}
+
+#ifdef DYNAMIC_KEYMAP_COMPRESSED
+
+void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    keymap_ensure_index();
+    for (uint16_t i = 0; i < size; i++) {
+        uint32_t position = (uint32_t)offset + i;
+        if (position < DYNAMIC_KEYMAP_KEY_COUNT * 2) {
+            uint16_t keycode = keymap_get_key(position / 2);
+            data[i]          = (position & 1) ? (uint8_t)(keycode & 0xFF) : (uint8_t)(keycode >> 8);
+        } else {
+            data[i] = 0x00;
+        }
+    }
+}
+
+bool dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    uint16_t keycodes[DYNAMIC_KEYMAP_BUFFER_KEYS];
+    uint32_t end      = (uint32_t)offset + size;
+    uint32_t position = offset;
+    bool     success  = true;
+
+    if (end > DYNAMIC_KEYMAP_KEY_COUNT * 2) {
+        end = DYNAMIC_KEYMAP_KEY_COUNT * 2;
+    }
+
+    keymap_ensure_index();
+    while (position < end) {
+        uint16_t first = position / 2;
+        uint8_t  count = 0;
+        // Keys partially covered by the buffer keep their other byte, and runs stop at the end of a layer
+        do {
+            uint16_t key     = first + count;
+            uint16_t keycode = keymap_get_key(key);
+            if ((uint32_t)key * 2 >= offset) {
+                keycode = (keycode & 0x00FF) | (data[key * 2 - offset] << 8);
+            }
+            if ((uint32_t)key * 2 + 1 < end) {
+                keycode = (keycode & 0xFF00) | data[key * 2 + 1 - offset];
+            }
+            keycodes[count++] = keycode;
+        } while (count < DYNAMIC_KEYMAP_BUFFER_KEYS && (uint32_t)(first + count) * 2 < end && (first + count) % (MATRIX_ROWS * MATRIX_COLS) != 0);
+        if (!keymap_set_keys(first, count, keycodes)) {
+            success = false;
+        }
+        position = (uint32_t)(first + count) * 2;
     }
+    return success;
 }
 
+#else // DYNAMIC_KEYMAP_COMPRESSED
+
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   source                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *target                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
@@ -182,9 +533,9 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     }
 }
 
-void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+bool dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   target                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *source                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
@@ -193,8 +544,11 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
         source++;
         target++;
     }
+    return true;
 }
 
+#endif // DYNAMIC_KEYMAP_COMPRESSED
+
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
     if (layer_num < DYNAMIC_KEYMAP_LAYER_COUNT && row < MATRIX_ROWS && column < MATRIX_COLS) {
         return dynamic_keymap_get_keycode(layer_num, row, column);
@@ -220,7 +574,7 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   source = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *target = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
@@ -234,7 +588,7 @@ void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *da
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   target = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *source = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
@@ -18,10 +18,28 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-uint8_t  dynamic_keymap_get_layer_count(void);
-void *   dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t column);
+uint8_t dynamic_keymap_get_layer_count(void);
+#ifndef DYNAMIC_KEYMAP_COMPRESSED
+void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t column);
+#else
+// With DYNAMIC_KEYMAP_COMPRESSED, only keys which are not KC_TRANSPARENT use up
+// EEPROM. The first DYNAMIC_KEYMAP_COMPRESSED_FULL_LAYERS layers have room for
+// every key, the others for DYNAMIC_KEYMAP_COMPRESSED_LAYER_KEYCODE_COUNT keys.
+// Once a layer is full, setting a transparent key to anything else fails.
+// Changing a key to or from KC_TRANSPARENT moves the keycodes of every later
+// key of its layer, and rewrites the checksum, which reads the whole layer.
+// On a full layer of N keys that is up to 2*N eeprom_update_byte() calls for
+// a single key, against 4 for any other change; prefer set_buffer for bulk
+// edits, which moves them at most once per run of keys.
+// Each layer is checksummed, and reset to the keymap in flash if it does not
+// match, e.g. when an update was interrupted by a power loss.
+// An index of the keymap is kept in RAM, and rebuilt on first use.
+// This rebuilds it, for when the EEPROM was changed behind the keymap's back.
+void dynamic_keymap_reload(void);
+#endif
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column);
-void     dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode);
+// Returns false if the keycode did not fit, see above
+bool     dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode);
 #ifdef ENCODER_MAP_ENABLE
 uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise);
 void     dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode);
@@ -32,11 +50,14 @@ void dynamic_keymap_reset(void);
 // Order is by layer/row/column
 // Thus offset 0 = 0,0,0, offset MATRIX_COLS*2 = 0,1,0, offset MATRIX_ROWS*MATRIX_COLS*2 = 1,0,0
 // Note the *2, because offset is in bytes and keycodes are two bytes
+// Compressed keymaps are presented the same way, uncompressed
 // This is only really useful for host applications that want to get a whole keymap fast,
 // by reading 14 keycodes (28 bytes) at a time, reducing the number of raw HID transfers by
 // a factor of 14.
+// Setting returns false if any of the keycodes did not fit, leaving the keys
+// of that run unchanged
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data);
-void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
+bool dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 
 // This overrides the one in quantum/keymap_common.c
 // uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
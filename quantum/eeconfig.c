@@ -3,6 +3,7 @@
 #include <stdbool.h>
 #include "eeprom.h"
 #include "eeconfig.h"
+#include "timer.h"
 
 #if defined(EEPROM_DRIVER)
 #    include "eeprom_driver.h"
@@ -44,6 +45,9 @@ __attribute__((weak)) void eeconfig_init_kb(void) {
  * FIXME: needs doc
  */
 void eeconfig_init_quantum(void) {
+    // Changes made before the reset must not be written over it
+    eeconfig_discard_all();
+
 #if defined(EEPROM_DRIVER)
     eeprom_driver_format(false);
 #endif
@@ -106,6 +110,7 @@ void eeconfig_enable(void) {
  * FIXME: needs doc
  */
 void eeconfig_disable(void) {
+    eeconfig_discard_all();
 #if defined(EEPROM_DRIVER)
     eeprom_driver_format(false);
 #endif
@@ -353,3 +358,80 @@ __attribute__((weak)) void eeconfig_init_user_datablock(void) {
     eeconfig_update_user_datablock(dummy_user);
 }
 #endif // (EECONFIG_USER_DATA_SIZE) > 0
+
+static eeconfig_section_t *dirty_sections = NULL;
+static uint32_t            last_change    = 0;
+
+static void eeconfig_write_section(eeconfig_section_t *section) {
+    eeprom_update_block(section->data, section->address, section->size);
+    if (section->post_flush) {
+        section->post_flush();
+    }
+}
+
+/** \brief eeconfig flag section
+ *
+ * Marks a section as changed, to be written by eeconfig_task() once there
+ * have been no changes for EECONFIG_FLUSH_TIMEOUT milliseconds.
+ */
+void eeconfig_flag_section(eeconfig_section_t *section) {
+    if (!section->dirty) {
+        section->dirty = true;
+        section->next  = dirty_sections;
+        dirty_sections = section;
+    }
+    last_change = timer_read32();
+}
+
+/** \brief eeconfig flush section
+ *
+ * Writes a section to EEPROM straight away, whether it was changed or not.
+ */
+void eeconfig_flush_section(eeconfig_section_t *section) {
+    if (section->dirty) {
+        eeconfig_section_t **link = &dirty_sections;
+        while (*link != section) {
+            link = &(*link)->next;
+        }
+        *link          = section->next;
+        section->dirty = false;
+    }
+    eeconfig_write_section(section);
+}
+
+/** \brief eeconfig flush all
+ *
+ * Writes all changed sections to EEPROM straight away.
+ */
+void eeconfig_flush_all(void) {
+    while (dirty_sections) {
+        eeconfig_section_t *section = dirty_sections;
+        dirty_sections              = section->next;
+        section->dirty              = false;
+        eeconfig_write_section(section);
+    }
+#if defined(EEPROM_DRIVER)
+    eeprom_driver_flush();
+#endif
+}
+
+/** \brief eeconfig discard all
+ *
+ * Forgets about changed sections without writing them.
+ */
+void eeconfig_discard_all(void) {
+    while (dirty_sections) {
+        dirty_sections->dirty = false;
+        dirty_sections        = dirty_sections->next;
+    }
+}
+
+/** \brief eeconfig task
+ *
+ * Writes all changed sections once things have been quiet for a while.
+ */
+void eeconfig_task(void) {
+    if (dirty_sections && timer_elapsed32(last_change) >= EECONFIG_FLUSH_TIMEOUT) {
+        eeconfig_flush_all();
+    }
+}
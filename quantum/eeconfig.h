@@ -166,27 +166,53 @@ void eeconfig_update_user_datablock(const void *data);
 void eeconfig_init_user_datablock(void);
 #endif // (EECONFIG_USER_DATA_SIZE) > 0
 
+#ifndef EECONFIG_FLUSH_TIMEOUT
+#    define EECONFIG_FLUSH_TIMEOUT 1000
+#endif
+
+// A section of eeconfig which is written to EEPROM some time after it was
+// changed. Every change restarts the wait, and once nothing has changed for
+// EECONFIG_FLUSH_TIMEOUT milliseconds eeconfig_task() writes all changed
+// sections together. They are also written before suspend and reset.
+typedef struct eeconfig_section_t {
+    void *                     data;    // in RAM
+    void *                     address; // in EEPROM
+    uint16_t                   size;
+    void (*post_flush)(void);           // optional, called after each write
+    struct eeconfig_section_t *next;    // next changed section
+    bool                       dirty;
+} eeconfig_section_t;
+
+void eeconfig_flag_section(eeconfig_section_t *section);
+void eeconfig_flush_section(eeconfig_section_t *section);
+void eeconfig_flush_all(void);
+void eeconfig_discard_all(void);
+void eeconfig_task(void);
+
 // Any "checked" debounce variant used requires implementation of:
 //    -- bool eeconfig_check_valid_##name(void)
 //    -- void eeconfig_post_flush_##name(void)
 #define EECONFIG_DEBOUNCE_HELPER_CHECKED(name, offset, config)          \
-    static uint8_t dirty_##name = false;                                \
-                                                                        \
     bool eeconfig_check_valid_##name(void);                             \
     void eeconfig_post_flush_##name(void);                              \
                                                                         \
+    static eeconfig_section_t eeconfig_section_##name = {               \
+        .data       = &config,                                          \
+        .address    = (void *)(offset),                                 \
+        .size       = sizeof(config),                                   \
+        .post_flush = eeconfig_post_flush_##name,                       \
+    };                                                                  \
+                                                                        \
     static inline void eeconfig_init_##name(void) {                     \
-        dirty_##name = true;                                            \
         if (eeconfig_check_valid_##name()) {                            \
             eeprom_read_block(&config, offset, sizeof(config));         \
-            dirty_##name = false;                                       \
+        } else {                                                        \
+            eeconfig_flag_section(&eeconfig_section_##name);            \
         }                                                               \
     }                                                                   \
     static inline void eeconfig_flush_##name(bool force) {              \
-        if (force || dirty_##name) {                                    \
-            eeprom_update_block(&config, offset, sizeof(config));       \
-            eeconfig_post_flush_##name();                               \
-            dirty_##name = false;                                       \
+        if (force || eeconfig_section_##name.dirty) {                   \
+            eeconfig_flush_section(&eeconfig_section_##name);           \
         }                                                               \
     }                                                                   \
     static inline void eeconfig_flush_##name##_task(uint16_t timeout) { \
@@ -197,7 +223,9 @@ void eeconfig_init_user_datablock(void);
         }                                                               \
     }                                                                   \
     static inline void eeconfig_flag_##name(bool v) {                   \
-        dirty_##name |= v;                                              \
+        if (v) {                                                        \
+            eeconfig_flag_section(&eeconfig_section_##name);            \
+        }                                                               \
     }                                                                   \
     static inline void eeconfig_write_##name(typeof(config) *conf) {    \
         if (memcmp(&config, conf, sizeof(config)) != 0) {               \
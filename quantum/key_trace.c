@@ -0,0 +1,143 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "key_trace.h"
+#include "action_layer.h"
+#include "action_util.h"
+#include "print.h"
+#include "timer.h"
+
+typedef struct {
+    uint8_t       mods;
+    uint8_t       oneshot_mods;
+    layer_state_t layer_state;
+    layer_state_t default_layer_state;
+} key_trace_state_t;
+
+// The records are kept in a byte ring, the oldest of them at key_trace_tail
+static uint8_t           key_trace_buffer[KEY_TRACE_BUFFER_SIZE];
+static uint16_t          key_trace_tail           = 0;
+static uint16_t          key_trace_used           = 0;
+static uint8_t           key_trace_flags          = 0;
+static bool              key_trace_paused         = false;
+static uint16_t          key_trace_read_time      = 0;
+static bool              key_trace_state_recorded = false;
+static key_trace_state_t key_trace_state;
+
+static uint8_t key_trace_record_size(uint8_t type) {
+    return type == KEY_TRACE_STATE ? KEY_TRACE_STATE_SIZE : KEY_TRACE_KEY_SIZE;
+}
+
+static void key_trace_push(const uint8_t *record, uint8_t size) {
+    while (KEY_TRACE_BUFFER_SIZE - key_trace_used < size) {
+        uint8_t type    = key_trace_buffer[key_trace_tail];
+        uint8_t dropped = key_trace_record_size(type);
+        key_trace_tail  = (key_trace_tail + dropped) % KEY_TRACE_BUFFER_SIZE;
+        key_trace_used -= dropped;
+        key_trace_flags |= KEY_TRACE_WRAPPED;
+        if (type == KEY_TRACE_STATE) {
+            // record the state again with the next key, so that the trace still has one
+            key_trace_state_recorded = false;
+        }
+    }
+
+    uint16_t head = (key_trace_tail + key_trace_used) % KEY_TRACE_BUFFER_SIZE;
+    for (uint8_t i = 0; i < size; i++) {
+        key_trace_buffer[head] = record[i];
+        head                   = (head + 1) % KEY_TRACE_BUFFER_SIZE;
+    }
+    key_trace_used += size;
+}
+
+static bool key_trace_state_equal(const key_trace_state_t *a, const key_trace_state_t *b) {
+    return a->mods == b->mods && a->oneshot_mods == b->oneshot_mods && a->layer_state == b->layer_state && a->default_layer_state == b->default_layer_state;
+}
+
+static void key_trace_write_32(uint8_t *data, uint32_t value) {
+    for (uint8_t i = 0; i < 4; i++) {
+        data[i] = value >> (i * 8);
+    }
+}
+
+void key_trace_record(keyevent_t event) {
+    if (key_trace_paused) {
+        // the host gave up reading the dump part way through
+        if (timer_elapsed(key_trace_read_time) < KEY_TRACE_READ_TIMEOUT) {
+            return;
+        }
+        key_trace_paused = false;
+    }
+
+    key_trace_state_t state = {
+        .mods         = get_mods(),
+        .oneshot_mods = get_oneshot_mods(),
+#ifndef NO_ACTION_LAYER
+        .layer_state = layer_state,
+#endif
+        .default_layer_state = default_layer_state,
+    };
+    if (!key_trace_state_recorded || !key_trace_state_equal(&state, &key_trace_state)) {
+        uint8_t record[KEY_TRACE_STATE_SIZE] = {KEY_TRACE_STATE, state.mods, state.oneshot_mods};
+        key_trace_write_32(&record[3], state.layer_state);
+        key_trace_write_32(&record[7], state.default_layer_state);
+        key_trace_push(record, sizeof(record));
+        key_trace_state          = state;
+        key_trace_state_recorded = true;
+    }
+
+    uint8_t record[KEY_TRACE_KEY_SIZE] = {
+        event.pressed ? KEY_TRACE_PRESS : KEY_TRACE_RELEASE, event.time & 0xFF, event.time >> 8, event.key.row, event.key.col,
+    };
+    key_trace_push(record, sizeof(record));
+}
+
+void key_trace_clear(void) {
+    key_trace_tail           = 0;
+    key_trace_used           = 0;
+    key_trace_flags          = 0;
+    key_trace_paused         = false;
+    key_trace_state_recorded = false;
+}
+
+uint16_t key_trace_get_size(void) {
+    return KEY_TRACE_HEADER_SIZE + key_trace_used;
+}
+
+void key_trace_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    const uint8_t header[KEY_TRACE_HEADER_SIZE] = {KEY_TRACE_MAGIC_0, KEY_TRACE_MAGIC_1, KEY_TRACE_VERSION, key_trace_flags, key_trace_used & 0xFF, key_trace_used >> 8};
+
+    if (offset == 0) {
+        key_trace_paused = true;
+    }
+    key_trace_read_time = timer_read();
+
+    for (uint16_t i = 0; i < size; i++) {
+        uint32_t position = (uint32_t)offset + i;
+        if (position < KEY_TRACE_HEADER_SIZE) {
+            data[i] = header[position];
+        } else if (position - KEY_TRACE_HEADER_SIZE < key_trace_used) {
+            data[i] = key_trace_buffer[(key_trace_tail + position - KEY_TRACE_HEADER_SIZE) % KEY_TRACE_BUFFER_SIZE];
+        } else {
+            data[i] = 0;
+        }
+    }
+
+    if ((uint32_t)offset + size >= key_trace_get_size()) {
+        key_trace_paused = false;
+    }
+}
+
+void key_trace_print(void) {
+    const uint16_t total = key_trace_get_size();
+    uint8_t        line[16];
+
+    for (uint16_t offset = 0; offset < total; offset += sizeof(line)) {
+        uint8_t size = total - offset < sizeof(line) ? total - offset : sizeof(line);
+        key_trace_get_buffer(offset, size, line);
+        uprintf("KT");
+        for (uint8_t i = 0; i < size; i++) {
+            uprintf(" %02X", line[i]);
+        }
+        uprintf("\n");
+    }
+}
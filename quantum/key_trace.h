@@ -0,0 +1,77 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "keyboard.h"
+
+#ifndef KEY_TRACE_BUFFER_SIZE
+#    define KEY_TRACE_BUFFER_SIZE 512
+#endif
+
+#ifndef KEY_TRACE_READ_TIMEOUT
+#    define KEY_TRACE_READ_TIMEOUT 1000
+#endif
+
+#if KEY_TRACE_BUFFER_SIZE < 32 || KEY_TRACE_BUFFER_SIZE > 32768
+#    error "KEY_TRACE_BUFFER_SIZE must be between 32 and 32768"
+#endif
+
+// A dump is a header followed by the records, oldest first. Multi-byte values are little endian.
+//
+// header = [ 'K', 'T', version, flags, size (2 bytes) ]
+//   size is the number of record bytes which follow the header
+// key    = [ KEY_TRACE_PRESS or KEY_TRACE_RELEASE, time (2 bytes), row, col ]
+//   time is the keyevent_t time, in milliseconds
+// state  = [ KEY_TRACE_STATE, mods, oneshot mods, layer_state (4 bytes), default_layer_state (4 bytes) ]
+//   the state when the key record which follows it was processed, only recorded when it changed
+#define KEY_TRACE_MAGIC_0 'K'
+#define KEY_TRACE_MAGIC_1 'T'
+#define KEY_TRACE_VERSION 1
+#define KEY_TRACE_HEADER_SIZE 6
+#define KEY_TRACE_KEY_SIZE 5
+#define KEY_TRACE_STATE_SIZE 11
+
+enum key_trace_record_type {
+    KEY_TRACE_PRESS   = 0x01,
+    KEY_TRACE_RELEASE = 0x02,
+    KEY_TRACE_STATE   = 0x03,
+};
+
+enum key_trace_flags {
+    // The buffer ran full and the oldest records were dropped
+    KEY_TRACE_WRAPPED = 0x01,
+};
+
+/**
+ * @brief Records a key event from the matrix, along with the current layers and mods if they changed.
+ */
+void key_trace_record(keyevent_t event);
+
+/**
+ * @brief Drops every record.
+ */
+void key_trace_clear(void);
+
+/**
+ * @brief Gets the size of the dump, header included.
+ */
+uint16_t key_trace_get_size(void);
+
+/**
+ * @brief Copies part of the dump.
+ *
+ * Recording stops when the dump is read from the start, and carries on once
+ * its end has been read, so that a dump read in parts stays consistent. If
+ * the end is never read, recording carries on KEY_TRACE_READ_TIMEOUT
+ * milliseconds after the last read.
+ * Bytes past the end read as zero.
+ */
+void key_trace_get_buffer(uint16_t offset, uint16_t size, uint8_t *data);
+
+/**
+ * @brief Prints the dump to the console, in lines of hex bytes starting with `KT`.
+ */
+void key_trace_print(void);
@@ -143,6 +143,18 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef LAYER_LOCK_ENABLE
 #    include "layer_lock.h"
 #endif
+#ifdef WEAR_LEVELING_ENABLE
+#    include "wear_leveling.h"
+#endif
+#ifdef MATRIX_IDLE_TIMEOUT
+#    include "matrix_idle.h"
+#endif
+#ifdef KEYEVENT_QUEUE_ENABLE
+#    include "keyevent_queue.h"
+#endif
+#ifdef KEY_TRACE_ENABLE
+#    include "key_trace.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -492,6 +504,9 @@ void keyboard_init(void) {
 #if defined(DEBUG_MATRIX_SCAN_RATE) && defined(CONSOLE_ENABLE)
     debug_enable = true;
 #endif
+#ifdef KEYEVENT_QUEUE_SCAN_THREAD
+    keyevent_queue_scan_thread_init();
+#endif
 
     keyboard_post_init_kb(); /* Always keep this last */
 }
@@ -523,6 +538,164 @@ static inline void generate_tick_event(void) {
     }
 }
 
+#ifdef KEYEVENT_QUEUE_ENABLE
+static matrix_row_t matrix_previous[MATRIX_ROWS];
+
+#    ifndef KEYEVENT_QUEUE_SCAN_THREAD
+/**
+ * @brief Scans the matrix and checks it against the keys already queued.
+ *
+ * @return true Matrix has changes to queue
+ * @return false Matrix didn't change
+ */
+static bool matrix_scan_changed(void) {
+    matrix_scan();
+    bool matrix_changed = false;
+    for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
+        matrix_changed |= matrix_previous[row] ^ matrix_get_row(row);
+    }
+
+    matrix_scan_perf_task();
+
+    if (matrix_changed && debug_config.matrix) {
+        matrix_print();
+    }
+    return matrix_changed;
+}
+#    endif
+
+/**
+ * @brief Queues an event for every key that changed since it was last queued.
+ *
+ * Keys that do not fit stay changed, so they are queued by a later call.
+ *
+ * @return true if every change was queued
+ */
+static bool matrix_queue_changes(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        const matrix_row_t current_row = matrix_get_row(row);
+        const matrix_row_t row_changes = current_row ^ matrix_previous[row];
+
+        if (!row_changes || has_ghost_in_row(row, current_row)) {
+            continue;
+        }
+
+        matrix_row_t col_mask = 1;
+        for (uint8_t col = 0; col < MATRIX_COLS; col++, col_mask <<= 1) {
+            if (row_changes & col_mask) {
+                if (!keyevent_queue_push(MAKE_KEYEVENT(row, col, current_row & col_mask))) {
+                    return false;
+                }
+                matrix_previous[row] ^= col_mask;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Processes every queued key event.
+ *
+ * @return true if any event was processed
+ */
+static bool keyevent_queue_task(void) {
+    const bool process_keypress = should_process_keypress();
+    bool       processed        = false;
+    keyevent_t event;
+
+    while (keyevent_queue_pop(&event)) {
+        if (process_keypress) {
+#    ifdef KEY_TRACE_ENABLE
+            key_trace_record(event);
+#    endif
+            action_exec(event);
+        }
+
+        switch_events(event.key.row, event.key.col, event.pressed);
+        processed = true;
+    }
+    return processed;
+}
+
+#    ifdef KEYEVENT_QUEUE_SCAN_THREAD
+/**
+ * @brief Scans the matrix and queues the changes, from the scan thread.
+ *
+ * Only reads and debounces the matrix: matrix_scan() leaves matrix_scan_kb()
+ * to matrix_task(), so keyboard and user code never runs on the scan thread.
+ */
+void keyevent_queue_scan(void) {
+    if (!matrix_can_read()) {
+        return;
+    }
+
+    matrix_scan();
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix_previous[row] ^ matrix_get_row(row)) {
+            matrix_queue_changes();
+            return;
+        }
+    }
+}
+
+/**
+ * @brief This task processes the key presses queued by the scan thread.
+ *
+ * @return true Matrix did change
+ * @return false Matrix didn't change
+ */
+static bool matrix_task(void) {
+    matrix_scan_kb();
+    matrix_scan_perf_task();
+
+    if (!keyevent_queue_task()) {
+        generate_tick_event();
+        return false;
+    }
+
+    if (debug_config.matrix) {
+        matrix_print();
+    }
+    return true;
+}
+#    else
+/**
+ * @brief This task scans the keyboards matrix, queues any key presses that
+ * occur and processes them.
+ *
+ * @return true Matrix did change
+ * @return false Matrix didn't change
+ */
+static bool matrix_task(void) {
+    if (!matrix_can_read()) {
+        generate_tick_event();
+        return false;
+    }
+
+#        ifdef MATRIX_IDLE_TIMEOUT
+    if (!matrix_idle_task()) {
+        generate_tick_event();
+        return false;
+    }
+#        endif
+
+    // Short-circuit the complete matrix processing if it is not necessary
+    if (!matrix_scan_changed()) {
+        generate_tick_event();
+        return false;
+    }
+
+    // Process every change, emptying the queue whenever it fills up
+    bool queued;
+    do {
+        queued = matrix_queue_changes();
+        keyevent_queue_task();
+    } while (!queued);
+
+    return true;
+}
+#    endif
+#else
 /**
  * @brief This task scans the keyboards matrix and processes any key presses
  * that occur.
@@ -536,6 +709,13 @@ static bool matrix_task(void) {
         return false;
     }
 
+#ifdef MATRIX_IDLE_TIMEOUT
+    if (!matrix_idle_task()) {
+        generate_tick_event();
+        return false;
+    }
+#endif
+
     static matrix_row_t matrix_previous[MATRIX_ROWS];
 
     matrix_scan();
@@ -572,7 +752,11 @@ static bool matrix_task(void) {
                 const bool key_pressed = current_row & col_mask;
 
                 if (process_keypress) {
-                    action_exec(MAKE_KEYEVENT(row, col, key_pressed));
+                    const keyevent_t event = MAKE_KEYEVENT(row, col, key_pressed);
+#ifdef KEY_TRACE_ENABLE
+                    key_trace_record(event);
+#endif
+                    action_exec(event);
                 }
 
                 switch_events(row, col, key_pressed);
@@ -584,6 +768,7 @@ static bool matrix_task(void) {
 
     return matrix_changed;
 }
+#endif
 
 /** \brief Tasks previously located in matrix_scan_quantum
  *
@@ -738,6 +923,20 @@ void keyboard_task(void) {
     midi_task();
 #endif
 
+#ifdef UNICODE_COMMON_ENABLE
+    unicode_task();
+#endif
+
+    eeconfig_task();
+
+#ifdef EEPROM_DRIVER
+    eeprom_driver_task();
+#endif
+
+#ifdef WEAR_LEVELING_ENABLE
+    wear_leveling_task(last_input_activity_elapsed() >= WEAR_LEVELING_IDLE_TIMEOUT);
+#endif
+
 #ifdef JOYSTICK_ENABLE
     joystick_task();
 #endif
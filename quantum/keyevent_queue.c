@@ -0,0 +1,70 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyevent_queue.h"
+
+#ifdef KEYEVENT_QUEUE_SCAN_THREAD
+#    ifndef PROTOCOL_CHIBIOS
+#        error "KEYEVENT_QUEUE_SCAN_THREAD is only supported on ChibiOS"
+#    endif
+#    ifdef SPLIT_KEYBOARD
+#        error "KEYEVENT_QUEUE_SCAN_THREAD is not supported on split keyboards"
+#    endif
+#    ifdef MATRIX_IDLE_TIMEOUT
+#        error "KEYEVENT_QUEUE_SCAN_THREAD cannot be used with MATRIX_IDLE_TIMEOUT"
+#    endif
+#    include <ch.h>
+#endif
+
+#define KEYEVENT_QUEUE_MASK (KEYEVENT_QUEUE_SIZE - 1)
+
+// Single producer, single consumer: head is only written by push, tail only by pop
+static keyevent_t keyevent_queue[KEYEVENT_QUEUE_SIZE];
+static uint8_t    keyevent_queue_head = 0;
+static uint8_t    keyevent_queue_tail = 0;
+
+bool keyevent_queue_push(keyevent_t event) {
+    uint8_t head = keyevent_queue_head;
+    uint8_t next = (head + 1) & KEYEVENT_QUEUE_MASK;
+    if (next == __atomic_load_n(&keyevent_queue_tail, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+
+    keyevent_queue[head] = event;
+    __atomic_store_n(&keyevent_queue_head, next, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool keyevent_queue_pop(keyevent_t *event) {
+    uint8_t tail = keyevent_queue_tail;
+    if (tail == __atomic_load_n(&keyevent_queue_head, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+
+    *event = keyevent_queue[tail];
+    __atomic_store_n(&keyevent_queue_tail, (tail + 1) & KEYEVENT_QUEUE_MASK, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool keyevent_queue_is_empty(void) {
+    return __atomic_load_n(&keyevent_queue_tail, __ATOMIC_ACQUIRE) == __atomic_load_n(&keyevent_queue_head, __ATOMIC_ACQUIRE);
+}
+
+#ifdef KEYEVENT_QUEUE_SCAN_THREAD
+static THD_WORKING_AREA(waScanThread, 512);
+static THD_FUNCTION(ScanThread, arg) {
+    (void)arg;
+    chRegSetThreadName("matrix_scan");
+
+    systime_t time = chVTGetSystemTimeX();
+    while (true) {
+        // Fixed rate, independent of how long the previous scan took
+        time = chThdSleepUntilWindowed(time, chTimeAddX(time, TIME_MS2I(KEYEVENT_QUEUE_SCAN_INTERVAL)));
+        keyevent_queue_scan();
+    }
+}
+
+void keyevent_queue_scan_thread_init(void) {
+    chThdCreateStatic(waScanThread, sizeof(waScanThread), HIGHPRIO, ScanThread, NULL);
+}
+#endif
@@ -0,0 +1,55 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "keyboard.h"
+
+#ifndef KEYEVENT_QUEUE_SIZE
+#    define KEYEVENT_QUEUE_SIZE 16
+#endif
+
+#if KEYEVENT_QUEUE_SIZE < 2 || KEYEVENT_QUEUE_SIZE > 128 || (KEYEVENT_QUEUE_SIZE & (KEYEVENT_QUEUE_SIZE - 1)) != 0
+#    error "KEYEVENT_QUEUE_SIZE must be a power of two between 2 and 128"
+#endif
+
+#ifndef KEYEVENT_QUEUE_SCAN_INTERVAL
+#    define KEYEVENT_QUEUE_SCAN_INTERVAL 1
+#endif
+
+/**
+ * @brief Adds an event to the back of the queue.
+ *
+ * Only one context may push, and only one other context may pop.
+ *
+ * @param event[in] the event to queue
+ * @return true if the event was queued, false if the queue is full
+ */
+bool keyevent_queue_push(keyevent_t event);
+
+/**
+ * @brief Takes the event at the front of the queue.
+ *
+ * @param event[out] the event taken
+ * @return true if an event was taken, false if the queue is empty
+ */
+bool keyevent_queue_pop(keyevent_t *event);
+
+/**
+ * @brief Checks whether there are no events waiting in the queue.
+ */
+bool keyevent_queue_is_empty(void);
+
+#ifdef KEYEVENT_QUEUE_SCAN_THREAD
+/**
+ * @brief Starts scanning the matrix on its own thread, every KEYEVENT_QUEUE_SCAN_INTERVAL milliseconds.
+ */
+void keyevent_queue_scan_thread_init(void);
+
+/**
+ * @brief Scans the matrix and queues the changes, implemented by keyboard.c.
+ */
+void keyevent_queue_scan(void);
+#endif
@@ -21,6 +21,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "matrix.h"
 #include "debounce.h"
 #include "atomic_util.h"
+#ifdef MATRIX_IDLE_TIMEOUT
+#    include "matrix_idle.h"
+#endif
 
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
@@ -104,6 +107,87 @@ static inline uint8_t readMatrixPin(pin_t pin) {
     }
 }
 
+#if !defined(DIRECT_PINS) && defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS)
+#    if (DIODE_DIRECTION == COL2ROW)
+#        define MATRIX_INPUT_PINS col_pins
+#        define MATRIX_INPUT_COUNT MATRIX_COLS
+#    else
+#        define MATRIX_INPUT_PINS row_pins
+#        define MATRIX_INPUT_COUNT ROWS_PER_HAND
+#    endif
+#endif
+
+#ifdef MATRIX_READ_BY_PORT
+#    ifndef gpio_read_port
+#        error "MATRIX_READ_BY_PORT is not supported on this platform"
+#    endif
+#    ifndef MATRIX_INPUT_PINS
+#        error "MATRIX_READ_BY_PORT requires MATRIX_ROW_PINS and MATRIX_COL_PINS"
+#    endif
+#    define MATRIX_PORT_RUN_MAX 16
+
+// A run of input pins that are adjacent in the matrix and on adjacent pads of the same port
+typedef struct {
+    uint8_t port;  // index into matrix_input_ports
+    uint8_t first; // index of the first input pin
+    uint8_t pad;   // pad of the first input pin
+    uint8_t count;
+} matrix_port_run_t;
+
+static gpio_port_t       matrix_input_ports[MATRIX_INPUT_COUNT];
+static uint8_t           matrix_input_port_count = 0;
+static matrix_port_run_t matrix_port_runs[MATRIX_INPUT_COUNT];
+static uint8_t           matrix_port_run_count = 0;
+
+/* Groups the input pins by port, so that a scan reads each port only once */
+static void matrix_init_input_ports(void) {
+    matrix_input_port_count = 0;
+    matrix_port_run_count   = 0;
+
+    for (uint8_t index = 0; index < MATRIX_INPUT_COUNT; index++) {
+        pin_t pin = MATRIX_INPUT_PINS[index];
+        if (pin == NO_PIN) {
+            continue;
+        }
+        gpio_port_t port = gpio_pin_port(pin);
+        uint8_t     pad  = gpio_pin_pad(pin);
+
+        if (matrix_port_run_count > 0) {
+            matrix_port_run_t *run = &matrix_port_runs[matrix_port_run_count - 1];
+            if (matrix_input_ports[run->port] == port && run->first + run->count == index && run->pad + run->count == pad && run->count < MATRIX_PORT_RUN_MAX) {
+                run->count++;
+                continue;
+            }
+        }
+
+        uint8_t port_index = 0;
+        while (port_index < matrix_input_port_count && matrix_input_ports[port_index] != port) {
+            port_index++;
+        }
+        if (port_index == matrix_input_port_count) {
+            matrix_input_ports[matrix_input_port_count++] = port;
+        }
+
+        matrix_port_runs[matrix_port_run_count++] = (matrix_port_run_t){.port = port_index, .first = index, .pad = pad, .count = 1};
+    }
+}
+
+static inline void matrix_read_input_ports(gpio_port_data_t port_values[]) {
+    for (uint8_t i = 0; i < matrix_input_port_count; i++) {
+        port_values[i] = gpio_read_port(matrix_input_ports[i]);
+    }
+}
+
+/* Returns the pressed state of the pins of a run, with the first pin in bit 0 */
+static inline uint32_t matrix_port_run_pressed(const matrix_port_run_t *run, const gpio_port_data_t port_values[]) {
+    uint32_t bits = (uint32_t)(port_values[run->port] >> run->pad);
+#    if MATRIX_INPUT_PRESSED_STATE == 0
+    bits = ~bits;
+#    endif
+    return bits & ((1UL << run->count) - 1);
+}
+#endif // MATRIX_READ_BY_PORT
+
 // matrix code
 
 #ifdef DIRECT_PINS
@@ -181,6 +265,14 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_READ_BY_PORT
+    // Read each port once, then populate the matrix row from each run of col pins
+    gpio_port_data_t port_values[MATRIX_INPUT_COUNT];
+    matrix_read_input_ports(port_values);
+    for (uint8_t i = 0; i < matrix_port_run_count; i++) {
+        current_row_value |= (matrix_row_t)matrix_port_run_pressed(&matrix_port_runs[i], port_values) << matrix_port_runs[i].first;
+    }
+#            else
     // For each col...
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
     for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
@@ -189,6 +281,7 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
         // Populate the matrix row with the state of the col pin
         current_row_value |= pin_state ? 0 : row_shifter;
     }
+#            endif
 
     // Unselect row
     unselect_row(current_row);
@@ -244,6 +337,23 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_READ_BY_PORT
+    // Read each port once, then update the col bit of each row in each run of row pins
+    gpio_port_data_t port_values[MATRIX_INPUT_COUNT];
+    matrix_read_input_ports(port_values);
+    for (uint8_t i = 0; i < matrix_port_run_count; i++) {
+        const matrix_port_run_t *run     = &matrix_port_runs[i];
+        uint32_t                 pressed = matrix_port_run_pressed(run, port_values);
+        for (uint8_t row_index = run->first; row_index < run->first + run->count; row_index++, pressed >>= 1) {
+            if (pressed & 1) {
+                current_matrix[row_index] |= row_shifter;
+                key_pressed = true;
+            } else {
+                current_matrix[row_index] &= ~row_shifter;
+            }
+        }
+    }
+#            else
     // For each row...
     for (uint8_t row_index = 0; row_index < ROWS_PER_HAND; row_index++) {
         // Check row pin state
@@ -256,6 +366,7 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
             current_matrix[row_index] &= ~row_shifter;
         }
     }
+#            endif
 
     // Unselect col
     unselect_col(current_col);
@@ -270,6 +381,170 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
 #    error DIODE_DIRECTION is not defined!
 #endif
 
+#if defined(MATRIX_IDLE_TIMEOUT) || defined(MATRIX_SPARSE_SCAN)
+#    ifdef MATRIX_INPUT_PINS
+#        if (DIODE_DIRECTION == COL2ROW)
+#            define MATRIX_OUTPUT_COUNT ROWS_PER_HAND
+#            define matrix_select_output(index) select_row(index)
+#            define matrix_unselect_outputs() unselect_rows()
+#        else
+#            define MATRIX_OUTPUT_COUNT MATRIX_COLS
+#            define matrix_select_output(index) select_col(index)
+#            define matrix_unselect_outputs() unselect_cols()
+#        endif
+
+// Select every output so that any key pulls its input
+static void matrix_select_outputs(void) {
+    for (uint8_t i = 0; i < MATRIX_OUTPUT_COUNT; i++) {
+        matrix_select_output(i);
+    }
+    matrix_output_select_delay();
+}
+
+static bool matrix_read_any_input(void) {
+    for (uint8_t i = 0; i < MATRIX_INPUT_COUNT; i++) {
+        if (readMatrixPin(MATRIX_INPUT_PINS[i]) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+#    endif // MATRIX_INPUT_PINS
+#endif
+
+#ifdef MATRIX_SPARSE_SCAN
+#    ifndef MATRIX_INPUT_PINS
+#        error "MATRIX_SPARSE_SCAN requires MATRIX_ROW_PINS and MATRIX_COL_PINS"
+#    endif
+#    ifndef MATRIX_SPARSE_SCAN_INTERVAL
+#        define MATRIX_SPARSE_SCAN_INTERVAL 64
+#    endif
+
+static uint16_t matrix_sparse_scan_count = 0;
+
+/**
+ * @brief Checks whether the full scan can be skipped as no key is down
+ *
+ * With nothing held, a single read with every output selected finds any new press. Every
+ * MATRIX_SPARSE_SCAN_INTERVAL scans a full scan is done regardless.
+ *
+ * @return true if the matrix is known to be empty
+ */
+static bool matrix_sparse_scan_skip(void) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (raw_matrix[row]) {
+            return false;
+        }
+    }
+    if (++matrix_sparse_scan_count >= MATRIX_SPARSE_SCAN_INTERVAL) {
+        matrix_sparse_scan_count = 0;
+        return false;
+    }
+
+    matrix_select_outputs();
+    bool key_pressed = matrix_read_any_input();
+    matrix_unselect_outputs();
+    matrix_output_unselect_delay(0, key_pressed); // wait for all input signals to go HIGH
+    return !key_pressed;
+}
+#endif // MATRIX_SPARSE_SCAN
+
+#if defined(MATRIX_IDLE_TIMEOUT) && defined(MATRIX_INPUT_PINS)
+#    if defined(PAL_USE_CALLBACKS) && (PAL_USE_CALLBACKS == TRUE)
+// Pins other features arm line events on
+static const pin_t matrix_idle_feature_pins[] = {
+#        ifdef POINTING_DEVICE_MOTION_PIN
+    POINTING_DEVICE_MOTION_PIN,
+#        endif
+#        ifdef PS2_CLOCK_PIN
+    PS2_CLOCK_PIN,
+#        endif
+    NO_PIN,
+};
+#        ifdef MATRIX_IDLE_RESERVED_PINS
+static const pin_t matrix_idle_reserved_pins[] = MATRIX_IDLE_RESERVED_PINS;
+#        endif
+
+static bool matrix_idle_pin_event[MATRIX_INPUT_COUNT];
+
+static bool matrix_idle_pad_in_use(pin_t pin, const pin_t *pins, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (pins[i] != NO_PIN && pins[i] != pin && gpio_pin_pad(pins[i]) == gpio_pin_pad(pin)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Picks the inputs which get a line event while idle
+ *
+ * On STM32 all ports share one EXTI line per pad number, so arming or disarming an input would
+ * take the line from any other pin on the same pad. Such inputs are left to polling.
+ */
+static void matrix_idle_init_pin_events(void) {
+    for (uint8_t i = 0; i < MATRIX_INPUT_COUNT; i++) {
+        pin_t pin                = MATRIX_INPUT_PINS[i];
+        matrix_idle_pin_event[i] = pin != NO_PIN && !matrix_idle_pad_in_use(pin, MATRIX_INPUT_PINS, MATRIX_INPUT_COUNT) && !matrix_idle_pad_in_use(pin, matrix_idle_feature_pins, ARRAY_SIZE(matrix_idle_feature_pins));
+#        ifdef MATRIX_IDLE_RESERVED_PINS
+        matrix_idle_pin_event[i] = matrix_idle_pin_event[i] && !matrix_idle_pad_in_use(pin, matrix_idle_reserved_pins, ARRAY_SIZE(matrix_idle_reserved_pins));
+#        endif
+    }
+}
+
+static void matrix_idle_pin_callback(void *arg) {
+    matrix_idle_wakeup();
+}
+
+// Arm an edge event on each input that has a line to itself, so a press wakes the MCU before the next tick
+static void matrix_idle_set_pin_events(bool enable) {
+    for (uint8_t i = 0; i < MATRIX_INPUT_COUNT; i++) {
+        pin_t pin = MATRIX_INPUT_PINS[i];
+        if (!matrix_idle_pin_event[i]) {
+            continue;
+        }
+        if (enable) {
+#        if MATRIX_INPUT_PRESSED_STATE == 0
+            palEnableLineEvent(pin, PAL_EVENT_MODE_FALLING_EDGE);
+#        else
+            palEnableLineEvent(pin, PAL_EVENT_MODE_RISING_EDGE);
+#        endif
+            palSetLineCallback(pin, matrix_idle_pin_callback, NULL);
+        } else {
+            palDisableLineEvent(pin);
+        }
+    }
+}
+#    else
+static inline void matrix_idle_init_pin_events(void) {}
+// Nothing to arm, a press is found by polling the inputs on the next tick
+static inline void matrix_idle_set_pin_events(bool enable) {}
+#    endif
+
+bool matrix_idle_enter(void) {
+    // Only go idle with nothing held and no release still being debounced
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (raw_matrix[row] || matrix[row]) {
+            return false;
+        }
+    }
+
+    matrix_select_outputs();
+    matrix_idle_set_pin_events(true);
+    return true;
+}
+
+void matrix_idle_exit(void) {
+    matrix_idle_set_pin_events(false);
+    matrix_unselect_outputs();
+    matrix_output_unselect_delay(0, true); // wait for all input signals to go HIGH
+}
+
+bool matrix_idle_input_active(void) {
+    return matrix_read_any_input();
+}
+#endif // MATRIX_IDLE_TIMEOUT
+
 void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
     // Set pinout for right half if pinout for that half is defined
@@ -302,6 +577,12 @@ void matrix_init(void) {
 
     // initialize key pins
     matrix_init_pins();
+#ifdef MATRIX_READ_BY_PORT
+    matrix_init_input_ports();
+#endif
+#if defined(MATRIX_IDLE_TIMEOUT) && defined(MATRIX_INPUT_PINS)
+    matrix_idle_init_pin_events();
+#endif
 
     // initialize matrix state: all keys off
     memset(matrix, 0, sizeof(matrix));
@@ -323,18 +604,26 @@ __attribute__((weak)) bool transport_master_if_connected(matrix_row_t master_mat
 uint8_t matrix_scan(void) {
     matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
 
+#ifdef MATRIX_SPARSE_SCAN
+    bool scan = !matrix_sparse_scan_skip();
+#else
+    const bool scan = true;
+#endif
+
+    if (scan) {
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
-    // Set row, read cols
-    for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
-        matrix_read_cols_on_row(curr_matrix, current_row);
-    }
+        // Set row, read cols
+        for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
+            matrix_read_cols_on_row(curr_matrix, current_row);
+        }
 #elif (DIODE_DIRECTION == ROW2COL)
-    // Set col, read rows
-    matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
-    for (uint8_t current_col = 0; current_col < MATRIX_COLS; current_col++, row_shifter <<= 1) {
-        matrix_read_rows_on_col(curr_matrix, current_col, row_shifter);
-    }
+        // Set col, read rows
+        matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
+        for (uint8_t current_col = 0; current_col < MATRIX_COLS; current_col++, row_shifter <<= 1) {
+            matrix_read_rows_on_col(curr_matrix, current_col, row_shifter);
+        }
 #endif
+    }
 
     bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
@@ -343,7 +632,10 @@ uint8_t matrix_scan(void) {
     changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
 #else
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
+#    ifndef KEYEVENT_QUEUE_SCAN_THREAD
+    // Called by matrix_task() on the main loop instead
     matrix_scan_kb();
+#    endif
 #endif
     return (uint8_t)changed;
 }
@@ -0,0 +1,30 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 5
+#define MATRIX_COLS 10
+
+/* The pins are spread over three ports, with runs of adjacent pads, reversed pads and an unused column. */
+#define MATRIX_ROW_PINS \
+    { MOCK_PIN(1, 0), MOCK_PIN(1, 1), MOCK_PIN(2, 0), MOCK_PIN(2, 1), MOCK_PIN(0, 12) }
+#define MATRIX_COL_PINS \
+    { MOCK_PIN(0, 0), MOCK_PIN(0, 1), MOCK_PIN(0, 2), MOCK_PIN(1, 7), MOCK_PIN(1, 6), MOCK_PIN(2, 3), NO_PIN, MOCK_PIN(0, 5), MOCK_PIN(0, 6), MOCK_PIN(2, 4) }
+
+#ifdef MATRIX_IDLE_TIMEOUT
+/* Pins sharing a pad with an input, whose line events belong to something else */
+#    define POINTING_DEVICE_MOTION_PIN MOCK_PIN(3, 2)
+#    define MATRIX_IDLE_RESERVED_PINS \
+        { MOCK_PIN(3, 4) }
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mock.h"
+
+#ifdef __cplusplus
+};
+#endif
@@ -0,0 +1,393 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <stdint.h>
+
+extern "C" {
+#include "matrix.h"
+#include "matrix/tests/mock.h"
+#ifdef MATRIX_IDLE_TIMEOUT
+#    include "matrix_idle.h"
+#endif
+
+extern matrix_row_t matrix[MATRIX_ROWS];
+}
+
+/* Column 6 has no pin, so none of its keys can be seen */
+#define MATRIX_NO_PIN_COL 6
+
+/* Pin reads of a full scan, as each of the outputs with a pin reads each of the inputs with one */
+#define MATRIX_FULL_SCAN_READS (MATRIX_ROWS * (MATRIX_COLS - 1))
+
+class MatrixTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        mock_reset();
+        std::fill(std::begin(pressed), std::end(pressed), 0);
+        matrix_init();
+    }
+
+    void set_key(uint8_t row, uint8_t col, bool down) {
+        mock_set_key(row, col, down);
+        if (down) {
+            pressed[row] |= (matrix_row_t)1 << col;
+        } else {
+            pressed[row] &= ~((matrix_row_t)1 << col);
+        }
+    }
+
+    void release_all() {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                set_key(row, col, false);
+            }
+        }
+    }
+
+    void expect_pressed_keys() {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            EXPECT_EQ(matrix[row], pressed[row] & ~((matrix_row_t)1 << MATRIX_NO_PIN_COL)) << "row " << (int)row;
+        }
+    }
+
+    matrix_row_t pressed[MATRIX_ROWS];
+};
+
+TEST_F(MatrixTest, NothingPressed) {
+    matrix_scan();
+    expect_pressed_keys();
+}
+
+TEST_F(MatrixTest, EachKeyOnItsOwn) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            set_key(row, col, true);
+            matrix_scan();
+            expect_pressed_keys();
+
+            set_key(row, col, false);
+            matrix_scan();
+            expect_pressed_keys();
+        }
+    }
+}
+
+TEST_F(MatrixTest, RandomPatterns) {
+    uint32_t seed = 12345;
+    for (int i = 0; i < 2000; i++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                seed = seed * 1103515245 + 12345;
+                set_key(row, col, (seed >> 16) % 8 == 0);
+            }
+        }
+        matrix_scan();
+        expect_pressed_keys();
+    }
+}
+
+TEST_F(MatrixTest, ReadsPerScan) {
+    set_key(0, 0, true);
+    matrix_scan();
+
+    mock_pin_reads  = 0;
+    mock_port_reads = 0;
+    matrix_scan();
+    expect_pressed_keys();
+
+    // Each output with a pin is selected in turn, and 3 ports hold the inputs
+#ifdef MATRIX_READ_BY_PORT
+    EXPECT_EQ(mock_pin_reads, 0);
+#    if (DIODE_DIRECTION == COL2ROW)
+    EXPECT_EQ(mock_port_reads, MATRIX_ROWS * 3);
+#    else
+    EXPECT_EQ(mock_port_reads, (MATRIX_COLS - 1) * 3);
+#    endif
+#else
+    EXPECT_EQ(mock_port_reads, 0);
+    EXPECT_EQ(mock_pin_reads, MATRIX_FULL_SCAN_READS);
+#endif
+}
+
+TEST_F(MatrixTest, ScanBenchmark) {
+    // A few keys held, as while typing
+    set_key(0, 1, true);
+    set_key(2, 4, true);
+    set_key(4, 8, true);
+
+    const uint32_t scans = 2000;
+    mock_pin_reads       = 0;
+    mock_port_reads      = 0;
+    for (uint32_t i = 0; i < scans; i++) {
+        matrix_scan();
+    }
+    expect_pressed_keys();
+
+    // Each GPIO read is a bus access on the MCU, and dominates the cost of a scan there. Host time is
+    // not recorded, as it mostly measures the mock, which works out every pad of a port on each read.
+    RecordProperty("gpio_reads_per_scan", (int)((mock_pin_reads + mock_port_reads) / scans));
+}
+
+TEST_F(MatrixTest, GhostKeyWithoutDiodes) {
+    mock_set_diodes(false);
+    set_key(0, 0, true);
+    set_key(0, 1, true);
+    set_key(1, 0, true);
+    matrix_scan();
+
+    // The fourth corner of the rectangle shows up as well, for ghost detection to sort out
+    EXPECT_EQ(matrix[0], 0b11);
+    EXPECT_EQ(matrix[1], 0b11);
+    for (uint8_t row = 2; row < MATRIX_ROWS; row++) {
+        EXPECT_EQ(matrix[row], 0);
+    }
+
+    release_all();
+    matrix_scan();
+    expect_pressed_keys();
+}
+
+TEST_F(MatrixTest, NoGhostKeyWithDiodes) {
+    set_key(0, 0, true);
+    set_key(0, 1, true);
+    set_key(1, 0, true);
+    matrix_scan();
+    expect_pressed_keys();
+}
+
+#ifdef MATRIX_SPARSE_SCAN
+#    if (DIODE_DIRECTION == COL2ROW)
+#        define MATRIX_PROBE_READS (MATRIX_COLS - 1)
+#    else
+#        define MATRIX_PROBE_READS MATRIX_ROWS
+#    endif
+
+TEST_F(MatrixTest, IdleScanReadsEachInputOnce) {
+    matrix_scan();
+
+    // Exactly one of any MATRIX_SPARSE_SCAN_INTERVAL scans in a row is a full one
+    mock_pin_reads = 0;
+    for (int i = 0; i < MATRIX_SPARSE_SCAN_INTERVAL; i++) {
+        matrix_scan();
+    }
+    EXPECT_EQ(mock_pin_reads, (MATRIX_SPARSE_SCAN_INTERVAL - 1) * MATRIX_PROBE_READS + MATRIX_FULL_SCAN_READS);
+    expect_pressed_keys();
+}
+
+TEST_F(MatrixTest, PressFoundOnFirstScan) {
+    for (int i = 0; i < 10; i++) {
+        matrix_scan();
+    }
+
+    set_key(3, 4, true);
+    matrix_scan();
+    expect_pressed_keys();
+
+    set_key(3, 4, false);
+    matrix_scan();
+    expect_pressed_keys();
+}
+
+TEST_F(MatrixTest, GhostKeyWithoutDiodesAfterIdle) {
+    mock_set_diodes(false);
+    for (int i = 0; i < 10; i++) {
+        matrix_scan();
+    }
+
+    // Selecting every output at once must not hide a press that only shows up with ghosting
+    set_key(0, 0, true);
+    set_key(0, 1, true);
+    set_key(1, 0, true);
+    matrix_scan();
+    EXPECT_EQ(matrix[0], 0b11);
+    EXPECT_EQ(matrix[1], 0b11);
+}
+
+TEST_F(MatrixTest, ReadsWhileTyping) {
+    // Bursts of 1 to 3 keys held for 40 scans, one burst every 200 scans
+    const int scans = 20000;
+    uint32_t  seed  = 12345;
+
+    mock_pin_reads = 0;
+    for (int i = 0; i < scans; i++) {
+        if (i % 200 == 0) {
+            seed = seed * 1103515245 + 12345;
+            for (int key = 0; key < 1 + (seed >> 16) % 3; key++) {
+                seed = seed * 1103515245 + 12345;
+                set_key((seed >> 16) % MATRIX_ROWS, (seed >> 20) % MATRIX_COLS, true);
+            }
+        } else if (i % 200 == 40) {
+            release_all();
+        }
+        matrix_scan();
+        expect_pressed_keys();
+    }
+
+    // Most scans only probe the inputs, so far fewer pins are read than with full scans
+    EXPECT_LT(mock_pin_reads, (uint32_t)scans * MATRIX_FULL_SCAN_READS / 2);
+}
+#endif
+
+#ifdef MATRIX_IDLE_TIMEOUT
+class MatrixIdleTest : public MatrixTest {
+   protected:
+    void SetUp() override {
+        MatrixTest::SetUp();
+        mock_input_elapsed = 0;
+        // Leave idle, should a previous test have left it there
+        while (is_matrix_idle()) {
+            matrix_idle_wakeup();
+            matrix_idle_task();
+        }
+    }
+
+    // Runs the idle task once the timeout is up, scanning whenever it says to like keyboard_task() does
+    bool idle_task() {
+        mock_input_elapsed = MATRIX_IDLE_TIMEOUT;
+        bool scan          = matrix_idle_task();
+        if (scan) {
+            matrix_scan();
+        }
+        return scan;
+    }
+};
+
+TEST_F(MatrixIdleTest, NotBeforeTimeout) {
+    mock_input_elapsed = MATRIX_IDLE_TIMEOUT - 1;
+    EXPECT_TRUE(matrix_idle_task());
+    EXPECT_FALSE(is_matrix_idle());
+}
+
+TEST_F(MatrixIdleTest, NotWhileKeyHeld) {
+    set_key(2, 3, true);
+    matrix_scan();
+    EXPECT_TRUE(idle_task());
+    EXPECT_FALSE(is_matrix_idle());
+
+    // The release has to be scanned before going idle
+    set_key(2, 3, false);
+    EXPECT_TRUE(idle_task());
+    expect_pressed_keys();
+    EXPECT_FALSE(idle_task());
+    EXPECT_TRUE(is_matrix_idle());
+}
+
+TEST_F(MatrixIdleTest, PollsInputsInsteadOfScanning) {
+    EXPECT_FALSE(idle_task());
+    EXPECT_TRUE(is_matrix_idle());
+
+    // Every loop reads each input with a pin once, rather than every input for each output
+    for (int i = 0; i < 10; i++) {
+        mock_pin_reads = 0;
+        EXPECT_FALSE(idle_task());
+#    if (DIODE_DIRECTION == COL2ROW)
+        EXPECT_EQ(mock_pin_reads, MATRIX_COLS - 1);
+#    else
+        EXPECT_EQ(mock_pin_reads, MATRIX_ROWS);
+#    endif
+    }
+}
+
+TEST_F(MatrixIdleTest, AnyKeyWakes) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (col == MATRIX_NO_PIN_COL) {
+                continue;
+            }
+            EXPECT_FALSE(idle_task());
+            ASSERT_TRUE(is_matrix_idle());
+
+            // The press is scanned in the same loop that leaves idle
+            set_key(row, col, true);
+            EXPECT_TRUE(idle_task());
+            EXPECT_FALSE(is_matrix_idle());
+            expect_pressed_keys();
+
+            set_key(row, col, false);
+            EXPECT_TRUE(idle_task());
+            expect_pressed_keys();
+        }
+    }
+}
+
+TEST_F(MatrixIdleTest, WakeupRequestWithoutKey) {
+    EXPECT_FALSE(idle_task());
+    matrix_idle_wakeup();
+    EXPECT_TRUE(idle_task());
+    EXPECT_FALSE(is_matrix_idle());
+    expect_pressed_keys();
+
+    // Outputs are back to one at a time, so several keys scan without ghosting
+    set_key(0, 0, true);
+    set_key(1, 1, true);
+    matrix_scan();
+    expect_pressed_keys();
+}
+
+#    if (DIODE_DIRECTION == COL2ROW)
+static const pin_t idle_input_pins[] = MATRIX_COL_PINS;
+static const bool  idle_pin_armed[]  = {true, true, false, true, false, true, false, true, false, false};
+#    else
+static const pin_t idle_input_pins[] = MATRIX_ROW_PINS;
+static const bool  idle_pin_armed[]  = {false, false, false, false, true};
+#    endif
+
+TEST_F(MatrixIdleTest, LineEventsOnlyOnUnsharedPads) {
+    // Inputs on the same pad as another input, the motion pin or a reserved pin are left to polling
+    EXPECT_FALSE(idle_task());
+    for (size_t i = 0; i < sizeof(idle_input_pins) / sizeof(pin_t); i++) {
+        if (idle_input_pins[i] != NO_PIN) {
+            EXPECT_EQ(mock_line_event_enabled(idle_input_pins[i]), idle_pin_armed[i]) << "input " << i;
+        }
+    }
+
+    matrix_idle_wakeup();
+    EXPECT_TRUE(idle_task());
+    for (pin_t pin : idle_input_pins) {
+        if (pin != NO_PIN) {
+            EXPECT_FALSE(mock_line_event_enabled(pin));
+        }
+    }
+    EXPECT_FALSE(mock_line_conflict);
+}
+
+TEST_F(MatrixIdleTest, OtherLineEventsSurvive) {
+    mock_enable_line_event(POINTING_DEVICE_MOTION_PIN, PAL_EVENT_MODE_FALLING_EDGE);
+    mock_enable_line_event(MOCK_PIN(3, 4), PAL_EVENT_MODE_FALLING_EDGE);
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_FALSE(idle_task());
+        matrix_idle_wakeup();
+        EXPECT_TRUE(idle_task());
+    }
+    EXPECT_TRUE(mock_line_event_enabled(POINTING_DEVICE_MOTION_PIN));
+    EXPECT_TRUE(mock_line_event_enabled(MOCK_PIN(3, 4)));
+    EXPECT_FALSE(mock_line_conflict);
+}
+
+TEST_F(MatrixIdleTest, LineEventWakes) {
+    for (size_t i = 0; i < sizeof(idle_input_pins) / sizeof(pin_t); i++) {
+        if (!idle_pin_armed[i]) {
+            continue;
+        }
+        EXPECT_FALSE(idle_task());
+        EXPECT_FALSE(idle_task());
+        mock_fire_line_event(idle_input_pins[i]);
+        EXPECT_TRUE(idle_task()) << "input " << i;
+        EXPECT_FALSE(is_matrix_idle());
+    }
+}
+
+TEST_F(MatrixIdleTest, Stats) {
+    matrix_idle_stats_t before = matrix_idle_get_stats();
+    EXPECT_FALSE(idle_task());
+    EXPECT_FALSE(idle_task());
+    set_key(4, 0, true);
+    EXPECT_TRUE(idle_task());
+
+    matrix_idle_stats_t after = matrix_idle_get_stats();
+    EXPECT_EQ(after.sleeps - before.sleeps, 2u);
+    EXPECT_EQ(after.wakeups - before.wakeups, 1u);
+}
+#endif
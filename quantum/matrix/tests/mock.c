@@ -0,0 +1,193 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "matrix.h"
+#include "mock.h"
+
+static const pin_t mock_row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+static const pin_t mock_col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+static bool mock_pin_is_output[256];
+static bool mock_pin_level[256];
+static bool mock_keys[MATRIX_ROWS][MATRIX_COLS];
+static bool mock_diodes = true;
+
+uint32_t mock_pin_reads  = 0;
+uint32_t mock_port_reads = 0;
+
+/* matrix_common.c is not linked, so provide what matrix.c needs from it */
+matrix_row_t raw_matrix[MATRIX_ROWS];
+matrix_row_t matrix[MATRIX_ROWS];
+
+void matrix_init_kb(void) {}
+void matrix_scan_kb(void) {}
+void matrix_output_select_delay(void) {}
+void matrix_output_unselect_delay(uint8_t line, bool key_pressed) {}
+
+#ifdef MATRIX_IDLE_TIMEOUT
+uint32_t mock_input_elapsed = 0;
+
+uint32_t last_input_activity_elapsed(void) {
+    return mock_input_elapsed;
+}
+
+static pin_t                mock_line_owner[16];
+static mock_line_callback_t mock_line_callback[16];
+static void                *mock_line_arg[16];
+
+bool mock_line_conflict = false;
+
+static void mock_reset_lines(void) {
+    memset(mock_line_owner, NO_PIN, sizeof(mock_line_owner));
+    memset(mock_line_callback, 0, sizeof(mock_line_callback));
+    mock_line_conflict = false;
+}
+
+void mock_enable_line_event(pin_t pin, uint8_t mode) {
+    uint8_t pad = gpio_pin_pad(pin);
+    if (mock_line_owner[pad] != NO_PIN && mock_line_owner[pad] != pin) {
+        mock_line_conflict = true;
+    }
+    mock_line_owner[pad]    = pin;
+    mock_line_callback[pad] = NULL;
+}
+
+void mock_disable_line_event(pin_t pin) {
+    uint8_t pad = gpio_pin_pad(pin);
+    if (mock_line_owner[pad] != NO_PIN && mock_line_owner[pad] != pin) {
+        mock_line_conflict = true;
+    }
+    mock_line_owner[pad]    = NO_PIN;
+    mock_line_callback[pad] = NULL;
+}
+
+void mock_set_line_callback(pin_t pin, mock_line_callback_t callback, void *arg) {
+    uint8_t pad             = gpio_pin_pad(pin);
+    mock_line_callback[pad] = callback;
+    mock_line_arg[pad]      = arg;
+}
+
+bool mock_line_event_enabled(pin_t pin) {
+    return mock_line_owner[gpio_pin_pad(pin)] == pin;
+}
+
+void mock_fire_line_event(pin_t pin) {
+    uint8_t pad = gpio_pin_pad(pin);
+    if (mock_line_owner[pad] == pin && mock_line_callback[pad]) {
+        mock_line_callback[pad](mock_line_arg[pad]);
+    }
+}
+#endif
+
+#ifdef MATRIX_IDLE_TIMEOUT
+static void mock_reset_lines(void);
+#endif
+
+void mock_reset(void) {
+    memset(mock_pin_is_output, 0, sizeof(mock_pin_is_output));
+    memset(mock_pin_level, 1, sizeof(mock_pin_level));
+    memset(mock_keys, 0, sizeof(mock_keys));
+    mock_diodes     = true;
+    mock_pin_reads  = 0;
+    mock_port_reads = 0;
+#ifdef MATRIX_IDLE_TIMEOUT
+    mock_reset_lines();
+#endif
+}
+
+void mock_set_key(uint8_t row, uint8_t col, bool pressed) {
+    mock_keys[row][col] = pressed;
+}
+
+void mock_set_diodes(bool diodes) {
+    mock_diodes = diodes;
+}
+
+void mock_set_pin_input_high(pin_t pin) {
+    mock_pin_is_output[pin] = false;
+    mock_pin_level[pin]     = true;
+}
+
+void mock_set_pin_output(pin_t pin) {
+    mock_pin_is_output[pin] = true;
+}
+
+void mock_write_pin(pin_t pin, bool level) {
+    mock_pin_level[pin] = level;
+}
+
+static bool mock_line_driven_low(pin_t pin) {
+    return pin != NO_PIN && mock_pin_is_output[pin] && !mock_pin_level[pin];
+}
+
+static bool mock_pin_is_low(pin_t pin) {
+    if (mock_pin_is_output[pin]) {
+        return !mock_pin_level[pin];
+    }
+
+    bool row_low[MATRIX_ROWS];
+    bool col_low[MATRIX_COLS];
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        row_low[row] = mock_line_driven_low(mock_row_pins[row]);
+    }
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        col_low[col] = mock_line_driven_low(mock_col_pins[col]);
+    }
+
+    // A diode only lets the input side be pulled low, while a bare switch connects both lines,
+    // so keep going until every line joined to a low one through pressed keys is low
+    bool changed;
+    do {
+        changed = false;
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                if (!mock_keys[row][col] || mock_row_pins[row] == NO_PIN || mock_col_pins[col] == NO_PIN) {
+                    continue;
+                }
+#if (DIODE_DIRECTION == COL2ROW)
+                bool pull_row = !mock_diodes && col_low[col];
+                bool pull_col = row_low[row];
+#else
+                bool pull_row = col_low[col];
+                bool pull_col = !mock_diodes && row_low[row];
+#endif
+                if (pull_row && !row_low[row]) {
+                    row_low[row] = changed = true;
+                }
+                if (pull_col && !col_low[col]) {
+                    col_low[col] = changed = true;
+                }
+            }
+        }
+    } while (changed && !mock_diodes);
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (mock_row_pins[row] == pin) {
+            return row_low[row];
+        }
+    }
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        if (mock_col_pins[col] == pin) {
+            return col_low[col];
+        }
+    }
+    return false;
+}
+
+bool mock_read_pin(pin_t pin) {
+    mock_pin_reads++;
+    return !mock_pin_is_low(pin);
+}
+
+gpio_port_data_t mock_read_port(gpio_port_t port) {
+    gpio_port_data_t value = 0;
+
+    mock_port_reads++;
+    for (uint8_t pad = 0; pad < 16; pad++) {
+        if (!mock_pin_is_low(port | pad)) {
+            value |= (gpio_port_data_t)1 << pad;
+        }
+    }
+    return value;
+}
@@ -0,0 +1,70 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef uint8_t  pin_t;
+typedef uint8_t  gpio_port_t;
+typedef uint16_t gpio_port_data_t;
+
+/* Pins are numbered like on AVR, with the port in the upper and the pad in the lower nibble. */
+#define MOCK_PIN(port, pad) ((pin_t)(((port) << 4) | (pad)))
+
+#define gpio_set_pin_input_high(pin) mock_set_pin_input_high(pin)
+#define gpio_set_pin_output(pin) mock_set_pin_output(pin)
+#define gpio_write_pin_high(pin) mock_write_pin(pin, true)
+#define gpio_write_pin_low(pin) mock_write_pin(pin, false)
+#define gpio_read_pin(pin) mock_read_pin(pin)
+
+#define gpio_pin_port(pin) ((gpio_port_t)((pin)&0xF0))
+#define gpio_pin_pad(pin) ((pin)&0x0F)
+#define gpio_read_port(port) mock_read_port(port)
+
+extern uint32_t mock_pin_reads;
+extern uint32_t mock_port_reads;
+
+void mock_set_pin_input_high(pin_t pin);
+void mock_set_pin_output(pin_t pin);
+void mock_write_pin(pin_t pin, bool level);
+bool mock_read_pin(pin_t pin);
+
+gpio_port_data_t mock_read_port(gpio_port_t port);
+
+/* Releases every key and puts back the diodes */
+void mock_reset(void);
+
+void mock_set_key(uint8_t row, uint8_t col, bool pressed);
+
+/* Without diodes, a key pulls its row and column together both ways, which lets ghost keys appear */
+void mock_set_diodes(bool diodes);
+
+#ifdef MATRIX_IDLE_TIMEOUT
+/* Returned by last_input_activity_elapsed() */
+extern uint32_t mock_input_elapsed;
+
+/* PAL line events, with one line per pad number shared by all ports like the EXTI of STM32 */
+#    ifndef TRUE
+#        define TRUE 1
+#    endif
+#    define PAL_USE_CALLBACKS TRUE
+#    define PAL_EVENT_MODE_RISING_EDGE 1
+#    define PAL_EVENT_MODE_FALLING_EDGE 2
+
+#    define palEnableLineEvent(line, mode) mock_enable_line_event(line, mode)
+#    define palDisableLineEvent(line) mock_disable_line_event(line)
+#    define palSetLineCallback(line, cb, arg) mock_set_line_callback(line, cb, arg)
+
+typedef void (*mock_line_callback_t)(void *arg);
+
+/* Set when a line was taken from, or disabled under, a pin on another port */
+extern bool mock_line_conflict;
+
+void mock_enable_line_event(pin_t pin, uint8_t mode);
+void mock_disable_line_event(pin_t pin);
+void mock_set_line_callback(pin_t pin, mock_line_callback_t callback, void *arg);
+bool mock_line_event_enabled(pin_t pin);
+void mock_fire_line_event(pin_t pin);
+#endif
@@ -0,0 +1,45 @@
+MATRIX_COMMON_DEFS := -DIGNORE_ATOMIC_BLOCK
+MATRIX_COMMON_CONFIG := $(QUANTUM_PATH)/matrix/tests/config_mock.h
+
+MATRIX_COMMON_SRC := \
+	$(QUANTUM_PATH)/matrix/tests/mock.c \
+	$(QUANTUM_PATH)/matrix/tests/matrix_tests.cpp \
+	$(QUANTUM_PATH)/debounce/none.c \
+	$(QUANTUM_PATH)/matrix.c
+
+matrix_col2row_DEFS := $(MATRIX_COMMON_DEFS) -DDIODE_DIRECTION=COL2ROW
+matrix_col2row_CONFIG := $(MATRIX_COMMON_CONFIG)
+matrix_col2row_SRC := $(MATRIX_COMMON_SRC)
+
+matrix_col2row_by_port_DEFS := $(MATRIX_COMMON_DEFS) -DDIODE_DIRECTION=COL2ROW -DMATRIX_READ_BY_PORT
+matrix_col2row_by_port_CONFIG := $(MATRIX_COMMON_CONFIG)
+matrix_col2row_by_port_SRC := $(MATRIX_COMMON_SRC)
+
+matrix_row2col_DEFS := $(MATRIX_COMMON_DEFS) -DDIODE_DIRECTION=ROW2COL
+matrix_row2col_CONFIG := $(MATRIX_COMMON_CONFIG)
+matrix_row2col_SRC := $(MATRIX_COMMON_SRC)
+
+matrix_row2col_by_port_DEFS := $(MATRIX_COMMON_DEFS) -DDIODE_DIRECTION=ROW2COL -DMATRIX_READ_BY_PORT
+matrix_row2col_by_port_CONFIG := $(MATRIX_COMMON_CONFIG)
+matrix_row2col_by_port_SRC := $(MATRIX_COMMON_SRC)
+
+matrix_col2row_sparse_scan_DEFS := $(MATRIX_COMMON_DEFS) -DDIODE_DIRECTION=COL2ROW -DMATRIX_SPARSE_SCAN -DMATRIX_SPARSE_SCAN_INTERVAL=16
+matrix_col2row_sparse_scan_CONFIG := $(MATRIX_COMMON_CONFIG)
+matrix_col2row_sparse_scan_SRC := $(MATRIX_COMMON_SRC)
+
+matrix_row2col_sparse_scan_DEFS := $(MATRIX_COMMON_DEFS) -DDIODE_DIRECTION=ROW2COL -DMATRIX_SPARSE_SCAN -DMATRIX_SPARSE_SCAN_INTERVAL=16
+matrix_row2col_sparse_scan_CONFIG := $(MATRIX_COMMON_CONFIG)
+matrix_row2col_sparse_scan_SRC := $(MATRIX_COMMON_SRC)
+
+MATRIX_IDLE_SRC := \
+	$(MATRIX_COMMON_SRC) \
+	$(QUANTUM_PATH)/matrix_idle.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+matrix_col2row_idle_DEFS := $(MATRIX_COMMON_DEFS) -DDIODE_DIRECTION=COL2ROW -DMATRIX_IDLE_TIMEOUT=100
+matrix_col2row_idle_CONFIG := $(MATRIX_COMMON_CONFIG)
+matrix_col2row_idle_SRC := $(MATRIX_IDLE_SRC)
+
+matrix_row2col_idle_DEFS := $(MATRIX_COMMON_DEFS) -DDIODE_DIRECTION=ROW2COL -DMATRIX_IDLE_TIMEOUT=100
+matrix_row2col_idle_CONFIG := $(MATRIX_COMMON_CONFIG)
+matrix_row2col_idle_SRC := $(MATRIX_IDLE_SRC)
@@ -0,0 +1,9 @@
+TEST_LIST += \
+	matrix_col2row \
+	matrix_col2row_by_port \
+	matrix_row2col \
+	matrix_row2col_by_port \
+	matrix_col2row_sparse_scan \
+	matrix_row2col_sparse_scan \
+	matrix_col2row_idle \
+	matrix_row2col_idle
@@ -172,7 +172,10 @@ __attribute__((weak)) uint8_t matrix_scan(void) {
     changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
 #else
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
+#    ifndef KEYEVENT_QUEUE_SCAN_THREAD
+    // Called by matrix_task() on the main loop instead
     matrix_scan_kb();
+#    endif
 #endif
 
     return changed;
@@ -0,0 +1,130 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef MATRIX_IDLE_TIMEOUT
+
+#    include "matrix_idle.h"
+#    include "keyboard.h"
+#    include "timer.h"
+
+#    ifdef SPLIT_KEYBOARD
+#        error "MATRIX_IDLE_TIMEOUT is not supported on split keyboards"
+#    endif
+
+#    if defined(__AVR__)
+#        include <avr/interrupt.h>
+#        include <avr/sleep.h>
+#    elif defined(PROTOCOL_CHIBIOS)
+#        include <ch.h>
+static BSEMAPHORE_DECL(matrix_idle_semaphore, true);
+#    endif
+
+static bool                matrix_idle       = false;
+static volatile bool       matrix_idle_woken = false;
+static uint32_t            matrix_idle_start = 0;
+static matrix_idle_stats_t matrix_idle_stats = {0};
+
+/* Defaults for matrices without idle support, which never go idle */
+__attribute__((weak)) bool matrix_idle_enter(void) {
+    return false;
+}
+
+__attribute__((weak)) void matrix_idle_exit(void) {}
+
+__attribute__((weak)) bool matrix_idle_input_active(void) {
+    return true;
+}
+
+/**
+ * @brief Sleeps until an interrupt, for at most about a millisecond
+ *
+ * Idle is reduced-rate polling rather than tickless: the inputs are read again after every
+ * sleep, and the bound keeps timers, deferred executors and the USB stack serviced.
+ */
+__attribute__((weak)) void matrix_idle_sleep(void) {
+#    if defined(__AVR__)
+    // Woken by any interrupt, at the latest by the 1ms timer tick
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_enable();
+    sei();
+    sleep_cpu();
+    sleep_disable();
+#    elif defined(PROTOCOL_CHIBIOS)
+    // Let the idle thread run, woken early by matrix_idle_wakeup()
+    chBSemWaitTimeout(&matrix_idle_semaphore, TIME_MS2I(1));
+#    endif
+}
+
+/**
+ * @brief Requests full rate scanning on the next loop
+ *
+ * Intended to be called from a pin interrupt handler, which cuts the current sleep short. Without
+ * one, a press is still found by the next poll.
+ */
+void matrix_idle_wakeup(void) {
+    matrix_idle_woken = true;
+#    if defined(PROTOCOL_CHIBIOS)
+    chSysLockFromISR();
+    chBSemSignalI(&matrix_idle_semaphore);
+    chSysUnlockFromISR();
+#    endif
+}
+
+bool is_matrix_idle(void) {
+    return matrix_idle;
+}
+
+matrix_idle_stats_t matrix_idle_get_stats(void) {
+    return matrix_idle_stats;
+}
+
+/**
+ * @brief Decides whether the matrix is scanned this loop
+ *
+ * Goes idle once there has been no input for MATRIX_IDLE_TIMEOUT and the matrix agrees. While
+ * idle, each loop polls the inputs once instead of scanning, and sleeps for up to a tick. Idle is
+ * left in the same loop as the wakeup, so the key which caused it is picked up by the following
+ * scan.
+ *
+ * @return true if the matrix should be scanned
+ */
+bool matrix_idle_task(void) {
+    if (!matrix_idle) {
+        if (last_input_activity_elapsed() < MATRIX_IDLE_TIMEOUT) {
+            return true;
+        }
+        matrix_idle_woken = false;
+        if (!matrix_idle_enter()) {
+            return true;
+        }
+        matrix_idle       = true;
+        matrix_idle_start = timer_read32();
+    }
+
+    if (!matrix_idle_woken && !matrix_idle_input_active()) {
+        matrix_idle_stats.sleeps++;
+        matrix_idle_sleep();
+        return false;
+    }
+
+    matrix_idle_exit();
+    matrix_idle = false;
+    matrix_idle_stats.wakeups++;
+    matrix_idle_stats.idle_time += timer_elapsed32(matrix_idle_start);
+    return true;
+}
+
+#endif // MATRIX_IDLE_TIMEOUT
@@ -0,0 +1,48 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* check settings */
+#ifndef MATRIX_IDLE_TIMEOUT
+#    error "MATRIX_IDLE_TIMEOUT not defined! check config settings"
+#endif
+
+/* data structure */
+typedef struct {
+    uint32_t sleeps;    // loops spent sleeping instead of scanning
+    uint32_t wakeups;   // returns to full rate scanning
+    uint32_t idle_time; // milliseconds spent idle, up to the last wakeup
+} matrix_idle_stats_t;
+
+/* ----------For keyboard_task()------------------------------------------------------------------- */
+bool matrix_idle_task(void);
+
+/* ----------For Wakeup Sources and Measurement---------------------------------------------------- */
+void                matrix_idle_wakeup(void);
+bool                is_matrix_idle(void);
+matrix_idle_stats_t matrix_idle_get_stats(void);
+
+/* ----------Implemented by the Matrix------------------------------------------------------------- */
+bool matrix_idle_enter(void);
+void matrix_idle_exit(void);
+bool matrix_idle_input_active(void);
+
+/* ----------Overridable Sleep--------------------------------------------------------------------- */
+void matrix_idle_sleep(void);
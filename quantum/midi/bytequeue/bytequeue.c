@@ -40,6 +40,22 @@ bool bytequeue_enqueue(byteQueue_t* queue, uint8_t item) {
     }
 }
 
+bool bytequeue_enqueue_array(byteQueue_t* queue, const uint8_t* items, byteQueueIndex_t count) {
+    interrupt_setting_t setting = store_and_clear_interrupt();
+    byteQueueIndex_t    used    = (queue->end >= queue->start) ? queue->end - queue->start : (queue->length - queue->start) + queue->end;
+    // one slot always stays empty to tell a full queue from an empty one
+    if (count >= queue->length - used) {
+        restore_interrupt_setting(setting);
+        return false;
+    }
+    for (byteQueueIndex_t i = 0; i < count; i++) {
+        queue->data[queue->end] = items[i];
+        queue->end              = (queue->end + 1) % queue->length;
+    }
+    restore_interrupt_setting(setting);
+    return true;
+}
+
 byteQueueIndex_t bytequeue_length(byteQueue_t* queue) {
     byteQueueIndex_t    len;
     interrupt_setting_t setting = store_and_clear_interrupt();
@@ -41,6 +41,9 @@ void bytequeue_init(byteQueue_t* queue, uint8_t* dataArray, byteQueueIndex_t arr
 // add an item to the queue, returns false if the queue is full
 bool bytequeue_enqueue(byteQueue_t* queue, uint8_t item);
 
+// add several items to the queue at once, returns false without adding any if they do not all fit
+bool bytequeue_enqueue_array(byteQueue_t* queue, const uint8_t* items, byteQueueIndex_t count);
+
 // get the length of the queue
 byteQueueIndex_t bytequeue_length(byteQueue_t* queue);
 
@@ -44,4 +44,14 @@ interrupt_setting_t store_and_clear_interrupt(void) {
 void restore_interrupt_setting(interrupt_setting_t setting) {
     chSysUnlock();
 }
+#else
+// no interrupts to guard against, e.g. when running the unit tests
+
+interrupt_setting_t store_and_clear_interrupt(void) {
+    return 0;
+}
+
+void restore_interrupt_setting(interrupt_setting_t setting) {
+    (void)setting;
+}
 #endif
@@ -59,9 +59,8 @@ void midi_device_init(MidiDevice* device) {
 }
 
 void midi_device_input(MidiDevice* device, uint8_t cnt, uint8_t* input) {
-    uint8_t i;
-    for (i = 0; i < cnt; i++)
-        bytequeue_enqueue(&device->input_queue, input[i]);
+    // all or nothing, so that a full queue does not leave half a message behind
+    bytequeue_enqueue_array(&device->input_queue, input, cnt);
 }
 
 void midi_device_set_send_func(MidiDevice* device, midi_var_byte_func_t send_func) {
@@ -81,10 +80,10 @@ void midi_device_process(MidiDevice* device) {
     uint16_t         i;
     // TODO limit number of bytes processed?
     for (i = 0; i < len; i++) {
-        uint8_t val = bytequeue_get(&device->input_queue, 0);
-        midi_process_byte(device, val);
-        bytequeue_remove(&device->input_queue, 1);
+        midi_process_byte(device, bytequeue_get(&device->input_queue, i));
     }
+    // the bytes are read in place, so only give their space back once all are processed
+    bytequeue_remove(&device->input_queue, len);
 }
 
 void midi_process_byte(MidiDevice* device, uint8_t input) {
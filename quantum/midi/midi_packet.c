@@ -0,0 +1,175 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "midi_packet.h"
+#include "midi.h"
+
+#define MIDI_PACKET_INDEX(index) ((index) & (MIDI_PACKET_RING_SIZE - 1))
+#define MIDI_PACKET_EVENT(cable, code) ((uint8_t)(((cable) << 4) | (code)))
+#define MIDI_PACKET_CODE(event) ((event)&0x0F)
+
+/* code index numbers of the USB-MIDI specification */
+#define CODE_SYS_COMMON_2 0x2
+#define CODE_SYS_COMMON_3 0x3
+#define CODE_SYSEX_START_OR_CONT 0x4
+#define CODE_SYSEX_ENDS_IN_1 0x5
+#define CODE_SYSEX_ENDS_IN_2 0x6
+#define CODE_SYSEX_ENDS_IN_3 0x7
+
+void midi_packet_ring_init(midi_packet_ring_t *ring) {
+    ring->head = 0;
+    ring->tail = 0;
+}
+
+uint8_t midi_packet_ring_count(const midi_packet_ring_t *ring) {
+    return (uint8_t)(ring->head - ring->tail);
+}
+
+/**
+ * @brief Appends a packet to the ring
+ *
+ * @return false if the ring is full and the packet was not added
+ */
+bool midi_packet_ring_push(midi_packet_ring_t *ring, midi_packet_t packet) {
+    if (midi_packet_ring_count(ring) >= MIDI_PACKET_RING_SIZE) {
+        return false;
+    }
+    ring->packets[MIDI_PACKET_INDEX(ring->head)] = packet;
+    ring->head++;
+    return true;
+}
+
+/**
+ * @brief Gets the oldest packets of the ring in place, without removing them
+ *
+ * Returns the longest run that is contiguous in memory, limited to
+ * MIDI_PACKET_BATCH_SIZE so that it fits a single transfer. Packets which
+ * wrapped around to the start of the ring are returned by the next call,
+ * after the run has been released.
+ *
+ * @param[out] count uint8_t* number of packets in the run
+ * @return pointer to the first packet, or NULL if the ring is empty
+ */
+const midi_packet_t *midi_packet_ring_peek(const midi_packet_ring_t *ring, uint8_t *count) {
+    uint8_t queued = midi_packet_ring_count(ring);
+    uint8_t start  = MIDI_PACKET_INDEX(ring->tail);
+
+    if (queued == 0) {
+        *count = 0;
+        return NULL;
+    }
+    if (queued > MIDI_PACKET_RING_SIZE - start) {
+        queued = MIDI_PACKET_RING_SIZE - start;
+    }
+    if (queued > MIDI_PACKET_BATCH_SIZE) {
+        queued = MIDI_PACKET_BATCH_SIZE;
+    }
+
+    *count = queued;
+    return &ring->packets[start];
+}
+
+/**
+ * @brief Removes packets returned by midi_packet_ring_peek once they are sent
+ */
+void midi_packet_ring_release(midi_packet_ring_t *ring, uint8_t count) {
+    ring->tail += count;
+}
+
+/**
+ * @brief Encodes a message as passed to a midi_var_byte_func_t send function
+ *
+ * @return false if the message is not valid and no packet was encoded
+ */
+bool midi_packet_encode(midi_packet_t *packet, uint16_t cnt, uint8_t byte0, uint8_t byte1, uint8_t byte2) {
+    const uint8_t cable = 0;
+
+    packet->data[0] = byte0;
+    packet->data[1] = byte1;
+    packet->data[2] = byte2;
+
+    // if the length is undefined we assume it is a SYSEX message
+    if (midi_packet_length(byte0) == UNDEFINED) {
+        switch (cnt) {
+            case 3:
+                packet->event = MIDI_PACKET_EVENT(cable, byte2 == SYSEX_END ? CODE_SYSEX_ENDS_IN_3 : CODE_SYSEX_START_OR_CONT);
+                break;
+            case 2:
+                packet->event = MIDI_PACKET_EVENT(cable, byte1 == SYSEX_END ? CODE_SYSEX_ENDS_IN_2 : CODE_SYSEX_START_OR_CONT);
+                break;
+            case 1:
+                packet->event = MIDI_PACKET_EVENT(cable, byte0 == SYSEX_END ? CODE_SYSEX_ENDS_IN_1 : CODE_SYSEX_START_OR_CONT);
+                break;
+            default:
+                return false; // invalid cnt
+        }
+    } else {
+        // deal with 'system common' messages
+        switch (byte0) {
+            case MIDI_SONGPOSITION:
+                packet->event = MIDI_PACKET_EVENT(cable, CODE_SYS_COMMON_3);
+                break;
+            case MIDI_SONGSELECT:
+            case MIDI_TC_QUARTERFRAME:
+                packet->event = MIDI_PACKET_EVENT(cable, CODE_SYS_COMMON_2);
+                break;
+            default:
+                // channel messages and single byte system messages carry their status as code
+                packet->event = MIDI_PACKET_EVENT(cable, byte0 >> 4);
+                break;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Passes received packets on to a device
+ *
+ * The message bytes are read directly from the packets, which can be the
+ * receive buffer of the endpoint.
+ *
+ * @param[in] device MidiDevice* to pass the messages to
+ * @param[in] packets midi_packet_t* received packets
+ * @param[in] count uint8_t number of packets
+ */
+void midi_packet_input(MidiDevice *device, const midi_packet_t *packets, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        const midi_packet_t *packet = &packets[i];
+        midi_packet_length_t length = midi_packet_length(packet->data[0]);
+
+        if (length == UNDEFINED) {
+            // sysex
+            switch (MIDI_PACKET_CODE(packet->event)) {
+                case CODE_SYSEX_START_OR_CONT:
+                case CODE_SYSEX_ENDS_IN_3:
+                    length = THREE;
+                    break;
+                case CODE_SYSEX_ENDS_IN_2:
+                    length = TWO;
+                    break;
+                case CODE_SYSEX_ENDS_IN_1:
+                    length = ONE;
+                    break;
+                default:
+                    // not a message, e.g. padding
+                    continue;
+            }
+        }
+
+        midi_device_input(device, length, (uint8_t *)packet->data);
+    }
+}
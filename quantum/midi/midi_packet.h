@@ -0,0 +1,81 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "midi_device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * USB-MIDI event packets
+ *
+ * Outgoing messages are encoded into 4 byte event packets and collected in a
+ * ring, which is drained in runs of up to one endpoint worth of packets so
+ * that a burst of messages costs a single USB transfer instead of one each.
+ * Incoming packets are decoded straight from the buffer they were received
+ * into.
+ */
+
+/* check settings and set defaults */
+#ifndef MIDI_PACKET_BATCH_SIZE
+/* MIDI_STREAM_EPSIZE / sizeof(midi_packet_t) */
+#    define MIDI_PACKET_BATCH_SIZE 16
+#endif
+
+#ifndef MIDI_PACKET_RING_SIZE
+#    define MIDI_PACKET_RING_SIZE 32
+#endif
+
+#if MIDI_PACKET_RING_SIZE > 128 || (MIDI_PACKET_RING_SIZE & (MIDI_PACKET_RING_SIZE - 1)) != 0
+#    error "MIDI_PACKET_RING_SIZE must be a power of two no larger than 128"
+#endif
+#if MIDI_PACKET_BATCH_SIZE > MIDI_PACKET_RING_SIZE
+#    error "MIDI_PACKET_BATCH_SIZE must not exceed MIDI_PACKET_RING_SIZE"
+#endif
+
+/* data structure */
+/* laid out the same as LUFA's MIDI_EventPacket_t */
+typedef struct {
+    uint8_t event; // cable number and code index number
+    uint8_t data[3];
+} midi_packet_t;
+
+typedef struct {
+    midi_packet_t packets[MIDI_PACKET_RING_SIZE];
+    uint8_t       head; // free running write index
+    uint8_t       tail; // free running read index
+} midi_packet_ring_t;
+
+/* ----------For Queueing Packets------------------------------------------------------------------ */
+void                 midi_packet_ring_init(midi_packet_ring_t *ring);
+uint8_t              midi_packet_ring_count(const midi_packet_ring_t *ring);
+bool                 midi_packet_ring_push(midi_packet_ring_t *ring, midi_packet_t packet);
+const midi_packet_t *midi_packet_ring_peek(const midi_packet_ring_t *ring, uint8_t *count);
+void                 midi_packet_ring_release(midi_packet_ring_t *ring, uint8_t count);
+
+/* ----------For Converting Packets---------------------------------------------------------------- */
+bool midi_packet_encode(midi_packet_t *packet, uint16_t cnt, uint8_t byte0, uint8_t byte1, uint8_t byte2);
+void midi_packet_input(MidiDevice *device, const midi_packet_t *packets, uint8_t count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -2,9 +2,14 @@
 
 #ifdef MIDI_ENABLE
 #    include "midi.h"
+#    include "midi_packet.h"
 #    include <LUFA/Drivers/USB/USB.h>
 extern MidiDevice midi_device;
 void              setup_midi(void);
-void              send_midi_packet(MIDI_EventPacket_t* event);
-bool              recv_midi_packet(MIDI_EventPacket_t* const event);
+void              midi_flush(void);
+
+/* implemented by the protocol, see tmk_core/protocol */
+bool                 send_midi_packets(const midi_packet_t* packets, uint8_t count);
+const midi_packet_t* recv_midi_packets(uint8_t* count);
+void                 release_midi_packets(void);
 #endif
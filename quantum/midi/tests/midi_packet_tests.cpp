@@ -0,0 +1,298 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <deque>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "qmk_midi.h"
+}
+
+namespace {
+
+constexpr size_t ENDPOINT_SIZE = MIDI_PACKET_BATCH_SIZE * sizeof(midi_packet_t);
+
+using message_t  = std::tuple<uint16_t, uint8_t, uint8_t, uint8_t>;
+using transfer_t = std::vector<midi_packet_t>;
+
+/* Stand-in for the USB driver: records the transfers sent to the host and hands out those sent by it */
+struct Usb {
+    std::vector<transfer_t> to_host;
+    std::deque<transfer_t>  to_keyboard;
+    transfer_t              borrowed;
+    size_t                  acquired = 0;
+    size_t                  released = 0;
+};
+
+Usb                    usb;
+MidiDevice             host;
+std::vector<message_t> received;
+std::vector<message_t> keyboard_received;
+std::vector<uint8_t>   sysex;
+
+void host_catchall_callback(MidiDevice *device, uint16_t cnt, uint8_t byte0, uint8_t byte1, uint8_t byte2) {
+    received.emplace_back(cnt, byte0, byte1, byte2);
+}
+
+void keyboard_catchall_callback(MidiDevice *device, uint16_t cnt, uint8_t byte0, uint8_t byte1, uint8_t byte2) {
+    keyboard_received.emplace_back(cnt, byte0, byte1, byte2);
+}
+
+void sysex_callback(MidiDevice *device, uint16_t start, uint8_t length, uint8_t *data) {
+    sysex.resize(start + length);
+    std::copy(data, data + length, sysex.begin() + start);
+}
+
+midi_packet_t packet_of(uint8_t event, uint8_t byte0) {
+    midi_packet_t packet = {event, {byte0, 0, 0}};
+    return packet;
+}
+
+message_t message(uint16_t cnt, uint8_t byte0, uint8_t byte1 = 0, uint8_t byte2 = 0) {
+    return message_t(cnt, byte0, byte1, byte2);
+}
+
+class MidiPacket : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        usb = Usb();
+        received.clear();
+        keyboard_received.clear();
+        sysex.clear();
+
+        midi_packet_ring_init(&ring);
+        setup_midi();
+        midi_register_catchall_callback(&midi_device, keyboard_catchall_callback);
+        midi_device_init(&host);
+        midi_register_catchall_callback(&host, host_catchall_callback);
+    }
+
+    /* What midi_task does on the keyboard, followed by the host parsing every transfer */
+    void task() {
+        midi_flush();
+        for (; parsed < usb.to_host.size(); parsed++) {
+            midi_packet_input(&host, usb.to_host[parsed].data(), usb.to_host[parsed].size());
+        }
+        midi_device_process(&host);
+    }
+
+    size_t packets_sent() {
+        size_t count = 0;
+        for (const transfer_t &transfer : usb.to_host) {
+            count += transfer.size();
+        }
+        return count;
+    }
+
+    midi_packet_ring_t ring;
+    size_t             parsed = 0;
+};
+
+} // namespace
+
+extern "C" {
+
+bool send_midi_packets(const midi_packet_t *packets, uint8_t count) {
+    EXPECT_GT(count, 0);
+    EXPECT_LE(count * sizeof(midi_packet_t), ENDPOINT_SIZE);
+    usb.to_host.emplace_back(packets, packets + count);
+    return true;
+}
+
+const midi_packet_t *recv_midi_packets(uint8_t *count) {
+    EXPECT_EQ(usb.acquired, usb.released) << "previous transfer was not released";
+    if (usb.to_keyboard.empty()) {
+        return NULL;
+    }
+    usb.borrowed = usb.to_keyboard.front();
+    usb.to_keyboard.pop_front();
+    usb.acquired++;
+    *count = usb.borrowed.size();
+    return usb.borrowed.data();
+}
+
+void release_midi_packets(void) {
+    usb.released++;
+}
+}
+
+TEST_F(MidiPacket, RingPeeksContiguousRunsOfAtMostOneBatch) {
+    for (uint8_t i = 0; i < MIDI_PACKET_BATCH_SIZE + 4; i++) {
+        ASSERT_TRUE(midi_packet_ring_push(&ring, packet_of(0x09, i)));
+    }
+
+    uint8_t              count;
+    const midi_packet_t *packets = midi_packet_ring_peek(&ring, &count);
+    ASSERT_NE(packets, nullptr);
+    EXPECT_EQ(count, MIDI_PACKET_BATCH_SIZE);
+    EXPECT_EQ(packets[0].data[0], 0);
+    midi_packet_ring_release(&ring, count);
+
+    packets = midi_packet_ring_peek(&ring, &count);
+    ASSERT_NE(packets, nullptr);
+    EXPECT_EQ(count, 4);
+    EXPECT_EQ(packets[0].data[0], MIDI_PACKET_BATCH_SIZE);
+    midi_packet_ring_release(&ring, count);
+
+    EXPECT_EQ(midi_packet_ring_peek(&ring, &count), nullptr);
+    EXPECT_EQ(count, 0);
+}
+
+TEST_F(MidiPacket, RingSplitsRunsAtTheWrap) {
+    uint8_t count;
+    for (uint8_t i = 0; i < MIDI_PACKET_RING_SIZE - 2; i++) {
+        midi_packet_ring_push(&ring, packet_of(0x09, 0));
+    }
+    while (midi_packet_ring_peek(&ring, &count) != NULL) {
+        midi_packet_ring_release(&ring, count);
+    }
+
+    for (uint8_t i = 0; i < 5; i++) {
+        ASSERT_TRUE(midi_packet_ring_push(&ring, packet_of(0x09, i)));
+    }
+
+    const midi_packet_t *packets = midi_packet_ring_peek(&ring, &count);
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(packets[1].data[0], 1);
+    midi_packet_ring_release(&ring, count);
+
+    packets = midi_packet_ring_peek(&ring, &count);
+    EXPECT_EQ(count, 3);
+    EXPECT_EQ(packets, &ring.packets[0]);
+    EXPECT_EQ(packets[0].data[0], 2);
+}
+
+TEST_F(MidiPacket, RingRejectsPacketsWhenFull) {
+    for (uint8_t i = 0; i < MIDI_PACKET_RING_SIZE; i++) {
+        ASSERT_TRUE(midi_packet_ring_push(&ring, packet_of(0x09, i)));
+    }
+    EXPECT_FALSE(midi_packet_ring_push(&ring, packet_of(0x09, 0)));
+    EXPECT_EQ(midi_packet_ring_count(&ring), MIDI_PACKET_RING_SIZE);
+}
+
+TEST_F(MidiPacket, EncodesCodeIndexNumbers) {
+    midi_packet_t packet;
+
+    ASSERT_TRUE(midi_packet_encode(&packet, 3, MIDI_NOTEON | 2, 60, 100));
+    EXPECT_EQ(packet.event, 0x09);
+    ASSERT_TRUE(midi_packet_encode(&packet, 3, MIDI_PITCHBEND, 0, 64));
+    EXPECT_EQ(packet.event, 0x0E);
+    ASSERT_TRUE(midi_packet_encode(&packet, 1, MIDI_CLOCK, 0, 0));
+    EXPECT_EQ(packet.event, 0x0F);
+    ASSERT_TRUE(midi_packet_encode(&packet, 3, MIDI_SONGPOSITION, 1, 2));
+    EXPECT_EQ(packet.event, 0x03);
+    ASSERT_TRUE(midi_packet_encode(&packet, 2, MIDI_SONGSELECT, 1, 0));
+    EXPECT_EQ(packet.event, 0x02);
+
+    ASSERT_TRUE(midi_packet_encode(&packet, 3, SYSEX_BEGIN, 0x7E, 0x01));
+    EXPECT_EQ(packet.event, 0x04);
+    ASSERT_TRUE(midi_packet_encode(&packet, 2, 0x01, SYSEX_END, 0));
+    EXPECT_EQ(packet.event, 0x06);
+    EXPECT_FALSE(midi_packet_encode(&packet, 4, SYSEX_BEGIN, 0, 0));
+}
+
+TEST_F(MidiPacket, SendsQueuedMessagesInOneTransfer) {
+    midi_send_noteon(&midi_device, 1, 60, 100);
+    midi_send_cc(&midi_device, 2, 7, 127);
+    midi_send_programchange(&midi_device, 3, 42);
+    midi_send_clock(&midi_device);
+    midi_send_pitchbend(&midi_device, 4, -8192);
+    midi_send_songposition(&midi_device, 1000);
+    midi_send_noteoff(&midi_device, 1, 60, 0);
+    EXPECT_TRUE(usb.to_host.empty());
+    task();
+
+    ASSERT_EQ(usb.to_host.size(), 1u);
+    ASSERT_EQ(usb.to_host[0].size(), 7u);
+    EXPECT_EQ(usb.to_host[0][0].event, 0x09);
+    EXPECT_EQ(usb.to_host[0][0].data[0], MIDI_NOTEON | 1);
+    EXPECT_EQ(usb.to_host[0][3].event, 0x0F);
+    EXPECT_EQ(usb.to_host[0][5].event, 0x03);
+
+    std::vector<message_t> expected = {
+        message(3, MIDI_NOTEON | 1, 60, 100), message(3, MIDI_CC | 2, 7, 127), message(2, MIDI_PROGCHANGE | 3, 42), message(1, MIDI_CLOCK), message(3, MIDI_PITCHBEND | 4, 0, 0), message(3, MIDI_SONGPOSITION, 1000 & 0x7F, 1000 >> 7), message(3, MIDI_NOTEOFF | 1, 60, 0),
+    };
+    EXPECT_EQ(received, expected);
+}
+
+TEST_F(MidiPacket, SendsSysex) {
+    midi_register_sysex_callback(&host, sysex_callback);
+
+    uint8_t bytes[] = {SYSEX_BEGIN, 0x7D, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, SYSEX_END};
+    midi_send_array(&midi_device, sizeof(bytes), bytes);
+    task();
+
+    ASSERT_EQ(usb.to_host.size(), 1u);
+    EXPECT_EQ(usb.to_host[0].size(), 4u);
+    EXPECT_EQ(usb.to_host[0][3].event, 0x05);
+    EXPECT_EQ(sysex, std::vector<uint8_t>(bytes, bytes + sizeof(bytes)));
+}
+
+TEST_F(MidiPacket, ReceivesEveryTransferFromTheHost) {
+    usb.to_keyboard.push_back({{0x09, {MIDI_NOTEON, 60, 100}}, {0x00, {0, 0, 0}}, {0x0B, {MIDI_CC | 3, 1, 64}}});
+    usb.to_keyboard.push_back({{0x08, {MIDI_NOTEOFF, 60, 0}}});
+    midi_device_process(&midi_device);
+
+    std::vector<message_t> expected = {message(3, MIDI_NOTEON, 60, 100), message(3, MIDI_CC | 3, 1, 64), message(3, MIDI_NOTEOFF, 60, 0)};
+    EXPECT_EQ(keyboard_received, expected);
+    EXPECT_EQ(usb.acquired, 2u);
+    EXPECT_EQ(usb.released, 2u);
+}
+
+TEST_F(MidiPacket, ControllerSweepFillsEveryTransfer) {
+    // a full sweep of one controller on every channel, with a task every 16 messages
+    std::vector<message_t> expected;
+    for (uint8_t channel = 0; channel < 16; channel++) {
+        for (uint8_t value = 0; value < 128; value++) {
+            midi_send_cc(&midi_device, channel, 1, value);
+            expected.push_back(message(3, MIDI_CC | channel, 1, value));
+            if (value % 16 == 15) {
+                task();
+            }
+        }
+    }
+
+    EXPECT_EQ(usb.to_host.size(), 16u * 128u / MIDI_PACKET_BATCH_SIZE);
+    for (const transfer_t &transfer : usb.to_host) {
+        EXPECT_EQ(transfer.size(), MIDI_PACKET_BATCH_SIZE);
+    }
+    EXPECT_EQ(received, expected);
+}
+
+TEST_F(MidiPacket, OverflowingTheRingFlushesEarly) {
+    // more messages than fit the ring between two tasks
+    std::vector<message_t> expected;
+    for (uint8_t value = 0; value < 40; value++) {
+        midi_send_noteon(&midi_device, 0, value, 100);
+        expected.push_back(message(3, MIDI_NOTEON, value, 100));
+    }
+    EXPECT_FALSE(usb.to_host.empty());
+    task();
+
+    EXPECT_EQ(packets_sent(), 40u);
+    EXPECT_EQ(received, expected);
+}
+
+TEST_F(MidiPacket, ThroughputBenchmark) {
+    const size_t rounds   = 2000;
+    const size_t messages = rounds * MIDI_PACKET_BATCH_SIZE;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds; round++) {
+        for (uint8_t i = 0; i < MIDI_PACKET_BATCH_SIZE; i++) {
+            midi_send_cc(&midi_device, i, 1, round & 0x7F);
+        }
+        task();
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_EQ(received.size(), messages);
+    EXPECT_EQ(usb.to_host.size(), rounds);
+
+    RecordProperty("messages_per_transfer", (int)(messages / usb.to_host.size()));
+    RecordProperty("messages_per_second", (int)(messages / elapsed));
+}
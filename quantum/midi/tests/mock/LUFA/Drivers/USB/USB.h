@@ -0,0 +1,5 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/* Empty stand-in for LUFA, the midi tests replace the protocol functions instead */
+#pragma once
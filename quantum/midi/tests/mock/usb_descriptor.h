@@ -0,0 +1,7 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/* Stand-in for tmk_core/protocol/usb_descriptor.h, which needs LUFA */
+#pragma once
+
+#define MIDI_STREAM_EPSIZE 64
@@ -0,0 +1,15 @@
+midi_packet_DEFS := -DMATRIX_ROWS=1 -DMATRIX_COLS=1 -DMIDI_ENABLE
+
+midi_packet_SRC := \
+	$(QUANTUM_PATH)/midi/tests/midi_packet_tests.cpp \
+	$(QUANTUM_PATH)/midi/qmk_midi.c \
+	$(QUANTUM_PATH)/midi/midi_packet.c \
+	$(QUANTUM_PATH)/midi/midi_device.c \
+	$(QUANTUM_PATH)/midi/midi.c \
+	$(QUANTUM_PATH)/midi/bytequeue/bytequeue.c \
+	$(QUANTUM_PATH)/midi/bytequeue/interrupt_setting.c
+
+midi_packet_INC := \
+	$(QUANTUM_PATH)/midi/tests/mock \
+	$(QUANTUM_PATH)/midi \
+	$(QUANTUM_PATH)/process_keycode
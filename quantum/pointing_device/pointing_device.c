@@ -21,6 +21,10 @@
 #include "timer.h"
 #include "gpio.h"
 
+#if defined(POINTING_DEVICE_MOTION_INTERRUPT) && defined(__AVR__)
+#    include "atomic_util.h"
+#endif
+
 #ifdef MOUSEKEY_ENABLE
 #    include "mousekey.h"
 #endif
@@ -79,6 +83,119 @@ uint16_t pointing_device_get_shared_cpi(void) {
 static report_mouse_t local_mouse_report         = {};
 static bool           pointing_device_force_send = false;
 
+#ifdef POINTING_DEVICE_MOTION_INTERRUPT
+#    if defined(SPLIT_POINTING_ENABLE)
+#        error POINTING_DEVICE_MOTION_INTERRUPT not supported when sharing the pointing device report between sides.
+#    endif
+#    ifndef POINTING_DEVICE_REPORT_INTERVAL_MS
+#        ifdef USB_POLLING_INTERVAL_MS
+#            define POINTING_DEVICE_REPORT_INTERVAL_MS USB_POLLING_INTERVAL_MS
+#        else
+#            define POINTING_DEVICE_REPORT_INTERVAL_MS 1
+#        endif
+#    endif
+
+typedef struct {
+    uint32_t x;
+    uint32_t y;
+    uint32_t h;
+    uint32_t v;
+} pointing_device_motion_t;
+
+// Motion is tracked as running totals, the producer only ever writes `motion_produced` and
+// pointing_device_task only ever writes `motion_consumed`, so neither side needs a lock.
+// The totals are unsigned so that they wrap around on long running devices, only the
+// difference between them is used.
+static volatile pointing_device_motion_t motion_produced = {};
+static pointing_device_motion_t          motion_consumed = {};
+static volatile bool                     motion_pending  = true;
+
+/**
+ * @brief Flags that the sensor has motion data available
+ *
+ * Safe to call from the motion pin interrupt. The sensor is read on the next pointing_device_task.
+ */
+void pointing_device_motion_interrupt(void) {
+    motion_pending = true;
+}
+
+/**
+ * @brief Adds sensor deltas to the motion accumulator
+ *
+ * Deltas are coalesced until the next report interval. Only a single context (the pointing
+ * device task, an interrupt, or a high-rate task) may produce motion.
+ *
+ * @param[in] mouse_report report_mouse_t holding the deltas
+ */
+void pointing_device_accumulate(report_mouse_t mouse_report) {
+    motion_produced.x += (uint32_t)(int32_t)mouse_report.x;
+    motion_produced.y += (uint32_t)(int32_t)mouse_report.y;
+    motion_produced.h += (uint32_t)(int32_t)mouse_report.h;
+    motion_produced.v += (uint32_t)(int32_t)mouse_report.v;
+}
+
+static inline int32_t pointing_device_motion_take(uint32_t produced, uint32_t *consumed, int32_t min, int32_t max) {
+    int32_t delta = (int32_t)(produced - *consumed);
+    if (delta < min) {
+        delta = min;
+    } else if (delta > max) {
+        delta = max;
+    }
+    *consumed += (uint32_t)delta;
+    return delta;
+}
+
+/**
+ * @brief Moves the accumulated motion into the mouse report
+ *
+ * Motion that does not fit the report range is carried over to the next report.
+ */
+static void pointing_device_motion_drain(report_mouse_t *mouse_report) {
+    pointing_device_motion_t produced;
+#    ifdef __AVR__
+    // 32-bit loads are not atomic on AVR
+    ATOMIC_BLOCK_FORCEON {
+        produced = motion_produced;
+    }
+#    else
+    produced = motion_produced;
+#    endif
+
+    mouse_report->x = pointing_device_motion_take(produced.x, &motion_consumed.x, XY_REPORT_MIN - mouse_report->x, XY_REPORT_MAX - mouse_report->x) + mouse_report->x;
+    mouse_report->y = pointing_device_motion_take(produced.y, &motion_consumed.y, XY_REPORT_MIN - mouse_report->y, XY_REPORT_MAX - mouse_report->y) + mouse_report->y;
+    mouse_report->h = pointing_device_motion_take(produced.h, &motion_consumed.h, HV_REPORT_MIN - mouse_report->h, HV_REPORT_MAX - mouse_report->h) + mouse_report->h;
+    mouse_report->v = pointing_device_motion_take(produced.v, &motion_consumed.v, HV_REPORT_MIN - mouse_report->v, HV_REPORT_MAX - mouse_report->v) + mouse_report->v;
+}
+
+#    if defined(POINTING_DEVICE_MOTION_PIN) && defined(PROTOCOL_CHIBIOS)
+static void pointing_device_motion_pal_callback(void *arg) {
+    pointing_device_motion_interrupt();
+}
+
+/**
+ * @brief Arms the motion pin interrupt
+ *
+ * Requires PAL_USE_CALLBACKS to be enabled in halconf.h.
+ */
+__attribute__((weak)) void pointing_device_motion_interrupt_init(void) {
+#        ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
+    palEnableLineEvent(POINTING_DEVICE_MOTION_PIN, PAL_EVENT_MODE_FALLING_EDGE);
+#        else
+    palEnableLineEvent(POINTING_DEVICE_MOTION_PIN, PAL_EVENT_MODE_RISING_EDGE);
+#        endif
+    palSetLineCallback(POINTING_DEVICE_MOTION_PIN, pointing_device_motion_pal_callback, NULL);
+}
+#    else
+/**
+ * @brief Arms the motion pin interrupt
+ *
+ * Platforms without a generic pin interrupt API should override this, and call
+ * pointing_device_motion_interrupt() from their interrupt handler.
+ */
+__attribute__((weak)) void pointing_device_motion_interrupt_init(void) {}
+#    endif
+#endif
+
 #define POINTING_DEVICE_DRIVER_CONCAT(name) name##_pointing_device_driver
 #define POINTING_DEVICE_DRIVER(name) POINTING_DEVICE_DRIVER_CONCAT(name)
 
@@ -174,6 +291,9 @@ __attribute__((weak)) void pointing_device_init(void) {
 #    else
         gpio_set_pin_input(POINTING_DEVICE_MOTION_PIN);
 #    endif
+#endif
+#ifdef POINTING_DEVICE_MOTION_INTERRUPT
+        pointing_device_motion_interrupt_init();
 #endif
     }
 
@@ -263,49 +383,86 @@ __attribute__((weak)) bool pointing_device_task(void) {
 #endif
 
     // Gather report info
-#ifdef POINTING_DEVICE_MOTION_PIN
-#    if defined(SPLIT_POINTING_ENABLE)
-#        error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
+#if defined(POINTING_DEVICE_MOTION_INTERRUPT)
+    bool motion = motion_pending;
+#    ifdef POINTING_DEVICE_MOTION_PIN
+#        ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
+    motion |= !gpio_read_pin(POINTING_DEVICE_MOTION_PIN);
+#        else
+    motion |= gpio_read_pin(POINTING_DEVICE_MOTION_PIN);
+#        endif
 #    endif
-#    ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
+    if (motion) {
+        motion_pending               = false;
+        report_mouse_t sensor_report = {.buttons = local_mouse_report.buttons};
+        sensor_report                = pointing_device_driver->get_report(sensor_report);
+        local_mouse_report.buttons   = sensor_report.buttons;
+        pointing_device_accumulate(sensor_report);
+    }
+
+    // Coalesce motion into one report per host polling interval
+    static uint32_t last_report = 0;
+    if (timer_elapsed32(last_report) < POINTING_DEVICE_REPORT_INTERVAL_MS && !pointing_device_force_send) {
+        return false;
+    }
+    last_report = timer_read32();
+    pointing_device_motion_drain(&local_mouse_report);
+#else
+#    ifdef POINTING_DEVICE_MOTION_PIN
+#        if defined(SPLIT_POINTING_ENABLE)
+#            error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
+#        endif
+#        ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
     if (!gpio_read_pin(POINTING_DEVICE_MOTION_PIN))
-#    else
+#        else
     if (gpio_read_pin(POINTING_DEVICE_MOTION_PIN))
-#    endif
+#        endif
     {
-#endif
+#    endif
 
-#if defined(SPLIT_POINTING_ENABLE)
-#    if defined(POINTING_DEVICE_COMBINED)
+#    if defined(SPLIT_POINTING_ENABLE)
+#        if defined(POINTING_DEVICE_COMBINED)
         static uint8_t old_buttons = 0;
         local_mouse_report.buttons = old_buttons;
         local_mouse_report         = pointing_device_driver->get_report(local_mouse_report);
         old_buttons                = local_mouse_report.buttons;
-#    elif defined(POINTING_DEVICE_LEFT) || defined(POINTING_DEVICE_RIGHT)
+#        elif defined(POINTING_DEVICE_LEFT) || defined(POINTING_DEVICE_RIGHT)
         local_mouse_report = POINTING_DEVICE_THIS_SIDE ? pointing_device_driver->get_report(local_mouse_report) : shared_mouse_report;
+#        else
+#            error "You need to define the side(s) the pointing device is on. POINTING_DEVICE_COMBINED / POINTING_DEVICE_LEFT / POINTING_DEVICE_RIGHT"
+#        endif
 #    else
-#        error "You need to define the side(s) the pointing device is on. POINTING_DEVICE_COMBINED / POINTING_DEVICE_LEFT / POINTING_DEVICE_RIGHT"
-#    endif
-#else
     local_mouse_report = pointing_device_driver->get_report(local_mouse_report);
-#endif // defined(SPLIT_POINTING_ENABLE)
+#    endif // defined(SPLIT_POINTING_ENABLE)
 
-#ifdef POINTING_DEVICE_MOTION_PIN
+#    ifdef POINTING_DEVICE_MOTION_PIN
     }
-#endif
+#    endif
+#endif // defined(POINTING_DEVICE_MOTION_INTERRUPT)
 
     // allow kb to intercept and modify report
 #if defined(SPLIT_POINTING_ENABLE) && defined(POINTING_DEVICE_COMBINED)
     if (is_keyboard_left()) {
         local_mouse_report  = pointing_device_adjust_by_defines(local_mouse_report);
         shared_mouse_report = pointing_device_adjust_by_defines_right(shared_mouse_report);
+#    ifdef POINTING_DEVICE_SUBPIXEL_ENABLE
+        local_mouse_report  = pointing_device_subpixel_apply(local_mouse_report);
+        shared_mouse_report = pointing_device_subpixel_apply_right(shared_mouse_report);
+#    endif
     } else {
         local_mouse_report  = pointing_device_adjust_by_defines_right(local_mouse_report);
         shared_mouse_report = pointing_device_adjust_by_defines(shared_mouse_report);
+#    ifdef POINTING_DEVICE_SUBPIXEL_ENABLE
+        local_mouse_report  = pointing_device_subpixel_apply_right(local_mouse_report);
+        shared_mouse_report = pointing_device_subpixel_apply(shared_mouse_report);
+#    endif
     }
     local_mouse_report = is_keyboard_left() ? pointing_device_task_combined_kb(local_mouse_report, shared_mouse_report) : pointing_device_task_combined_kb(shared_mouse_report, local_mouse_report);
 #else
     local_mouse_report = pointing_device_adjust_by_defines(local_mouse_report);
+#    ifdef POINTING_DEVICE_SUBPIXEL_ENABLE
+    local_mouse_report = pointing_device_subpixel_apply(local_mouse_report);
+#    endif
     local_mouse_report = pointing_device_task_kb(local_mouse_report);
 #endif
     // automatic mouse layer function
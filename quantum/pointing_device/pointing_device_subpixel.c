@@ -0,0 +1,277 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef POINTING_DEVICE_SUBPIXEL_ENABLE
+
+#    include "pointing_device_subpixel.h"
+#    include "pointing_device.h"
+#    include "progmem.h"
+
+#    if defined(SPLIT_POINTING_ENABLE) && defined(POINTING_DEVICE_COMBINED)
+#        define POINTING_DEVICE_SUBPIXEL_SIDES 2
+#    else
+#        define POINTING_DEVICE_SUBPIXEL_SIDES 1
+#    endif
+
+typedef struct {
+    pointing_device_subpixel_config_t config;
+    int32_t                           cos;         // Q16
+    int32_t                           sin;         // Q16
+    int32_t                           remainder_x; // Q16
+    int32_t                           remainder_y; // Q16
+} pointing_device_subpixel_state_t;
+
+// clang-format off
+/* sin(0..89 degrees) in Q16 */
+static const uint16_t subpixel_sin_lut[90] PROGMEM = {
+    0, 1144, 2287, 3430, 4572, 5712, 6850, 7987, 9121, 10252,
+    11380, 12505, 13626, 14742, 15855, 16962, 18064, 19161, 20252, 21336,
+    22415, 23486, 24550, 25607, 26656, 27697, 28729, 29753, 30767, 31772,
+    32768, 33754, 34729, 35693, 36647, 37590, 38521, 39441, 40348, 41243,
+    42126, 42995, 43852, 44695, 45525, 46341, 47143, 47930, 48703, 49461,
+    50203, 50931, 51643, 52339, 53020, 53684, 54332, 54963, 55578, 56175,
+    56756, 57319, 57865, 58393, 58903, 59396, 59870, 60326, 60764, 61183,
+    61584, 61966, 62328, 62672, 62997, 63303, 63589, 63856, 64104, 64332,
+    64540, 64729, 64898, 65048, 65177, 65287, 65376, 65446, 65496, 65526
+};
+
+static pointing_device_subpixel_state_t subpixel_state[POINTING_DEVICE_SUBPIXEL_SIDES] = {
+    {
+        .config = {
+            .scale              = POINTING_DEVICE_Q16(POINTING_DEVICE_SUBPIXEL_SCALE),
+            .rotation           = POINTING_DEVICE_SUBPIXEL_ROTATION,
+            .acceleration       = POINTING_DEVICE_Q16(POINTING_DEVICE_SUBPIXEL_ACCELERATION),
+            .acceleration_limit = POINTING_DEVICE_Q16(POINTING_DEVICE_SUBPIXEL_ACCELERATION_LIMIT),
+        },
+    },
+#    if POINTING_DEVICE_SUBPIXEL_SIDES > 1
+    {
+        .config = {
+            .scale              = POINTING_DEVICE_Q16(POINTING_DEVICE_SUBPIXEL_SCALE_RIGHT),
+            .rotation           = POINTING_DEVICE_SUBPIXEL_ROTATION_RIGHT,
+            .acceleration       = POINTING_DEVICE_Q16(POINTING_DEVICE_SUBPIXEL_ACCELERATION_RIGHT),
+            .acceleration_limit = POINTING_DEVICE_Q16(POINTING_DEVICE_SUBPIXEL_ACCELERATION_LIMIT_RIGHT),
+        },
+    },
+#    endif
+};
+// clang-format on
+
+static bool subpixel_initialised = false;
+
+/**
+ * @brief Looks up sine of a whole number of degrees in Q16
+ *
+ * @param[in] degrees int16_t angle
+ * @return int32_t Q16 sine
+ */
+static int32_t subpixel_sin(int16_t degrees) {
+    degrees %= 360;
+    if (degrees < 0) {
+        degrees += 360;
+    }
+
+    bool negative = degrees >= 180;
+    if (negative) {
+        degrees -= 180;
+    }
+    if (degrees > 90) {
+        degrees = 180 - degrees;
+    }
+
+    int32_t value = degrees == 90 ? 65536 : pgm_read_word(&subpixel_sin_lut[degrees]);
+    return negative ? -value : value;
+}
+
+/**
+ * @brief Applies a config to a side, recomputing the rotation coefficients
+ *
+ * @param[in] state pointing_device_subpixel_state_t of the side
+ * @param[in] config pointing_device_subpixel_config_t to apply
+ */
+static void subpixel_set_state_config(pointing_device_subpixel_state_t *state, pointing_device_subpixel_config_t config) {
+    state->config = config;
+    state->sin    = subpixel_sin(config.rotation);
+    state->cos    = subpixel_sin(config.rotation + 90);
+}
+
+static void subpixel_init(void) {
+    for (uint8_t i = 0; i < POINTING_DEVICE_SUBPIXEL_SIDES; i++) {
+        subpixel_set_state_config(&subpixel_state[i], subpixel_state[i].config);
+    }
+    subpixel_initialised = true;
+}
+
+/**
+ * @brief Converts a Q16 movement to whole counts, carrying the fraction in the remainder
+ *
+ * Rounds towards zero so that the remainder has the same sign as the movement.
+ *
+ * @param[in] movement int64_t Q16 movement, excluding remainder
+ * @param[in] remainder int32_t* Q16 remainder carried between reports
+ * @return int32_t whole counts
+ */
+static int32_t subpixel_take(int64_t movement, int32_t *remainder) {
+    int64_t total  = movement + *remainder;
+    int32_t counts = total / 65536;
+    *remainder     = total - (int64_t)counts * 65536;
+    return counts;
+}
+
+/**
+ * @brief Scales, accelerates and rotates the X and Y movement of a report
+ *
+ * @param[in] state pointing_device_subpixel_state_t of the side
+ * @param[in] mouse_report report_mouse_t to be adjusted
+ * @return report_mouse_t with adjusted values
+ */
+static report_mouse_t subpixel_apply(pointing_device_subpixel_state_t *state, report_mouse_t mouse_report) {
+    if (!subpixel_initialised) {
+        subpixel_init();
+    }
+    if (mouse_report.x == 0 && mouse_report.y == 0) {
+        return mouse_report;
+    }
+
+    int32_t x = mouse_report.x;
+    int32_t y = mouse_report.y;
+
+    // Multiplier, including acceleration by an approximation of the speed
+    int64_t multiplier = state->config.scale;
+    if (state->config.acceleration) {
+        int32_t abs_x  = x < 0 ? -x : x;
+        int32_t abs_y  = y < 0 ? -y : y;
+        int32_t speed  = abs_x > abs_y ? abs_x + abs_y / 2 : abs_y + abs_x / 2;
+        int64_t factor = 65536 + (int64_t)state->config.acceleration * speed;
+        // A limit of 0 leaves the acceleration unbounded
+        if (state->config.acceleration_limit && factor > state->config.acceleration_limit) {
+            factor = state->config.acceleration_limit;
+        }
+        multiplier = (multiplier * factor) >> 16;
+        // Beyond 32768 a single count saturates the report anyway, and the
+        // products below stay within int64_t
+        if (multiplier > INT32_MAX) {
+            multiplier = INT32_MAX;
+        } else if (multiplier < -INT32_MAX) {
+            multiplier = -INT32_MAX;
+        }
+    }
+
+    // Rotation, matching the direction of POINTING_DEVICE_ROTATION_90
+    int64_t rotated_x = (int64_t)x * state->cos + (int64_t)y * state->sin;
+    int64_t rotated_y = (int64_t)y * state->cos - (int64_t)x * state->sin;
+
+    int32_t new_x = subpixel_take((rotated_x * multiplier) >> 16, &state->remainder_x);
+    int32_t new_y = subpixel_take((rotated_y * multiplier) >> 16, &state->remainder_y);
+
+    mouse_report.x = CONSTRAIN_HID_XY(new_x);
+    mouse_report.y = CONSTRAIN_HID_XY(new_y);
+    return mouse_report;
+}
+
+/**
+ * @brief Gets the current subpixel config
+ *
+ * @return pointing_device_subpixel_config_t
+ */
+pointing_device_subpixel_config_t pointing_device_get_subpixel_config(void) {
+    return subpixel_state[0].config;
+}
+
+/**
+ * @brief Sets the subpixel config and clears any carried movement
+ *
+ * NOTE: When using POINTING_DEVICE_COMBINED this sets the config of the left side
+ *
+ * @param[in] config pointing_device_subpixel_config_t
+ */
+void pointing_device_set_subpixel_config(pointing_device_subpixel_config_t config) {
+    if (!subpixel_initialised) {
+        subpixel_init();
+    }
+    subpixel_set_state_config(&subpixel_state[0], config);
+    subpixel_state[0].remainder_x = 0;
+    subpixel_state[0].remainder_y = 0;
+}
+
+/**
+ * @brief Clears any movement carried over between reports
+ */
+void pointing_device_subpixel_reset(void) {
+    for (uint8_t i = 0; i < POINTING_DEVICE_SUBPIXEL_SIDES; i++) {
+        subpixel_state[i].remainder_x = 0;
+        subpixel_state[i].remainder_y = 0;
+    }
+}
+
+/**
+ * @brief Adjusts mouse report by the subpixel config
+ *
+ * Scales, accelerates and rotates the X and Y movement in Q16 fixed point, carrying sub-count
+ * movement over to the next report.
+ *
+ * @param[in] mouse_report report_mouse_t to be adjusted
+ * @return report_mouse_t with adjusted values
+ */
+report_mouse_t pointing_device_subpixel_apply(report_mouse_t mouse_report) {
+    return subpixel_apply(&subpixel_state[0], mouse_report);
+}
+
+#    if defined(SPLIT_POINTING_ENABLE) && defined(POINTING_DEVICE_COMBINED)
+/**
+ * @brief Gets the subpixel config of a single side
+ *
+ * NOTE: Only available when using SPLIT_POINTING_ENABLE and POINTING_DEVICE_COMBINED
+ *
+ * @param[in] left true = left, false = right.
+ * @return pointing_device_subpixel_config_t
+ */
+pointing_device_subpixel_config_t pointing_device_get_subpixel_config_on_side(bool left) {
+    return subpixel_state[left ? 0 : 1].config;
+}
+
+/**
+ * @brief Sets the subpixel config of a single side and clears any carried movement
+ *
+ * NOTE: Only available when using SPLIT_POINTING_ENABLE and POINTING_DEVICE_COMBINED
+ *
+ * @param[in] left true = left, false = right.
+ * @param[in] config pointing_device_subpixel_config_t
+ */
+void pointing_device_set_subpixel_config_on_side(bool left, pointing_device_subpixel_config_t config) {
+    if (!subpixel_initialised) {
+        subpixel_init();
+    }
+    pointing_device_subpixel_state_t *state = &subpixel_state[left ? 0 : 1];
+    subpixel_set_state_config(state, config);
+    state->remainder_x = 0;
+    state->remainder_y = 0;
+}
+
+/**
+ * @brief Adjusts mouse report by the right side subpixel config
+ *
+ * NOTE: Only available when using SPLIT_POINTING_ENABLE and POINTING_DEVICE_COMBINED
+ *
+ * @param[in] mouse_report report_mouse_t to be adjusted
+ * @return report_mouse_t with adjusted values
+ */
+report_mouse_t pointing_device_subpixel_apply_right(report_mouse_t mouse_report) {
+    return subpixel_apply(&subpixel_state[1], mouse_report);
+}
+#    endif
+
+#endif // POINTING_DEVICE_SUBPIXEL_ENABLE
@@ -0,0 +1,77 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "report.h"
+
+/* check settings and set defaults */
+#ifndef POINTING_DEVICE_SUBPIXEL_ENABLE
+#    error "POINTING_DEVICE_SUBPIXEL_ENABLE not defined! check config settings"
+#endif
+
+/* Converts a constant to Q16 fixed point at compile time */
+#define POINTING_DEVICE_Q16(value) ((int32_t)((value) * 65536))
+
+#ifndef POINTING_DEVICE_SUBPIXEL_SCALE
+#    define POINTING_DEVICE_SUBPIXEL_SCALE 1.0
+#endif
+#ifndef POINTING_DEVICE_SUBPIXEL_ROTATION
+#    define POINTING_DEVICE_SUBPIXEL_ROTATION 0
+#endif
+#ifndef POINTING_DEVICE_SUBPIXEL_ACCELERATION
+#    define POINTING_DEVICE_SUBPIXEL_ACCELERATION 0.0
+#endif
+#ifndef POINTING_DEVICE_SUBPIXEL_ACCELERATION_LIMIT
+#    define POINTING_DEVICE_SUBPIXEL_ACCELERATION_LIMIT 4.0
+#endif
+
+#ifndef POINTING_DEVICE_SUBPIXEL_SCALE_RIGHT
+#    define POINTING_DEVICE_SUBPIXEL_SCALE_RIGHT POINTING_DEVICE_SUBPIXEL_SCALE
+#endif
+#ifndef POINTING_DEVICE_SUBPIXEL_ROTATION_RIGHT
+#    define POINTING_DEVICE_SUBPIXEL_ROTATION_RIGHT POINTING_DEVICE_SUBPIXEL_ROTATION
+#endif
+#ifndef POINTING_DEVICE_SUBPIXEL_ACCELERATION_RIGHT
+#    define POINTING_DEVICE_SUBPIXEL_ACCELERATION_RIGHT POINTING_DEVICE_SUBPIXEL_ACCELERATION
+#endif
+#ifndef POINTING_DEVICE_SUBPIXEL_ACCELERATION_LIMIT_RIGHT
+#    define POINTING_DEVICE_SUBPIXEL_ACCELERATION_LIMIT_RIGHT POINTING_DEVICE_SUBPIXEL_ACCELERATION_LIMIT
+#endif
+
+/* data structure */
+typedef struct {
+    int32_t scale;              // Q16 multiplier, 65536 is 1.0
+    int16_t rotation;           // clockwise, in degrees
+    int32_t acceleration;       // Q16 increase of the multiplier per count of speed
+    int32_t acceleration_limit; // Q16 upper bound of the acceleration multiplier, 0 for no limit
+} pointing_device_subpixel_config_t;
+
+/* ----------For Setting Subpixel Config----------------------------------------------------------- */
+pointing_device_subpixel_config_t pointing_device_get_subpixel_config(void);
+void                              pointing_device_set_subpixel_config(pointing_device_subpixel_config_t config);
+void                              pointing_device_subpixel_reset(void);
+
+/* ----------For Processing Reports---------------------------------------------------------------- */
+report_mouse_t pointing_device_subpixel_apply(report_mouse_t mouse_report);
+
+#if defined(SPLIT_POINTING_ENABLE) && defined(POINTING_DEVICE_COMBINED)
+pointing_device_subpixel_config_t pointing_device_get_subpixel_config_on_side(bool left);
+void                              pointing_device_set_subpixel_config_on_side(bool left, pointing_device_subpixel_config_t config);
+report_mouse_t                    pointing_device_subpixel_apply_right(report_mouse_t mouse_report);
+#endif
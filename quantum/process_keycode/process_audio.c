@@ -5,7 +5,7 @@
 #ifndef VOICE_CHANGE_SONG
 #    define VOICE_CHANGE_SONG SONG(VOICE_CHANGE_SOUND)
 #endif
-float voice_change_song[][2] = VOICE_CHANGE_SONG;
+musical_note_t voice_change_song[] = VOICE_CHANGE_SONG;
 
 #ifndef PITCH_STANDARD_A
 #    define PITCH_STANDARD_A 440.0f
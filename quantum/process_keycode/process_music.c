@@ -68,11 +68,11 @@ static uint16_t music_sequence_interval = 100;
 #        ifndef MAJOR_SONG
 #            define MAJOR_SONG SONG(MAJOR_SOUND)
 #        endif
-float music_mode_songs[NUMBER_OF_MODES][5][2] = {CHROMATIC_SONG, GUITAR_SONG, VIOLIN_SONG, MAJOR_SONG};
-float music_on_song[][2]                      = MUSIC_ON_SONG;
-float music_off_song[][2]                     = MUSIC_OFF_SONG;
-float midi_on_song[][2]                       = MIDI_ON_SONG;
-float midi_off_song[][2]                      = MIDI_OFF_SONG;
+musical_note_t music_mode_songs[NUMBER_OF_MODES][5] = {CHROMATIC_SONG, GUITAR_SONG, VIOLIN_SONG, MAJOR_SONG};
+musical_note_t music_on_song[]                      = MUSIC_ON_SONG;
+musical_note_t music_off_song[]                     = MUSIC_OFF_SONG;
+musical_note_t midi_on_song[]                       = MIDI_ON_SONG;
+musical_note_t midi_off_song[]                      = MIDI_OFF_SONG;
 #    endif
 
 static void music_noteon(uint8_t note) {
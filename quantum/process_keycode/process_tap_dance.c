@@ -25,6 +25,7 @@
 
 static uint16_t active_td;
 static uint16_t last_tap_time;
+static uint16_t active_td_term; // tapping term of active_td, looked up on each tap
 
 void tap_dance_pair_on_each_tap(tap_dance_state_t *state, void *user_data) {
     tap_dance_pair_t *pair = (tap_dance_pair_t *)user_data;
@@ -167,6 +168,9 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
                 last_tap_time = timer_read();
                 process_tap_dance_action_on_each_tap(action);
                 active_td = action->state.finished ? 0 : keycode;
+                if (active_td) {
+                    active_td_term = GET_TAPPING_TERM(active_td, &(keyrecord_t){});
+                }
             } else {
                 process_tap_dance_action_on_each_release(action);
                 if (action->state.finished) {
@@ -186,7 +190,7 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
 void tap_dance_task(void) {
     tap_dance_action_t *action;
 
-    if (!active_td || timer_elapsed(last_tap_time) <= GET_TAPPING_TERM(active_td, &(keyrecord_t){})) return;
+    if (!active_td || timer_elapsed(last_tap_time) <= active_td_term) return;
 
     action = tap_dance_get(QK_TAP_DANCE_GET_INDEX(active_td));
     if (!action->state.interrupted) {
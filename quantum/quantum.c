@@ -88,9 +88,9 @@
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
 #    endif
-float goodbye_song[][2] = GOODBYE_SONG;
+musical_note_t goodbye_song[] = GOODBYE_SONG;
 #    ifdef DEFAULT_LAYER_SONGS
-float default_layer_songs[][16][2] = DEFAULT_LAYER_SONGS;
+musical_note_t default_layer_songs[][16] = DEFAULT_LAYER_SONGS;
 #    endif
 #endif
 
@@ -210,6 +210,7 @@ void shutdown_quantum(bool jump_to_bootloader) {
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
 #endif
+    eeconfig_flush_all();
 }
 
 void reset_keyboard(void) {
@@ -271,6 +272,11 @@ void post_process_record_quantum(keyrecord_t *record) {
     post_process_record_kb(keycode, record);
 }
 
+/* Runs a handler only for keycodes within its own range. Handlers gated this way
+ * must pass every other keycode through untouched, so skipping the call keeps
+ * the order in which the remaining handlers see a keycode unchanged. */
+#define PROCESS_KEYCODE_RANGE(is_range, handler) (!is_range(keycode) || handler(keycode, record))
+
 /* Core keycode function, hands off handling to other functions,
     then processes internal quantum keycodes, and then processes
     ACTIONs.                                                      */
@@ -340,22 +346,22 @@ bool process_record_quantum(keyrecord_t *record) {
             process_secure(keycode, record) &&
 #endif
 #if defined(SEQUENCER_ENABLE)
-            process_sequencer(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_QK_SEQUENCER, process_sequencer) &&
 #endif
 #if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
-            process_midi(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_QK_MIDI, process_midi) &&
 #endif
 #ifdef AUDIO_ENABLE
-            process_audio(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_QK_AUDIO, process_audio) &&
 #endif
 #if defined(BACKLIGHT_ENABLE)
-            process_backlight(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_QK_LIGHTING, process_backlight) &&
 #endif
 #if defined(LED_MATRIX_ENABLE)
-            process_led_matrix(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_QK_LIGHTING, process_led_matrix) &&
 #endif
 #ifdef STENO_ENABLE
-            process_steno(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_QK_STENO, process_steno) &&
 #endif
 #if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
             process_music(keycode, record) &&
@@ -385,22 +391,22 @@ bool process_record_quantum(keyrecord_t *record) {
             process_space_cadet(keycode, record) &&
 #endif
 #ifdef MAGIC_ENABLE
-            process_magic(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_QK_MAGIC, process_magic) &&
 #endif
 #ifdef GRAVE_ESC_ENABLE
             process_grave_esc(keycode, record) &&
 #endif
 #if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
-            process_underglow(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_QK_LIGHTING, process_underglow) &&
 #endif
 #if defined(RGB_MATRIX_ENABLE)
-            process_rgb_matrix(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_QK_LIGHTING, process_rgb_matrix) &&
 #endif
 #ifdef JOYSTICK_ENABLE
-            process_joystick(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_QK_JOYSTICK, process_joystick) &&
 #endif
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
-            process_programmable_button(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_QK_PROGRAMMABLE_BUTTON, process_programmable_button) &&
 #endif
 #ifdef AUTOCORRECT_ENABLE
             process_autocorrect(keycode, record) &&
@@ -415,7 +421,7 @@ bool process_record_quantum(keyrecord_t *record) {
             process_layer_lock(keycode, record) &&
 #endif
 #ifdef BLUETOOTH_ENABLE
-            process_connection(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_QK_CONNECTION, process_connection) &&
 #endif
             true)) {
         return false;
@@ -527,6 +533,7 @@ __attribute__((weak)) bool shutdown_kb(bool jump_to_bootloader) {
 
 void suspend_power_down_quantum(void) {
     suspend_power_down_kb();
+    eeconfig_flush_all();
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
 #    ifdef BACKLIGHT_ENABLE
@@ -176,6 +176,23 @@ void rgblight_check_config(void) {
     }
 }
 
+#ifdef EEPROM_ENABLE
+// rgblight_config as it is written to EEPROM
+static uint32_t rgblight_eeconfig;
+static uint8_t  rgblight_eeconfig_extended;
+
+static eeconfig_section_t rgblight_eeconfig_section = {
+    .data    = &rgblight_eeconfig,
+    .address = EECONFIG_RGBLIGHT,
+    .size    = sizeof(rgblight_eeconfig),
+};
+static eeconfig_section_t rgblight_eeconfig_extended_section = {
+    .data    = &rgblight_eeconfig_extended,
+    .address = EECONFIG_RGBLIGHT_EXTENDED,
+    .size    = sizeof(rgblight_eeconfig_extended),
+};
+#endif
+
 uint64_t eeconfig_read_rgblight(void) {
 #ifdef EEPROM_ENABLE
     return (uint64_t)((eeprom_read_dword(EECONFIG_RGBLIGHT)) | ((uint64_t)eeprom_read_byte(EECONFIG_RGBLIGHT_EXTENDED) << 32));
@@ -187,8 +204,21 @@ uint64_t eeconfig_read_rgblight(void) {
 void eeconfig_update_rgblight(uint64_t val) {
 #ifdef EEPROM_ENABLE
     rgblight_check_config();
-    eeprom_update_dword(EECONFIG_RGBLIGHT, val & 0xFFFFFFFF);
-    eeprom_update_byte(EECONFIG_RGBLIGHT_EXTENDED, (val >> 32) & 0xFF);
+    rgblight_eeconfig          = val & 0xFFFFFFFF;
+    rgblight_eeconfig_extended = (val >> 32) & 0xFF;
+    eeconfig_flush_section(&rgblight_eeconfig_section);
+    eeconfig_flush_section(&rgblight_eeconfig_extended_section);
+#endif
+}
+
+// Writes rgblight_config to EEPROM later on, together with other eeconfig changes
+static void eeconfig_flag_rgblight(void) {
+#ifdef EEPROM_ENABLE
+    rgblight_check_config();
+    rgblight_eeconfig          = rgblight_config.raw & 0xFFFFFFFF;
+    rgblight_eeconfig_extended = (rgblight_config.raw >> 32) & 0xFF;
+    eeconfig_flag_section(&rgblight_eeconfig_section);
+    eeconfig_flag_section(&rgblight_eeconfig_extended_section);
 #endif
 }
 
@@ -341,7 +371,7 @@ void rgblight_mode_eeprom_helper(uint8_t mode, bool write_to_eeprom) {
     }
     RGBLIGHT_SPLIT_SET_CHANGE_MODE;
     if (write_to_eeprom) {
-        eeconfig_update_rgblight(rgblight_config.raw);
+        eeconfig_flag_rgblight();
         dprintf("rgblight mode [EEPROM]: %u\n", rgblight_config.mode);
     } else {
         dprintf("rgblight mode [NOEEPROM]: %u\n", rgblight_config.mode);
@@ -399,7 +429,7 @@ void rgblight_enable_noeeprom(void) {
 
 void rgblight_disable(void) {
     rgblight_config.enable = 0;
-    eeconfig_update_rgblight(rgblight_config.raw);
+    eeconfig_flag_rgblight();
     dprintf("rgblight disable [EEPROM]: rgblight_config.enable = %u\n", rgblight_config.enable);
     rgblight_timer_disable();
     RGBLIGHT_SPLIT_SET_CHANGE_MODE;
@@ -487,7 +517,7 @@ void rgblight_increase_speed_helper(bool write_to_eeprom) {
     if (rgblight_config.speed < 3) rgblight_config.speed++;
     // RGBLIGHT_SPLIT_SET_CHANGE_HSVS; // NEED?
     if (write_to_eeprom) {
-        eeconfig_update_rgblight(rgblight_config.raw);
+        eeconfig_flag_rgblight();
     }
 }
 void rgblight_increase_speed(void) {
@@ -501,7 +531,7 @@ void rgblight_decrease_speed_helper(bool write_to_eeprom) {
     if (rgblight_config.speed > 0) rgblight_config.speed--;
     // RGBLIGHT_SPLIT_SET_CHANGE_HSVS; // NEED??
     if (write_to_eeprom) {
-        eeconfig_update_rgblight(rgblight_config.raw);
+        eeconfig_flag_rgblight();
     }
 }
 void rgblight_decrease_speed(void) {
@@ -585,7 +615,7 @@ void rgblight_sethsv_eeprom_helper(uint8_t hue, uint8_t sat, uint8_t val, bool w
         rgblight_config.sat = sat;
         rgblight_config.val = val;
         if (write_to_eeprom) {
-            eeconfig_update_rgblight(rgblight_config.raw);
+            eeconfig_flag_rgblight();
             dprintf("rgblight set hsv [EEPROM]: %u,%u,%u\n", rgblight_config.hue, rgblight_config.sat, rgblight_config.val);
         } else {
             dprintf("rgblight set hsv [NOEEPROM]: %u,%u,%u\n", rgblight_config.hue, rgblight_config.sat, rgblight_config.val);
@@ -608,7 +638,7 @@ uint8_t rgblight_get_speed(void) {
 void rgblight_set_speed_eeprom_helper(uint8_t speed, bool write_to_eeprom) {
     rgblight_config.speed = speed;
     if (write_to_eeprom) {
-        eeconfig_update_rgblight(rgblight_config.raw);
+        eeconfig_flag_rgblight();
         dprintf("rgblight set speed [EEPROM]: %u\n", rgblight_config.speed);
     } else {
         dprintf("rgblight set speed [NOEEPROM]: %u\n", rgblight_config.speed);
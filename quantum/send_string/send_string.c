@@ -18,18 +18,26 @@
 
 #include <ctype.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "quantum_keycodes.h"
 #include "keycode.h"
 #include "action.h"
 #include "wait.h"
 
+#if defined(NKRO_ENABLE) && defined(SEND_STRING_NKRO_PACKING)
+#    include "action_util.h"
+#    include "keycode_config.h"
+#    include "report.h"
+#    include "usb_device_state.h"
+#endif
+
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
 #    include "audio.h"
 #    ifndef BELL_SOUND
 #        define BELL_SOUND TERMINAL_SOUND
 #    endif
-float bell_song[][2] = SONG(BELL_SOUND);
+musical_note_t bell_song[] = SONG(BELL_SOUND);
 #endif
 
 // clang-format off
@@ -146,6 +154,135 @@ __attribute__((weak)) const uint8_t ascii_to_keycode_lut[128] PROGMEM = {
 // Note: we bit-pack in "reverse" order to optimize loading
 #define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
 
+#if defined(NKRO_ENABLE) && defined(SEND_STRING_NKRO_PACKING)
+/* NKRO packing state: the keys and modifiers of the run currently held down,
+ * and the weak mods to restore once the string has been typed.
+ */
+static uint8_t packed_keys[NKRO_REPORT_BITS];
+static uint8_t packed_key_count = 0;
+static uint8_t packed_mods      = 0;
+static uint8_t packed_weak_mods = 0;
+static bool    packing          = false;
+
+static inline bool send_string_can_pack(uint8_t interval) {
+    return interval == 0 && usb_device_state_get_protocol() == USB_PROTOCOL_REPORT && keymap_config.nkro;
+}
+
+/* Returns the modifiers a character needs, or 0xFF if it has to go through send_char_with_delay. */
+static uint8_t send_string_packed_mods(char ascii_code) {
+    if ((uint8_t)ascii_code >= 0x80) {
+        return 0xFF;
+    }
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    if (ascii_code == '\a') {
+        return 0xFF;
+    }
+#    endif
+    if (pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]) == KC_NO || PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code)) {
+        return 0xFF;
+    }
+
+    uint8_t mods = 0;
+    if (PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code)) {
+        mods |= MOD_BIT(KC_LEFT_SHIFT);
+    }
+    if (PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code)) {
+        mods |= MOD_BIT(KC_RIGHT_ALT);
+    }
+    return mods;
+}
+
+/* Releases the keys of the previous run, and switches to the modifiers of the next one in the same report.
+ * Releasing keys never produces text, so the host only needs the modifiers to be in place before the next press.
+ */
+static void send_string_packed_release(uint8_t mods) {
+    for (uint8_t i = 0; i < packed_key_count; i++) {
+        del_key_from_report(packed_keys[i]);
+    }
+    packed_key_count = 0;
+    packed_mods      = mods;
+    set_weak_mods(packed_weak_mods | mods);
+    send_keyboard_report();
+}
+
+/* Releases everything held by the packed runs and restores the previous weak mods. */
+static void send_string_packed_flush(void) {
+    if (!packing) {
+        return;
+    }
+    for (uint8_t i = 0; i < packed_key_count; i++) {
+        del_key_from_report(packed_keys[i]);
+    }
+    packed_key_count = 0;
+    packed_mods      = 0;
+    set_weak_mods(packed_weak_mods);
+    send_keyboard_report();
+    packing = false;
+}
+
+/* Presses a run of characters in a single NKRO report.
+ *
+ * Hosts process the NKRO bitmap in ascending usage order, so a run can only contain
+ * characters with strictly increasing keycodes that share the same modifiers. The keys
+ * of a run are released in the following report, together with the press of the next
+ * run, unless the modifiers change or a key has to be pressed again.
+ *
+ * Returns the number of characters consumed, or 0 if the first character cannot be packed.
+ */
+static uint8_t send_string_packed_run(const char *string, bool is_progmem) {
+    char    ascii_code = is_progmem ? pgm_read_byte(string) : *string;
+    uint8_t mods       = send_string_packed_mods(ascii_code);
+    if (mods == 0xFF) {
+        return 0;
+    }
+    uint8_t keycode = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+
+    if (!packing) {
+        packing          = true;
+        packed_key_count = 0;
+        packed_weak_mods = get_weak_mods();
+        packed_mods      = 0;
+    }
+
+    if (mods != packed_mods || is_key_pressed(keycode)) {
+        send_string_packed_release(mods);
+        if (is_key_pressed(keycode)) {
+            return 0;
+        }
+    }
+
+    uint8_t previous_count = packed_key_count;
+    uint8_t count          = 0;
+    uint8_t last_keycode   = 0;
+    while (ascii_code && packed_key_count < sizeof(packed_keys)) {
+        if (send_string_packed_mods(ascii_code) != packed_mods) {
+            break;
+        }
+        keycode = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+        if (keycode <= last_keycode || is_key_pressed(keycode)) {
+            break;
+        }
+
+        add_key_to_report(keycode);
+        packed_keys[packed_key_count++] = keycode;
+        last_keycode                    = keycode;
+        count++;
+
+        string++;
+        ascii_code = is_progmem ? pgm_read_byte(string) : *string;
+    }
+
+    for (uint8_t i = 0; i < previous_count; i++) {
+        del_key_from_report(packed_keys[i]);
+    }
+    packed_key_count -= previous_count;
+    memmove(packed_keys, &packed_keys[previous_count], packed_key_count);
+
+    send_keyboard_report();
+    return count;
+}
+#endif
+
 void send_string(const char *string) {
     send_string_with_delay(string, TAP_CODE_DELAY);
 }
@@ -154,6 +291,16 @@ void send_string_with_delay(const char *string, uint8_t interval) {
     while (1) {
         char ascii_code = *string;
         if (!ascii_code) break;
+#if defined(NKRO_ENABLE) && defined(SEND_STRING_NKRO_PACKING)
+        if (send_string_can_pack(interval)) {
+            uint8_t count = send_string_packed_run(string, false);
+            if (count) {
+                string += count;
+                continue;
+            }
+        }
+        send_string_packed_flush();
+#endif
         if (ascii_code == SS_QMK_PREFIX) {
             ascii_code = *(++string);
 
@@ -190,6 +337,9 @@ void send_string_with_delay(const char *string, uint8_t interval) {
 
         ++string;
     }
+#if defined(NKRO_ENABLE) && defined(SEND_STRING_NKRO_PACKING)
+    send_string_packed_flush();
+#endif
 }
 
 void send_char(char ascii_code) {
@@ -301,6 +451,16 @@ void send_string_with_delay_P(const char *string, uint8_t interval) {
     while (1) {
         char ascii_code = pgm_read_byte(string);
         if (!ascii_code) break;
+#    if defined(NKRO_ENABLE) && defined(SEND_STRING_NKRO_PACKING)
+        if (send_string_can_pack(interval)) {
+            uint8_t count = send_string_packed_run(string, true);
+            if (count) {
+                string += count;
+                continue;
+            }
+        }
+        send_string_packed_flush();
+#    endif
         if (ascii_code == SS_QMK_PREFIX) {
             ascii_code = pgm_read_byte(++string);
 
@@ -334,5 +494,8 @@ void send_string_with_delay_P(const char *string, uint8_t interval) {
 
         ++string;
     }
+#    if defined(NKRO_ENABLE) && defined(SEND_STRING_NKRO_PACKING)
+    send_string_packed_flush();
+#    endif
 }
 #endif
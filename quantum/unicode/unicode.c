@@ -23,6 +23,7 @@
 #include "host.h"
 #include "keycode.h"
 #include "wait.h"
+#include "timer.h"
 #include "send_string.h"
 #include "utf8.h"
 #include "debug.h"
@@ -63,6 +64,20 @@
 #    define UNICODE_TYPE_DELAY 10
 #endif
 
+// Number of code points that can wait in the queue for unicode_task
+#ifndef UNICODE_QUEUE_SIZE
+#    define UNICODE_QUEUE_SIZE 32
+#endif
+
+// Time after which unicode_task stops starting new queued code points, in ms
+#ifndef UNICODE_QUEUE_TASK_TIME
+#    define UNICODE_QUEUE_TASK_TIME 20
+#endif
+
+#if UNICODE_QUEUE_SIZE < 2 || UNICODE_QUEUE_SIZE > 255
+#    error "UNICODE_QUEUE_SIZE must be between 2 and 255"
+#endif
+
 unicode_config_t unicode_config;
 uint8_t          unicode_saved_mods;
 led_t            unicode_saved_led_state;
@@ -81,22 +96,22 @@ __attribute__((weak)) void unicode_input_mode_set_kb(uint8_t input_mode) {
 
 #ifdef AUDIO_ENABLE
 #    ifdef UNICODE_SONG_MAC
-static float song_mac[][2] = UNICODE_SONG_MAC;
+static musical_note_t song_mac[] = UNICODE_SONG_MAC;
 #    endif
 #    ifdef UNICODE_SONG_LNX
-static float song_lnx[][2] = UNICODE_SONG_LNX;
+static musical_note_t song_lnx[] = UNICODE_SONG_LNX;
 #    endif
 #    ifdef UNICODE_SONG_WIN
-static float song_win[][2] = UNICODE_SONG_WIN;
+static musical_note_t song_win[] = UNICODE_SONG_WIN;
 #    endif
 #    ifdef UNICODE_SONG_BSD
-static float song_bsd[][2] = UNICODE_SONG_BSD;
+static musical_note_t song_bsd[] = UNICODE_SONG_BSD;
 #    endif
 #    ifdef UNICODE_SONG_WINC
-static float song_winc[][2] = UNICODE_SONG_WINC;
+static musical_note_t song_winc[] = UNICODE_SONG_WINC;
 #    endif
 #    ifdef UNICODE_SONG_EMACS
-static float song_emacs[][2] = UNICODE_SONG_EMACS;
+static musical_note_t song_emacs[] = UNICODE_SONG_EMACS;
 #    endif
 
 static void unicode_play_song(uint8_t mode) {
@@ -164,8 +179,14 @@ uint8_t get_unicode_input_mode(void) {
     return unicode_config.input_mode;
 }
 
+static eeconfig_section_t unicode_eeconfig_section = {
+    .data    = &unicode_config.raw,
+    .address = EECONFIG_UNICODEMODE,
+    .size    = sizeof(unicode_config.raw),
+};
+
 static void persist_unicode_input_mode(void) {
-    eeprom_update_byte(EECONFIG_UNICODEMODE, unicode_config.input_mode);
+    eeconfig_flag_section(&unicode_eeconfig_section);
 }
 
 void set_unicode_input_mode(uint8_t mode) {
@@ -208,7 +229,7 @@ void unicode_input_mode_step_reverse(void) {
     cycle_unicode_input_mode(-1);
 }
 
-__attribute__((weak)) void unicode_input_start(void) {
+__attribute__((weak)) void unicode_batch_start(void) {
     unicode_saved_led_state = host_keyboard_led_state();
 
     // Note the order matters here!
@@ -225,16 +246,48 @@ __attribute__((weak)) void unicode_input_start(void) {
 
     switch (unicode_config.input_mode) {
         case UNICODE_MODE_MACOS:
+            // Unicode Hex Input takes any number of characters while the key is held
             register_code(UNICODE_KEY_MAC);
+            wait_ms(UNICODE_TYPE_DELAY);
+            break;
+        case UNICODE_MODE_WINDOWS:
+            // For increased reliability, use numpad keys for inputting digits
+            if (!unicode_saved_led_state.num_lock) {
+                tap_code(KC_NUM_LOCK);
+            }
+            break;
+    }
+}
+
+__attribute__((weak)) void unicode_batch_finish(void) {
+    switch (unicode_config.input_mode) {
+        case UNICODE_MODE_MACOS:
+            unregister_code(UNICODE_KEY_MAC);
             break;
         case UNICODE_MODE_LINUX:
-            tap_code16(UNICODE_KEY_LNX);
+            if (unicode_saved_led_state.caps_lock) {
+                tap_code(KC_CAPS_LOCK);
+            }
             break;
         case UNICODE_MODE_WINDOWS:
-            // For increased reliability, use numpad keys for inputting digits
             if (!unicode_saved_led_state.num_lock) {
                 tap_code(KC_NUM_LOCK);
             }
+            break;
+    }
+
+    set_mods(unicode_saved_mods); // Reregister previously set mods
+}
+
+/**
+ * \brief Opens the input of a single character within a batch.
+ */
+static void unicode_sequence_start(void) {
+    switch (unicode_config.input_mode) {
+        case UNICODE_MODE_LINUX:
+            tap_code16(UNICODE_KEY_LNX);
+            break;
+        case UNICODE_MODE_WINDOWS:
             register_code(KC_LEFT_ALT);
             wait_ms(UNICODE_TYPE_DELAY);
             tap_code(KC_KP_PLUS);
@@ -249,27 +302,24 @@ __attribute__((weak)) void unicode_input_start(void) {
             tap_code16(KC_8);
             tap_code16(KC_ENTER);
             break;
+        default:
+            // Nothing to open, and nothing to wait for
+            return;
     }
 
     wait_ms(UNICODE_TYPE_DELAY);
 }
 
-__attribute__((weak)) void unicode_input_finish(void) {
+/**
+ * \brief Commits a single character within a batch.
+ */
+static void unicode_sequence_finish(void) {
     switch (unicode_config.input_mode) {
-        case UNICODE_MODE_MACOS:
-            unregister_code(UNICODE_KEY_MAC);
-            break;
         case UNICODE_MODE_LINUX:
             tap_code(KC_SPACE);
-            if (unicode_saved_led_state.caps_lock) {
-                tap_code(KC_CAPS_LOCK);
-            }
             break;
         case UNICODE_MODE_WINDOWS:
             unregister_code(KC_LEFT_ALT);
-            if (!unicode_saved_led_state.num_lock) {
-                tap_code(KC_NUM_LOCK);
-            }
             break;
         case UNICODE_MODE_WINCOMPOSE:
             tap_code(KC_ENTER);
@@ -278,8 +328,16 @@ __attribute__((weak)) void unicode_input_finish(void) {
             tap_code16(KC_ENTER);
             break;
     }
+}
 
-    set_mods(unicode_saved_mods); // Reregister previously set mods
+__attribute__((weak)) void unicode_input_start(void) {
+    unicode_batch_start();
+    unicode_sequence_start();
+}
+
+__attribute__((weak)) void unicode_input_finish(void) {
+    unicode_sequence_finish();
+    unicode_batch_finish();
 }
 
 __attribute__((weak)) void unicode_input_cancel(void) {
@@ -357,13 +415,11 @@ void register_hex32(uint32_t hex) {
     }
 }
 
-void register_unicode(uint32_t code_point) {
-    if (code_point > 0x10FFFF || (code_point > 0xFFFF && unicode_config.input_mode == UNICODE_MODE_WINDOWS)) {
-        // Code point out of range, do nothing
-        return;
-    }
+static bool unicode_code_point_valid(uint32_t code_point) {
+    return code_point <= 0x10FFFF && (code_point <= 0xFFFF || unicode_config.input_mode != UNICODE_MODE_WINDOWS);
+}
 
-    unicode_input_start();
+static void register_unicode_hex(uint32_t code_point) {
     if (code_point > 0xFFFF && unicode_config.input_mode == UNICODE_MODE_MACOS) {
         // Convert code point to UTF-16 surrogate pair on macOS
         code_point -= 0x10000;
@@ -373,20 +429,149 @@ void register_unicode(uint32_t code_point) {
     } else {
         register_hex32(code_point);
     }
+}
+
+void register_unicode(uint32_t code_point) {
+    if (!unicode_code_point_valid(code_point)) {
+        // Code point out of range, do nothing
+        return;
+    }
+
+    unicode_input_start();
+    register_unicode_hex(code_point);
     unicode_input_finish();
 }
 
+/**
+ * \brief Inputs several characters.
+ *
+ * Each character is input with `unicode_input_start()` and `unicode_input_finish()`, unless
+ * UNICODE_BATCH_ENABLE is defined, in which case the host is set up only once for all of them.
+ *
+ * \param next Callback returning the next code point, or a negative value once there are none left.
+ * \param state Passed on to the callback.
+ */
+static void register_unicode_code_points(int32_t (*next)(void *state), void *state) {
+    int32_t code_point;
+
+#ifdef UNICODE_BATCH_ENABLE
+    bool started = false;
+
+    while ((code_point = next(state)) >= 0) {
+        if (!unicode_code_point_valid(code_point)) {
+            continue;
+        }
+        if (!started) {
+            unicode_batch_start();
+            started = true;
+        }
+        unicode_sequence_start();
+        register_unicode_hex(code_point);
+        unicode_sequence_finish();
+    }
+
+    if (started) {
+        unicode_batch_finish();
+    }
+#else
+    while ((code_point = next(state)) >= 0) {
+        register_unicode(code_point);
+    }
+#endif
+}
+
+static int32_t next_utf8_code_point(void *state) {
+    const char **str = (const char **)state;
+
+    while (**str) {
+        int32_t code_point = 0;
+        *str               = decode_utf8(*str, &code_point);
+
+        if (code_point >= 0) {
+            return code_point;
+        }
+    }
+    return -1;
+}
+
 void send_unicode_string(const char *str) {
     if (!str) {
         return;
     }
 
-    while (*str) {
-        int32_t code_point = 0;
-        str                = decode_utf8(str, &code_point);
+    register_unicode_code_points(next_utf8_code_point, &str);
+}
 
-        if (code_point >= 0) {
-            register_unicode(code_point);
+static uint32_t unicode_queue[UNICODE_QUEUE_SIZE];
+static uint8_t  unicode_queue_head;
+static uint8_t  unicode_queue_tail;
+
+static uint8_t unicode_queue_count(void) {
+    return (unicode_queue_head + UNICODE_QUEUE_SIZE - unicode_queue_tail) % UNICODE_QUEUE_SIZE;
+}
+
+bool queue_unicode(uint32_t code_point) {
+    if (unicode_queue_count() >= UNICODE_QUEUE_SIZE - 1) {
+        return false;
+    }
+
+    unicode_queue[unicode_queue_head] = code_point;
+    unicode_queue_head                = (unicode_queue_head + 1) % UNICODE_QUEUE_SIZE;
+    return true;
+}
+
+bool queue_unicode_string(const char *str) {
+    if (!str) {
+        return true;
+    }
+
+    // Make sure the whole string fits before queueing any of it
+    const char *counted = str;
+    uint8_t     space   = UNICODE_QUEUE_SIZE - 1 - unicode_queue_count();
+    while (next_utf8_code_point(&counted) >= 0) {
+        if (space-- == 0) {
+            return false;
         }
     }
+
+    int32_t code_point;
+    while ((code_point = next_utf8_code_point(&str)) >= 0) {
+        queue_unicode(code_point);
+    }
+    return true;
+}
+
+bool is_unicode_queue_empty(void) {
+    return unicode_queue_head == unicode_queue_tail;
+}
+
+typedef struct {
+    uint16_t start;
+    bool     first;
+} unicode_task_state_t;
+
+static int32_t next_queued_code_point(void *state) {
+    unicode_task_state_t *task = (unicode_task_state_t *)state;
+
+    if (is_unicode_queue_empty()) {
+        return -1;
+    }
+    // Always input at least one character, then only while there is time left
+    if (!task->first && timer_elapsed(task->start) >= UNICODE_QUEUE_TASK_TIME) {
+        return -1;
+    }
+    task->first = false;
+
+    uint32_t code_point = unicode_queue[unicode_queue_tail];
+    unicode_queue_tail  = (unicode_queue_tail + 1) % UNICODE_QUEUE_SIZE;
+    return code_point;
+}
+
+void unicode_task(void) {
+    if (is_unicode_queue_empty()) {
+        return;
+    }
+
+    unicode_task_state_t task = {.start = timer_read(), .first = true};
+    register_unicode_code_points(next_queued_code_point, &task);
 }
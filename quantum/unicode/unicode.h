@@ -17,6 +17,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "unicode_keycodes.h"
 
 /**
@@ -98,6 +99,18 @@ void unicode_input_start(void);
  */
 void unicode_input_finish(void);
 
+/**
+ * \brief Prepare the host for a string of Unicode characters, by setting the lock keys the input mode needs and clearing the mods.
+ *
+ * Called once per string by `send_unicode_string()` and `unicode_task()`, and for each character by the default `unicode_input_start()`.
+ */
+void unicode_batch_start(void);
+
+/**
+ * \brief Restore the lock keys and mods changed by `unicode_batch_start()`.
+ */
+void unicode_batch_finish(void);
+
 /**
  * \brief Cancel the Unicode input sequence. The exact behavior depends on the currently selected input mode.
  */
@@ -127,8 +140,38 @@ void register_unicode(uint32_t code_point);
 /**
  * \brief Send a string containing Unicode characters.
  *
+ * The host is set up only once for the whole string, with one input sequence per character.
+ *
  * \param str The string to send.
  */
 void send_unicode_string(const char *str);
 
+/**
+ * \brief Queue a single Unicode character, to be input by `unicode_task()` without blocking the caller.
+ *
+ * \param code_point The code point of the character to queue.
+ *
+ * \return `false` if the queue is full and the character was dropped.
+ */
+bool queue_unicode(uint32_t code_point);
+
+/**
+ * \brief Queue a string containing Unicode characters, to be input by `unicode_task()` without blocking the caller.
+ *
+ * \param str The string to queue.
+ *
+ * \return `false` if the whole string does not fit in the queue, in which case none of it is queued.
+ */
+bool queue_unicode_string(const char *str);
+
+/**
+ * \brief Check whether all queued characters have been input.
+ */
+bool is_unicode_queue_empty(void);
+
+/**
+ * \brief Input queued characters for up to `UNICODE_QUEUE_TASK_TIME` milliseconds, and at least one. Called from the main loop.
+ */
+void unicode_task(void);
+
 /** \} */
@@ -57,6 +57,10 @@
 #    include "led_matrix.h"
 #endif
 
+#if defined(KEY_TRACE_ENABLE)
+#    include "key_trace.h"
+#endif
+
 // Can be called in an overriding via_init_kb() to test if keyboard level code usage of
 // EEPROM is invalid and use/save defaults.
 bool via_eeprom_is_valid(void) {
@@ -144,7 +148,7 @@ void via_set_layout_options(uint32_t value) {
 }
 
 #if defined(AUDIO_ENABLE)
-float via_device_indication_song[][2] = SONG(STARTUP_SOUND);
+musical_note_t via_device_indication_song[] = SONG(STARTUP_SOUND);
 #endif // AUDIO_ENABLE
 
 // Used by VIA to tell a device to flash LEDs (or do something else) when that
@@ -276,16 +280,11 @@ __attribute__((weak)) bool via_command_kb(uint8_t *data, uint8_t length) {
     return false;
 }
 
-void raw_hid_receive(uint8_t *data, uint8_t length) {
+// Handles a single command in place, with the reply written back into data.
+static void via_command(uint8_t *data, uint8_t length) {
     uint8_t *command_id   = &(data[0]);
     uint8_t *command_data = &(data[1]);
 
-    // If via_command_kb() returns true, the command was fully
-    // handled, including calling raw_hid_send()
-    if (via_command_kb(data, length)) {
-        return;
-    }
-
     switch (*command_id) {
         case id_get_protocol_version: {
             command_data[0] = VIA_PROTOCOL_VERSION >> 8;
@@ -374,7 +373,9 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             break;
         }
         case id_dynamic_keymap_set_keycode: {
-            dynamic_keymap_set_keycode(command_data[0], command_data[1], command_data[2], (command_data[3] << 8) | command_data[4]);
+            if (!dynamic_keymap_set_keycode(command_data[0], command_data[1], command_data[2], (command_data[3] << 8) | command_data[4])) {
+                *command_id = id_unhandled;
+            }
             break;
         }
         case id_dynamic_keymap_reset: {
@@ -433,7 +434,9 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
         case id_dynamic_keymap_set_buffer: {
             uint16_t offset = (command_data[0] << 8) | command_data[1];
             uint16_t size   = command_data[2]; // size <= 28
-            dynamic_keymap_set_buffer(offset, size, &command_data[3]);
+            if (!dynamic_keymap_set_buffer(offset, size, &command_data[3])) {
+                *command_id = id_unhandled;
+            }
             break;
         }
 #ifdef ENCODER_MAP_ENABLE
@@ -447,6 +450,14 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             dynamic_keymap_set_encoder(command_data[0], command_data[1], command_data[2] != 0, (command_data[3] << 8) | command_data[4]);
             break;
         }
+#endif
+#ifdef KEY_TRACE_ENABLE
+        case id_key_trace_get_buffer: {
+            uint16_t offset = (command_data[0] << 8) | command_data[1];
+            uint16_t size   = command_data[2]; // size <= 28
+            key_trace_get_buffer(offset, size, &command_data[3]);
+            break;
+        }
 #endif
         default: {
             // The command ID is not known
@@ -455,6 +466,148 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             break;
         }
     }
+}
+
+// Number of bytes taken up by a command within a batch, including its reply,
+// or 0 if the command is not supported in a batch or does not fit.
+static uint8_t via_batch_command_size(const uint8_t *command, uint8_t available) {
+    uint8_t size = 0;
+
+    if (available < 2) {
+        return 0;
+    }
+
+    switch (command[0]) {
+        case id_get_protocol_version: {
+            size = 3;
+            break;
+        }
+        case id_get_keyboard_value: {
+            switch (command[1]) {
+                case id_uptime:
+                case id_layout_options:
+                case id_firmware_version: {
+                    size = 6;
+                    break;
+                }
+                case id_switch_matrix_state: {
+                    if (available < 3) {
+                        break;
+                    }
+                    // Same number of rows as via_command() writes
+                    uint8_t row_size = (MATRIX_COLS + 7) / 8;
+                    uint8_t offset   = command[2];
+                    uint8_t rows     = 28 / row_size;
+                    if (offset >= MATRIX_ROWS) {
+                        rows = 0;
+                    } else if (rows > MATRIX_ROWS - offset) {
+                        rows = MATRIX_ROWS - offset;
+                    }
+                    size = 3 + rows * row_size;
+                    break;
+                }
+            }
+            break;
+        }
+        case id_set_keyboard_value: {
+            switch (command[1]) {
+                case id_layout_options: {
+                    size = 6;
+                    break;
+                }
+                case id_device_indication: {
+                    size = 3;
+                    break;
+                }
+            }
+            break;
+        }
+        case id_dynamic_keymap_get_keycode:
+        case id_dynamic_keymap_set_keycode:
+#ifdef ENCODER_MAP_ENABLE
+        case id_dynamic_keymap_get_encoder:
+        case id_dynamic_keymap_set_encoder:
+#endif
+        {
+            size = 6;
+            break;
+        }
+        case id_dynamic_keymap_macro_get_count:
+        case id_dynamic_keymap_get_layer_count: {
+            size = 2;
+            break;
+        }
+        case id_dynamic_keymap_macro_get_buffer_size: {
+            size = 3;
+            break;
+        }
+        case id_dynamic_keymap_macro_get_buffer:
+        case id_dynamic_keymap_macro_set_buffer:
+        case id_dynamic_keymap_get_buffer:
+        case id_dynamic_keymap_set_buffer: {
+            if (available >= 4 && command[3] <= available - 4) {
+                size = 4 + command[3];
+            }
+            break;
+        }
+    }
+
+    return size <= available ? size : 0;
+}
+
+static bool via_batch_error = false;
+
+// Handles each command of an id_batch report in turn.
+// Returns false if the reply is deferred to a later report of the sequence.
+static bool via_batch_command(uint8_t *data, uint8_t length) {
+    uint8_t *flags   = &(data[1]);
+    uint8_t *count   = &(data[2]);
+    uint8_t  offset  = 3;
+    uint8_t  handled = 0;
+
+    while (handled < *count && offset < length) {
+        uint8_t *command = &(data[offset]);
+        uint8_t  size    = via_batch_command_size(command, length - offset);
+        if (size == 0) {
+            *command = id_unhandled;
+            break;
+        }
+        via_command(command, size);
+        if (*command == id_unhandled) {
+            break;
+        }
+        offset += size;
+        handled++;
+    }
+
+    if (handled < *count) {
+        via_batch_error = true;
+    }
+    *count = handled;
+
+    if (*flags & id_batch_more) {
+        return false;
+    }
+
+    *flags = via_batch_error ? id_batch_error : 0;
+    via_batch_error = false;
+    return true;
+}
+
+void raw_hid_receive(uint8_t *data, uint8_t length) {
+    // If via_command_kb() returns true, the command was fully
+    // handled, including calling raw_hid_send()
+    if (via_command_kb(data, length)) {
+        return;
+    }
+
+    if (data[0] == id_batch) {
+        if (!via_batch_command(data, length)) {
+            return;
+        }
+    } else {
+        via_command(data, length);
+    }
 
     // Return the same buffer, optionally with values changed
     // (i.e. returning state to the host, or the unhandled state).
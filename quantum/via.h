@@ -93,9 +93,29 @@ enum via_command_id {
     id_dynamic_keymap_set_buffer            = 0x13,
     id_dynamic_keymap_get_encoder           = 0x14,
     id_dynamic_keymap_set_encoder           = 0x15,
+    id_batch                                = 0x16,
+    id_key_trace_get_buffer                 = 0x17,
     id_unhandled                            = 0xFF,
 };
 
+// id_batch packs several commands into one report:
+// data = [ id_batch, flags, count, command, command, ... ]
+// Each command is laid out and answered in place as it would be in a report
+// of its own, but only takes up as many bytes as it needs, so for example
+// four id_dynamic_keymap_get_keycode fit into a single report.
+// The reply sets count to the number of commands which were processed.
+// Processing stops at the first command which is not supported within a
+// batch or does not fit the rest of the report, and its ID is replaced
+// with id_unhandled.
+enum via_batch_flags {
+    // Sent by the host: more reports follow, and only the last one of the
+    // sequence (the first without this flag) is answered.
+    id_batch_more = 0x01,
+    // Set in the reply: a command of this report or one of the unanswered
+    // reports before it was not handled.
+    id_batch_error = 0x02,
+};
+
 enum via_keyboard_value_id {
     id_uptime              = 0x01,
     id_layout_options      = 0x02,
@@ -18,11 +18,12 @@ void MockBackingStore::reset_instance() {
     backing_max_write_count   = 0;
     backing_total_write_count = 0;
 
-    backing_init_invoke_count   = 0;
-    backing_unlock_invoke_count = 0;
-    backing_erase_invoke_count  = 0;
-    backing_write_invoke_count  = 0;
-    backing_lock_invoke_count   = 0;
+    backing_init_invoke_count        = 0;
+    backing_unlock_invoke_count      = 0;
+    backing_erase_invoke_count       = 0;
+    backing_erase_range_invoke_count = 0;
+    backing_write_invoke_count       = 0;
+    backing_lock_invoke_count        = 0;
 
     init_success_callback   = [](std::uint64_t) { return true; };
     erase_success_callback  = [](std::uint64_t) { return true; };
@@ -31,6 +32,12 @@ void MockBackingStore::reset_instance() {
     lock_success_callback   = [](std::uint64_t) { return true; };
 
     write_log.clear();
+
+    erasing               = false;
+    erasing_address       = 0;
+    erasing_length        = 0;
+    erase_latency         = 0;
+    erase_polls_remaining = 0;
 }
 
 bool MockBackingStore::init(void) {
@@ -75,8 +82,59 @@ bool MockBackingStore::erase(void) {
     return true;
 }
 
+bool MockBackingStore::erase_range(uint32_t address, uint32_t length) {
+    ++backing_erase_range_invoke_count;
+    EXPECT_FALSE(erasing) << "Erase was attempted while another was in progress";
+
+    EXPECT_TRUE(address % BACKING_STORE_ERASE_SIZE == 0) << "Supplied address was not aligned with the backing store erase size";
+    EXPECT_TRUE(length % BACKING_STORE_ERASE_SIZE == 0) << "Supplied length was not a multiple of the backing store erase size";
+    EXPECT_TRUE(address + length <= WEAR_LEVELING_BACKING_SIZE) << "Address would result of out-of-bounds access";
+    EXPECT_FALSE(is_locked()) << "Erase was attempted without being unlocked first";
+
+    // Erase each slot in the range
+    for (std::size_t i = address / BACKING_STORE_WRITE_SIZE; i < (address + length) / BACKING_STORE_WRITE_SIZE; ++i) {
+        // Drop out of erase early with failure if we need to, leaving the range partially erased
+        if (erase_success_callback && !erase_success_callback(backing_erase_range_invoke_count)) {
+            return false;
+        }
+
+        backing_storage[i].erase();
+    }
+
+    ++backing_erasure_count;
+    return true;
+}
+
+#ifdef WEAR_LEVELING_DUAL_BANK
+bool MockBackingStore::begin_erase_range(uint32_t address, uint32_t length) {
+    EXPECT_FALSE(erasing) << "Erase was attempted while another was in progress";
+    EXPECT_FALSE(is_locked()) << "Erase was attempted without being unlocked first";
+
+    // The range is checked and erased once the erase completes
+    erasing               = true;
+    erasing_address       = address;
+    erasing_length        = length;
+    erase_polls_remaining = erase_latency;
+    return true;
+}
+
+backing_store_erase_status_t MockBackingStore::poll_erase(void) {
+    if (!erasing) {
+        return BACKING_STORE_ERASE_DONE;
+    }
+    if (erase_polls_remaining > 0) {
+        --erase_polls_remaining;
+        return BACKING_STORE_ERASE_BUSY;
+    }
+
+    erasing = false;
+    return erase_range(erasing_address, erasing_length) ? BACKING_STORE_ERASE_DONE : BACKING_STORE_ERASE_FAILED;
+}
+#endif // WEAR_LEVELING_DUAL_BANK
+
 bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
     ++backing_write_invoke_count;
+    EXPECT_FALSE(erasing) << "Write was attempted while an erase was in progress";
 
     // precondition: value's buffer size already matches BACKING_STORE_WRITE_SIZE
     EXPECT_TRUE(address % BACKING_STORE_WRITE_SIZE == 0) << "Supplied address was not aligned with the backing store integral size";
@@ -114,6 +172,7 @@ bool MockBackingStore::lock(void) {
 }
 
 bool MockBackingStore::read(uint32_t address, backing_store_int_t& value) const {
+    EXPECT_FALSE(erasing) << "Read was attempted while an erase was in progress";
     // precondition: value's buffer size already matches BACKING_STORE_WRITE_SIZE
     EXPECT_TRUE(address % BACKING_STORE_WRITE_SIZE == 0) << "Supplied address was not aligned with the backing store integral size";
     EXPECT_TRUE(address + BACKING_STORE_WRITE_SIZE <= WEAR_LEVELING_BACKING_SIZE) << "Address would result of out-of-bounds access";
@@ -141,6 +200,20 @@ extern "C" bool backing_store_erase(void) {
     return MockBackingStore::Instance().erase();
 }
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+extern "C" bool backing_store_erase_range(uint32_t address, uint32_t length) {
+    return MockBackingStore::Instance().erase_range(address, length);
+}
+
+extern "C" bool backing_store_begin_erase_range(uint32_t address, uint32_t length) {
+    return MockBackingStore::Instance().begin_erase_range(address, length);
+}
+
+extern "C" backing_store_erase_status_t backing_store_poll_erase(void) {
+    return MockBackingStore::Instance().poll_erase();
+}
+#endif // WEAR_LEVELING_DUAL_BANK
+
 extern "C" bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return MockBackingStore::Instance().write(address, value);
 }
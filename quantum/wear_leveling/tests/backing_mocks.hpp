@@ -90,10 +90,19 @@ class MockBackingStore {
     // The write log for the backing store
     std::vector<MockBackingStoreLogEntry> write_log;
 
+    // The range of the non-blocking erase in progress, if any
+    bool          erasing;
+    std::uint32_t erasing_address;
+    std::uint32_t erasing_length;
+    // The number of polls a non-blocking erase remains busy for, and the number left for the erase in progress
+    std::uint64_t erase_latency;
+    std::uint64_t erase_polls_remaining;
+
     // The number of times each API was invoked
     std::uint64_t backing_init_invoke_count;
     std::uint64_t backing_unlock_invoke_count;
     std::uint64_t backing_erase_invoke_count;
+    std::uint64_t backing_erase_range_invoke_count;
     std::uint64_t backing_write_invoke_count;
     std::uint64_t backing_lock_invoke_count;
 
@@ -141,6 +150,9 @@ class MockBackingStore {
     std::uint64_t erase_invoke_count() const {
         return backing_erase_invoke_count;
     }
+    std::uint64_t erase_range_invoke_count() const {
+        return backing_erase_range_invoke_count;
+    }
     std::uint64_t write_invoke_count() const {
         return backing_write_invoke_count;
     }
@@ -154,11 +166,19 @@ class MockBackingStore {
     bool is_locked() const {
         return locked;
     }
+    bool is_erasing() const {
+        return erasing;
+    }
 
     // APIs for the backing store
     bool init();
     bool unlock();
     bool erase();
+    bool erase_range(std::uint32_t address, std::uint32_t length);
+#ifdef WEAR_LEVELING_DUAL_BANK
+    bool                         begin_erase_range(std::uint32_t address, std::uint32_t length);
+    backing_store_erase_status_t poll_erase();
+#endif // WEAR_LEVELING_DUAL_BANK
     bool write(std::uint32_t address, backing_store_int_t value);
     bool lock();
     bool read(std::uint32_t address, backing_store_int_t& value) const;
@@ -180,6 +200,11 @@ class MockBackingStore {
         lock_success_callback = callback;
     }
 
+    // Number of times a non-blocking erase reports itself as busy before completing
+    void set_erase_latency(std::uint64_t polls) {
+        erase_latency = polls;
+    }
+
     auto storage_begin() const -> decltype(backing_storage.begin()) {
         return backing_storage.begin();
     }
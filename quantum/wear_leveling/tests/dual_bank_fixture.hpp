@@ -0,0 +1,70 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+#include "gtest/gtest.h"
+#include "backing_mocks.hpp"
+
+// Number of backing store elements in each bank and erase sector
+using BANK_ELEMENT_COUNT   = std::integral_constant<std::size_t, (WEAR_LEVELING_BANK_SIZE / sizeof(backing_store_int_t))>;
+using SECTOR_ELEMENT_COUNT = std::integral_constant<std::size_t, (BACKING_STORE_ERASE_SIZE / sizeof(backing_store_int_t))>;
+// Number of single-byte writes which fit in the write log of a bank
+using LOG_ENTRY_COUNT = std::integral_constant<std::size_t, ((WEAR_LEVELING_BANK_SIZE - WEAR_LEVELING_LOGICAL_SIZE - WEAR_LEVELING_BANK_HEADER_SIZE) / BACKING_STORE_WRITE_SIZE)>;
+
+/**
+ * Common fixture for the dual-bank tests, keeping track of the expected logical contents.
+ */
+class WearLevelingDualBankFixture : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        MockBackingStore::Instance().set_erase_latency(erase_latency());
+        wear_leveling_init();
+        std::fill(verify_data.begin(), verify_data.end(), 0);
+    }
+
+    void TearDown() override {
+        // Let any erase still in progress complete before the backing store is reset
+        MockBackingStore::Instance().set_erase_callback(nullptr);
+        wear_leveling_init();
+    }
+
+    // Number of polls each erase remains busy for
+    virtual std::uint64_t erase_latency() const {
+        return 0;
+    }
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> verify_data;
+
+    wear_leveling_status_t test_write(const uint32_t address, uint8_t value) {
+        verify_data[address] = value;
+        return wear_leveling_write(address, &value, sizeof(value));
+    }
+
+    void verify_contents() {
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> actual;
+        EXPECT_EQ(wear_leveling_read(0, actual.data(), actual.size()), WEAR_LEVELING_SUCCESS);
+        EXPECT_EQ(actual, verify_data);
+    }
+
+    // Writes until the log of the active bank overflows
+    void fill_log(uint8_t seed) {
+        for (std::size_t i = 0; i < LOG_ENTRY_COUNT::value - 1; ++i) {
+            ASSERT_EQ(test_write(i % WEAR_LEVELING_LOGICAL_SIZE, (uint8_t)(seed + i)), WEAR_LEVELING_SUCCESS);
+        }
+        ASSERT_EQ(test_write(0, (uint8_t)(seed - 1)), WEAR_LEVELING_CONSOLIDATED);
+    }
+
+    // Runs the background task while idle until it has nothing left to do, returning the number of calls that did work
+    std::size_t run_task() {
+        std::size_t steps = 0;
+        while (wear_leveling_task(true)) {
+            ++steps;
+        }
+        return steps;
+    }
+
+    static bool bank_is_blank(std::size_t bank) {
+        auto begin = MockBackingStore::Instance().storage_begin() + bank * BANK_ELEMENT_COUNT::value;
+        return std::all_of(begin, begin + BANK_ELEMENT_COUNT::value, [](const MockBackingStoreElement& e) { return e.is_erased(); });
+    }
+};
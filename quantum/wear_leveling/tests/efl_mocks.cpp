@@ -0,0 +1,91 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <algorithm>
+#include <numeric>
+#include "gtest/gtest.h"
+#include "efl_mocks.hpp"
+
+EFlashDriver EFLD1;
+
+void MockFlash::reset_instance(std::vector<std::uint32_t> sizes) {
+    sector_sizes = sizes;
+    memory.assign(std::accumulate(sizes.begin(), sizes.end(), 0u), 0xFF);
+    descriptor = {
+        .attributes    = FLASH_ATTR_ERASED_IS_ONE,
+        .page_size     = 0,
+        .sectors_count = (flash_sector_t)sizes.size(),
+        .sectors_size  = 0,
+        .address       = memory.data(),
+        .size          = (std::uint32_t)memory.size(),
+    };
+    erased_sectors.clear();
+    erase_pending     = false;
+    overlapping_erase = false;
+}
+
+flash_offset_t MockFlash::sector_offset(flash_sector_t sector) const {
+    return std::accumulate(sector_sizes.begin(), sector_sizes.begin() + sector, 0u);
+}
+
+extern "C" msg_t eflStart(EFlashDriver *, const void *) {
+    return HAL_RET_SUCCESS;
+}
+
+extern "C" void eflStop(EFlashDriver *) {}
+
+extern "C" const flash_descriptor_t *flashGetDescriptor(BaseFlash *) {
+    return &MockFlash::Instance().descriptor;
+}
+
+extern "C" flash_error_t flashStartEraseSector(BaseFlash *, flash_sector_t sector) {
+    MockFlash &flash = MockFlash::Instance();
+    if (flash.erase_pending) {
+        flash.overlapping_erase = true;
+        return FLASH_BUSY_ERASING;
+    }
+    auto begin = flash.memory.begin() + flash.sector_offset(sector);
+    std::fill(begin, begin + flash.sector_sizes[sector], 0xFF);
+    flash.erased_sectors.push_back(sector);
+    flash.erase_pending = true;
+    return FLASH_NO_ERROR;
+}
+
+// Each erase stays busy for one query
+extern "C" flash_error_t flashQueryErase(BaseFlash *, uint32_t *msec) {
+    MockFlash &flash = MockFlash::Instance();
+    *msec            = 1;
+    if (flash.erase_pending) {
+        flash.erase_pending = false;
+        return FLASH_BUSY_ERASING;
+    }
+    return FLASH_NO_ERROR;
+}
+
+extern "C" flash_error_t flashWaitErase(BaseFlash *) {
+    MockFlash::Instance().erase_pending = false;
+    return FLASH_NO_ERROR;
+}
+
+extern "C" flash_error_t flashProgram(BaseFlash *, flash_offset_t offset, size_t n, const uint8_t *pp) {
+    MockFlash &flash = MockFlash::Instance();
+    for (size_t i = 0; i < n; ++i) {
+        flash.memory[offset + i] &= pp[i];
+    }
+    return FLASH_NO_ERROR;
+}
+
+extern "C" flash_offset_t flashGetSectorOffset(BaseFlash *, flash_sector_t sector) {
+    return MockFlash::Instance().sector_offset(sector);
+}
+
+extern "C" uint32_t flashGetSectorSize(BaseFlash *, flash_sector_t sector) {
+    return MockFlash::Instance().sector_sizes[sector];
+}
+
+extern "C" void *flashGetOffsetAddress(BaseFlash *, flash_offset_t offset) {
+    return &MockFlash::Instance().memory[offset];
+}
+
+extern "C" void chSysHalt(const char *reason) {
+    ADD_FAILURE() << "chSysHalt: " << reason;
+}
@@ -0,0 +1,30 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "hal.h"
+
+/**
+ * Embedded flash made of sectors of the given sizes, erased to 0xFF, where programming can only clear bits.
+ */
+class MockFlash {
+   public:
+    static MockFlash& Instance() {
+        static MockFlash instance;
+        return instance;
+    }
+
+    void reset_instance(std::vector<std::uint32_t> sector_sizes);
+
+    flash_offset_t sector_offset(flash_sector_t sector) const;
+
+    std::vector<std::uint32_t> sector_sizes;
+    std::vector<std::uint8_t>  memory;
+    flash_descriptor_t         descriptor;
+    // Every sector erased, in order
+    std::vector<flash_sector_t> erased_sectors;
+    bool                        erase_pending = false;
+    // Set when an erase was started while another one was still pending
+    bool overlapping_erase = false;
+};
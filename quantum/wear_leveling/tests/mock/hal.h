@@ -0,0 +1,66 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+// Stand-in for the parts of the ChibiOS EFL driver used by wear_leveling_efl.c, see efl_mocks.cpp
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t flash_offset_t;
+typedef uint16_t flash_sector_t;
+typedef int32_t  msg_t;
+
+typedef enum {
+    FLASH_NO_ERROR = 0,
+    FLASH_BUSY_ERASING,
+    FLASH_ERROR_READ,
+    FLASH_ERROR_PROGRAM,
+    FLASH_ERROR_ERASE,
+    FLASH_ERROR_VERIFY,
+    FLASH_ERROR_HW_FAILURE,
+    FLASH_ERROR_UNIMPLEMENTED,
+} flash_error_t;
+
+#define FLASH_ATTR_ERASED_IS_ONE 0x00000001
+#define HAL_RET_SUCCESS 0
+
+typedef struct {
+    uint32_t       attributes;
+    uint32_t       page_size;
+    flash_sector_t sectors_count;
+    uint32_t       sectors_size;
+    uint8_t *      address;
+    uint32_t       size;
+} flash_descriptor_t;
+
+typedef struct {
+    int unused;
+} BaseFlash;
+
+typedef struct {
+    BaseFlash base;
+} EFlashDriver;
+
+extern EFlashDriver EFLD1;
+
+msg_t                     eflStart(EFlashDriver *eflp, const void *config);
+void                      eflStop(EFlashDriver *eflp);
+const flash_descriptor_t *flashGetDescriptor(BaseFlash *flash);
+flash_error_t             flashStartEraseSector(BaseFlash *flash, flash_sector_t sector);
+flash_error_t             flashQueryErase(BaseFlash *flash, uint32_t *msec);
+flash_error_t             flashWaitErase(BaseFlash *flash);
+flash_error_t             flashProgram(BaseFlash *flash, flash_offset_t offset, size_t n, const uint8_t *pp);
+flash_offset_t            flashGetSectorOffset(BaseFlash *flash, flash_sector_t sector);
+uint32_t                  flashGetSectorSize(BaseFlash *flash, flash_sector_t sector);
+void *                    flashGetOffsetAddress(BaseFlash *flash, flash_offset_t offset);
+void                      chSysHalt(const char *reason);
+
+#ifdef __cplusplus
+}
+#endif
@@ -63,4 +63,123 @@ wear_leveling_8byte_SRC := \
 	$(wear_leveling_common_SRC) \
 	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp
 wear_leveling_8byte_INC := \
-	$(wear_leveling_common_INC)
\ No newline at end of file
+	$(wear_leveling_common_INC)
+
+wear_leveling_dual_bank_2byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DWEAR_LEVELING_DUAL_BANK \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DBACKING_STORE_ERASE_SIZE=16 \
+	-DWEAR_LEVELING_BACKING_SIZE=128 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=16
+wear_leveling_dual_bank_2byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_dual_bank.cpp
+wear_leveling_dual_bank_2byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_dual_bank_8byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DWEAR_LEVELING_DUAL_BANK \
+	-DBACKING_STORE_WRITE_SIZE=8 \
+	-DBACKING_STORE_ERASE_SIZE=32 \
+	-DWEAR_LEVELING_BACKING_SIZE=256 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=32
+wear_leveling_dual_bank_8byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_dual_bank.cpp
+wear_leveling_dual_bank_8byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_erase_scheduler_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DWEAR_LEVELING_DUAL_BANK \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DBACKING_STORE_ERASE_SIZE=16 \
+	-DWEAR_LEVELING_BACKING_SIZE=128 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=16
+wear_leveling_erase_scheduler_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_erase_scheduler.cpp
+wear_leveling_erase_scheduler_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_efl_DEFS := \
+	-DWEAR_LEVELING_TESTS \
+	-DWEAR_LEVELING_DUAL_BANK \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DBACKING_STORE_ERASE_SIZE=256 \
+	-DWEAR_LEVELING_BACKING_SIZE=1024 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=128 \
+	-DWEAR_LEVELING_EFL_FLASH_SIZE=0x100000 \
+	-include $(PLATFORM_PATH)/chibios/drivers/wear_leveling/wear_leveling_efl_config.h
+wear_leveling_efl_SRC := \
+	$(LIB_PATH)/fnv/qmk_fnv_type_validation.c \
+	$(LIB_PATH)/fnv/hash_32a.c \
+	$(LIB_PATH)/fnv/hash_64a.c \
+	$(QUANTUM_PATH)/wear_leveling/wear_leveling.c \
+	$(PLATFORM_PATH)/chibios/drivers/wear_leveling/wear_leveling_efl.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/wear_leveling/tests/efl_mocks.cpp \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_efl.cpp
+wear_leveling_efl_INC := \
+	$(QUANTUM_PATH)/wear_leveling/tests/mock \
+	$(wear_leveling_common_INC)
+
+wear_leveling_flash_spi_DEFS := \
+	-DWEAR_LEVELING_TESTS \
+	-DWEAR_LEVELING_DUAL_BANK \
+	-DNO_PRINT \
+	-DEXTERNAL_FLASH_SPI_SLAVE_SELECT_PIN=0 \
+	-DEXTERNAL_FLASH_SIZE=65536 \
+	-DEXTERNAL_FLASH_BLOCK_SIZE=8192 \
+	-DEXTERNAL_FLASH_SECTOR_SIZE=1024 \
+	-include $(DRIVER_PATH)/wear_leveling/wear_leveling_flash_spi_config.h
+wear_leveling_flash_spi_SRC := \
+	$(LIB_PATH)/fnv/qmk_fnv_type_validation.c \
+	$(LIB_PATH)/fnv/hash_32a.c \
+	$(LIB_PATH)/fnv/hash_64a.c \
+	$(QUANTUM_PATH)/wear_leveling/wear_leveling.c \
+	$(DRIVER_PATH)/flash/flash_spi.c \
+	$(DRIVER_PATH)/wear_leveling/wear_leveling_flash_spi.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/wear_leveling/tests/spi_flash_mocks.cpp \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_flash_spi.cpp
+wear_leveling_flash_spi_INC := \
+	$(QUANTUM_PATH)/wear_leveling/tests/mock_spi \
+	$(DRIVER_PATH)/flash \
+	$(wear_leveling_common_INC)
+
+wear_leveling_eeprom_2byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DEEPROM_DRIVER \
+	-DEEPROM_WEAR_LEVELING \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=2048 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=512
+wear_leveling_eeprom_2byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(DRIVER_PATH)/eeprom/eeprom_driver.c \
+	$(DRIVER_PATH)/eeprom/eeprom_wear_leveling.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_eeprom.cpp
+wear_leveling_eeprom_2byte_INC := \
+	$(wear_leveling_common_INC) \
+	$(DRIVER_PATH)/eeprom
+
+wear_leveling_eeprom_8byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DEEPROM_DRIVER \
+	-DEEPROM_WEAR_LEVELING \
+	-DBACKING_STORE_WRITE_SIZE=8 \
+	-DWEAR_LEVELING_BACKING_SIZE=2048 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=512
+wear_leveling_eeprom_8byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(DRIVER_PATH)/eeprom/eeprom_driver.c \
+	$(DRIVER_PATH)/eeprom/eeprom_wear_leveling.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_eeprom.cpp
+wear_leveling_eeprom_8byte_INC := \
+	$(wear_leveling_common_INC) \
+	$(DRIVER_PATH)/eeprom
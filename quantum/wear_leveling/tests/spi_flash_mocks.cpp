@@ -0,0 +1,159 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <algorithm>
+#include "gtest/gtest.h"
+#include "spi_flash_mocks.hpp"
+#include "spi_master.h"
+
+#define FLASH_CMD_WRDI 0x04
+#define FLASH_CMD_RDSR 0x05
+#define FLASH_CMD_WREN 0x06
+#define FLASH_CMD_READ 0x03
+#define FLASH_CMD_PP 0x02
+#define FLASH_CMD_SE 0x20
+
+// Command byte followed by a 3-byte address
+#define FLASH_HEADER_SIZE 4
+
+void MockSpiFlash::reset_instance(std::size_t size, std::size_t sector, int polls) {
+    memory.assign(size, 0xFF);
+    sector_size          = sector;
+    erase_polls          = polls;
+    busy_polls           = 0;
+    erased_sectors       = {};
+    polls_while_erasing  = 0;
+    command_while_busy   = false;
+    write_without_enable = false;
+    selected             = false;
+    write_enabled        = false;
+    erasing              = false;
+    command              = {};
+    read_offset          = 0;
+}
+
+static std::uint32_t command_address(const std::vector<std::uint8_t>& command) {
+    return (std::uint32_t)command[1] << 16 | (std::uint32_t)command[2] << 8 | command[3];
+}
+
+// Carries out the command once chip select is released
+static void execute(MockSpiFlash& flash) {
+    const auto& command = flash.command;
+    if (command.empty() || command[0] == FLASH_CMD_RDSR || command[0] == FLASH_CMD_READ) {
+        return;
+    }
+    if (flash.busy_polls > 0) {
+        flash.command_while_busy = true;
+        return;
+    }
+
+    switch (command[0]) {
+        case FLASH_CMD_WREN:
+            flash.write_enabled = true;
+            break;
+        case FLASH_CMD_WRDI:
+            flash.write_enabled = false;
+            break;
+        case FLASH_CMD_SE: {
+            ASSERT_EQ(command.size(), FLASH_HEADER_SIZE);
+            if (!flash.write_enabled) {
+                flash.write_without_enable = true;
+                return;
+            }
+            std::uint32_t address = command_address(command);
+            ASSERT_EQ(address % flash.sector_size, 0u);
+            ASSERT_LE(address + flash.sector_size, flash.memory.size());
+            std::fill_n(flash.memory.begin() + address, flash.sector_size, 0xFF);
+            flash.erased_sectors.push_back(address);
+            flash.write_enabled = false;
+            flash.erasing       = true;
+            flash.busy_polls    = flash.erase_polls;
+            break;
+        }
+        case FLASH_CMD_PP: {
+            if (!flash.write_enabled) {
+                flash.write_without_enable = true;
+                return;
+            }
+            std::uint32_t address = command_address(command);
+            ASSERT_LE(address + command.size() - FLASH_HEADER_SIZE, flash.memory.size());
+            for (std::size_t i = FLASH_HEADER_SIZE; i < command.size(); ++i) {
+                flash.memory[address + i - FLASH_HEADER_SIZE] &= command[i];
+            }
+            flash.write_enabled = false;
+            flash.busy_polls    = 1;
+            break;
+        }
+        default:
+            ADD_FAILURE() << "unexpected flash command " << (int)command[0];
+            break;
+    }
+}
+
+static std::uint8_t receive_byte(MockSpiFlash& flash) {
+    EXPECT_TRUE(flash.selected);
+    EXPECT_FALSE(flash.command.empty());
+    if (flash.command.empty()) {
+        return 0;
+    }
+
+    switch (flash.command[0]) {
+        case FLASH_CMD_RDSR: {
+            std::uint8_t status = (flash.busy_polls > 0 ? 0x01 : 0) | (flash.write_enabled ? 0x02 : 0);
+            if (flash.busy_polls > 0) {
+                flash.polls_while_erasing += flash.erasing;
+                --flash.busy_polls;
+            } else {
+                flash.erasing = false;
+            }
+            return status;
+        }
+        case FLASH_CMD_READ:
+            if (flash.busy_polls > 0) {
+                flash.command_while_busy = true;
+            }
+            return flash.memory[command_address(flash.command) + flash.read_offset++];
+        default:
+            ADD_FAILURE() << "unexpected read for flash command " << (int)flash.command[0];
+            return 0;
+    }
+}
+
+extern "C" void spi_init(void) {}
+
+extern "C" bool spi_start(pin_t, bool, uint8_t, uint16_t) {
+    MockSpiFlash& flash = MockSpiFlash::Instance();
+    EXPECT_FALSE(flash.selected);
+    flash.selected    = true;
+    flash.command     = {};
+    flash.read_offset = 0;
+    return true;
+}
+
+extern "C" spi_status_t spi_write(uint8_t data) {
+    return spi_transmit(&data, 1);
+}
+
+extern "C" spi_status_t spi_read(void) {
+    return receive_byte(MockSpiFlash::Instance());
+}
+
+extern "C" spi_status_t spi_transmit(const uint8_t* data, uint16_t length) {
+    MockSpiFlash& flash = MockSpiFlash::Instance();
+    EXPECT_TRUE(flash.selected);
+    flash.command.insert(flash.command.end(), data, data + length);
+    return SPI_STATUS_SUCCESS;
+}
+
+extern "C" spi_status_t spi_receive(uint8_t* data, uint16_t length) {
+    for (uint16_t i = 0; i < length; ++i) {
+        data[i] = receive_byte(MockSpiFlash::Instance());
+    }
+    return SPI_STATUS_SUCCESS;
+}
+
+extern "C" void spi_stop(void) {
+    MockSpiFlash& flash = MockSpiFlash::Instance();
+    EXPECT_TRUE(flash.selected);
+    flash.selected = false;
+    execute(flash);
+}
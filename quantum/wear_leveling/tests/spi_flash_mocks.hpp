@@ -0,0 +1,42 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/**
+ * SPI NOR flash as seen through spi_master.h, erased to 0xFF, where programming can only clear bits.
+ *
+ * Sector erases and page programs need the write enable latch, and keep the
+ * write-in-progress bit set for a number of status reads.
+ */
+class MockSpiFlash {
+   public:
+    static MockSpiFlash& Instance() {
+        static MockSpiFlash instance;
+        return instance;
+    }
+
+    void reset_instance(std::size_t size, std::size_t sector_size, int erase_polls);
+
+    std::vector<std::uint8_t> memory;
+    std::size_t               sector_size = 0;
+    // Status reads an erase stays busy for
+    int erase_polls = 0;
+    int busy_polls  = 0;
+    // Every sector erased, by address, in order
+    std::vector<std::uint32_t> erased_sectors;
+    // Status reads made while an erase was in progress
+    int polls_while_erasing = 0;
+    // Set when anything but a status read was sent while the flash was busy
+    bool command_while_busy = false;
+    // Set when an erase or program was sent without the write enable latch
+    bool write_without_enable = false;
+
+    // Driver side of the SPI bus
+    bool                      selected      = false;
+    bool                      write_enabled = false;
+    bool                      erasing       = false;
+    std::vector<std::uint8_t> command;
+    std::size_t               read_offset = 0;
+};
@@ -3,4 +3,11 @@ TEST_LIST += \
 	wear_leveling_2byte_optimized_writes \
 	wear_leveling_2byte \
 	wear_leveling_4byte \
-	wear_leveling_8byte
+	wear_leveling_8byte \
+	wear_leveling_dual_bank_2byte \
+	wear_leveling_dual_bank_8byte \
+	wear_leveling_erase_scheduler \
+	wear_leveling_efl \
+	wear_leveling_flash_spi \
+	wear_leveling_eeprom_2byte \
+	wear_leveling_eeprom_8byte
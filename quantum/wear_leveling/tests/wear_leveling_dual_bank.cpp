@@ -0,0 +1,216 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "dual_bank_fixture.hpp"
+
+class WearLevelingDualBank : public WearLevelingDualBankFixture {};
+
+/**
+ * This test verifies that consolidation writes into the second bank rather than erasing the backing store.
+ */
+TEST_F(WearLevelingDualBank, ConsolidationWritesInactiveBank) {
+    auto& inst = MockBackingStore::Instance();
+
+    fill_log(0x40);
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Backing store should not have been erased";
+    EXPECT_EQ(inst.erase_range_invoke_count(), 0) << "Inactive bank was already blank";
+    EXPECT_FALSE(bank_is_blank(1)) << "Consolidated data should be in the second bank";
+
+    // The old bank is still intact until the background task gets to it
+    EXPECT_FALSE(bank_is_blank(0));
+    verify_contents();
+
+    // Subsequent writes go to the write log of the second bank
+    test_write(1, 0x99);
+    EXPECT_EQ((inst.log_end() - 1)->address, WEAR_LEVELING_BANK_SIZE + WEAR_LEVELING_LOGICAL_SIZE + WEAR_LEVELING_BANK_HEADER_SIZE) << "Invalid write address.";
+
+    wear_leveling_init();
+    verify_contents();
+}
+
+/**
+ * This test verifies that the background task erases the previous bank a sector at a time.
+ */
+TEST_F(WearLevelingDualBank, TaskErasesPreviousBank) {
+    auto& inst = MockBackingStore::Instance();
+
+    const std::size_t sector_count = BANK_ELEMENT_COUNT::value / SECTOR_ELEMENT_COUNT::value;
+
+    // Blank sectors are checked, but not erased
+    run_task();
+    EXPECT_EQ(inst.erase_range_invoke_count(), 0) << "Nothing to erase on a blank backing store";
+
+    // Only the write log of the first bank was used, the blank sectors before it are skipped
+    fill_log(0x40);
+    run_task();
+    EXPECT_TRUE(bank_is_blank(0));
+    const std::uint64_t erases = inst.erase_range_invoke_count();
+    EXPECT_GT(erases, 0);
+    EXPECT_LT(erases, sector_count);
+    EXPECT_TRUE(inst.is_locked()) << "Backing store should be locked after erasing";
+
+    // Consolidating back into the first bank needs no further erasing, the second bank is erased one sector at a time
+    fill_log(0x80);
+    EXPECT_EQ(inst.erase_range_invoke_count(), erases);
+    EXPECT_TRUE(wear_leveling_task(true));
+    EXPECT_TRUE(wear_leveling_task(true));
+    EXPECT_EQ(inst.erase_range_invoke_count(), erases + 1);
+    run_task();
+    EXPECT_TRUE(bank_is_blank(1));
+    EXPECT_EQ(inst.erase_range_invoke_count(), erases + sector_count);
+
+    wear_leveling_init();
+    verify_contents();
+}
+
+/**
+ * This test verifies that a consolidation finishes off an erase the background task didn't get to.
+ */
+TEST_F(WearLevelingDualBank, ConsolidationFinishesPendingErase) {
+    auto& inst = MockBackingStore::Instance();
+
+    fill_log(0x40);
+    fill_log(0x80);
+    EXPECT_GT(inst.erase_range_invoke_count(), 0);
+    EXPECT_EQ(inst.erase_invoke_count(), 0);
+    verify_contents();
+
+    wear_leveling_init();
+    verify_contents();
+}
+
+/**
+ * This test verifies that initialisation picks the bank with the latest consolidated data, whichever bank it is in.
+ */
+TEST_F(WearLevelingDualBank, InitPicksNewestBank) {
+    for (uint8_t round = 0; round < 5; ++round) {
+        fill_log(0x10 * (round + 1));
+        if (round % 2 == 0) {
+            run_task();
+        }
+        wear_leveling_init();
+        verify_contents();
+    }
+}
+
+/**
+ * This test verifies that a failed consolidation leaves the previous bank in use, and is retried on the next write.
+ */
+TEST_F(WearLevelingDualBank, FailedConsolidationIsRetried) {
+    auto& inst = MockBackingStore::Instance();
+
+    for (std::size_t i = 0; i < LOG_ENTRY_COUNT::value - 1; ++i) {
+        ASSERT_EQ(test_write(i % WEAR_LEVELING_LOGICAL_SIZE, (uint8_t)(0x40 + i)), WEAR_LEVELING_SUCCESS);
+    }
+
+    inst.set_write_callback([](std::uint64_t, std::uint32_t address) { return address < WEAR_LEVELING_BANK_SIZE + WEAR_LEVELING_LOGICAL_SIZE; });
+    EXPECT_EQ(test_write(0, 0x20), WEAR_LEVELING_FAILED);
+    inst.set_write_callback(nullptr);
+
+    EXPECT_EQ(test_write(1, 0x21), WEAR_LEVELING_CONSOLIDATED);
+    EXPECT_EQ(inst.erase_range_invoke_count(), 1) << "Partially written bank should have been erased before retrying";
+    verify_contents();
+
+    wear_leveling_init();
+    verify_contents();
+}
+
+/**
+ * This test verifies that erasing the wear-leveling area resets to the first bank.
+ */
+TEST_F(WearLevelingDualBank, EraseResetsToFirstBank) {
+    auto& inst = MockBackingStore::Instance();
+
+    fill_log(0x40);
+    EXPECT_EQ(wear_leveling_erase(), WEAR_LEVELING_SUCCESS);
+    std::fill(verify_data.begin(), verify_data.end(), 0);
+    EXPECT_EQ(run_task(), 0) << "Nothing left to erase";
+
+    test_write(2, 0x33);
+    EXPECT_EQ((inst.log_end() - 1)->address, WEAR_LEVELING_LOGICAL_SIZE + WEAR_LEVELING_BANK_HEADER_SIZE) << "Invalid write address.";
+
+    wear_leveling_init();
+    verify_contents();
+}
+
+/**
+ * This test cuts the power at every backing store operation throughout a sequence of writes, consolidations and
+ * background erases. After each cut, the data read back after initialisation must match what was written, give or
+ * take the write which was interrupted, and the store must remain usable.
+ */
+TEST_F(WearLevelingDualBank, PowerCutFuzz) {
+    auto& inst = MockBackingStore::Instance();
+
+    const std::size_t write_count = 4 * LOG_ENTRY_COUNT::value;
+    auto              next_value  = [](std::size_t i) { return (uint8_t)(i * 37 + 11); };
+    auto              next_addr   = [](std::size_t i) { return (uint32_t)((i * 7) % WEAR_LEVELING_LOGICAL_SIZE); };
+
+    // Count the operations in an uninterrupted run, which are then interrupted one at a time
+    std::uint64_t operations = 0;
+    auto          budget     = std::numeric_limits<std::uint64_t>::max();
+    auto          powered    = [&]() { return ++operations <= budget; };
+
+    auto run = [&]() -> std::size_t {
+        for (std::size_t i = 0; i < write_count; ++i) {
+            uint8_t value = next_value(i);
+            if (wear_leveling_write(next_addr(i), &value, sizeof(value)) == WEAR_LEVELING_FAILED) {
+                return i;
+            }
+            verify_data[next_addr(i)] = value;
+            if (i % 3 == 0) {
+                wear_leveling_task(true);
+            }
+        }
+        return write_count;
+    };
+
+    inst.set_write_callback([&](std::uint64_t, std::uint32_t) { return powered(); });
+    inst.set_erase_callback([&](std::uint64_t) { return powered(); });
+    run();
+    const std::uint64_t total = operations;
+    ASSERT_GT(total, 0);
+    // Let any erase still in progress complete before the backing store is reset
+    wear_leveling_init();
+
+    for (budget = 0; budget < total; ++budget) {
+        SCOPED_TRACE(testing::Message() << "Power cut after " << budget << " of " << total << " operations");
+
+        inst.reset_instance();
+        wear_leveling_init();
+        std::fill(verify_data.begin(), verify_data.end(), 0);
+        operations = 0;
+        inst.set_write_callback([&](std::uint64_t, std::uint32_t) { return powered(); });
+        inst.set_erase_callback([&](std::uint64_t) { return powered(); });
+        std::size_t interrupted = run();
+
+        // Power comes back
+        inst.set_write_callback(nullptr);
+        inst.set_erase_callback(nullptr);
+        EXPECT_TRUE(inst.is_locked());
+        ASSERT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED);
+
+        // The interrupted write may or may not have made it
+        if (interrupted < write_count) {
+            uint8_t actual;
+            wear_leveling_read(next_addr(interrupted), &actual, sizeof(actual));
+            if (actual == next_value(interrupted)) {
+                verify_data[next_addr(interrupted)] = actual;
+            }
+        }
+        verify_contents();
+
+        // Keep going after recovery, through at least one more consolidation
+        for (std::size_t i = 0; i < 2 * LOG_ENTRY_COUNT::value; ++i) {
+            ASSERT_NE(test_write(next_addr(i + 1), next_value(i + 5)), WEAR_LEVELING_FAILED);
+            wear_leveling_task(true);
+        }
+        wear_leveling_init();
+        verify_contents();
+
+        if (HasFailure()) {
+            break;
+        }
+    }
+}
@@ -0,0 +1,196 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <cstdio>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+extern "C" {
+#include "eeprom.h"
+#include "eeprom_driver.h"
+void advance_time(uint32_t ms);
+}
+
+// Where the keycodes are stored, clear of the 2-byte backing store's single byte optimisation
+using KEYMAP_BASE = std::integral_constant<std::uintptr_t, 64>;
+
+class WearLevelingEeprom : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        eeprom_driver_init();
+    }
+
+    // Same as dynamic_keymap_set_keycode()
+    static void set_keycode(std::size_t index, uint16_t keycode) {
+        uint8_t* address = (uint8_t*)(KEYMAP_BASE::value + index * 2);
+        eeprom_update_byte(address, (uint8_t)(keycode >> 8));
+        eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    }
+
+    static uint16_t get_keycode(std::size_t index) {
+        const uint8_t* address = (const uint8_t*)(KEYMAP_BASE::value + index * 2);
+        return eeprom_read_byte(address) << 8 | eeprom_read_byte(address + 1);
+    }
+
+    static void flush_after_timeout() {
+        advance_time(EEPROM_WRITE_COMBINE_TIMEOUT);
+        eeprom_driver_task();
+    }
+};
+
+/**
+ * This test verifies that writes are held back until the timeout, while being visible to reads straight away.
+ */
+TEST_F(WearLevelingEeprom, WritesAreDeferredUntilTimeout) {
+    auto& inst = MockBackingStore::Instance();
+
+    set_keycode(3, 0x1234);
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Write should have been held back";
+    EXPECT_EQ(get_keycode(3), 0x1234);
+
+    advance_time(EEPROM_WRITE_COMBINE_TIMEOUT - 1);
+    eeprom_driver_task();
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Write should still be held back";
+
+    advance_time(1);
+    eeprom_driver_task();
+    EXPECT_GT(inst.write_invoke_count(), 0);
+
+    wear_leveling_init();
+    EXPECT_EQ(get_keycode(3), 0x1234);
+}
+
+/**
+ * This test verifies that both halves of a keycode end up in a single log entry.
+ */
+TEST_F(WearLevelingEeprom, KeycodeIsCombinedIntoOneLogEntry) {
+    auto& inst = MockBackingStore::Instance();
+
+    // The same as a single two byte write
+    uint8_t keycode[2] = {0x12, 0x34};
+    wear_leveling_write(KEYMAP_BASE::value, keycode, sizeof(keycode));
+    const std::uint64_t expected = inst.write_invoke_count();
+    inst.reset_instance();
+    eeprom_driver_init();
+
+    set_keycode(0, 0x1234);
+    flush_after_timeout();
+    EXPECT_EQ(inst.write_invoke_count(), expected);
+
+    wear_leveling_init();
+    EXPECT_EQ(get_keycode(0), 0x1234);
+}
+
+/**
+ * This test verifies that overlapping and adjacent writes are merged in either order, up to the size of a log entry.
+ */
+TEST_F(WearLevelingEeprom, AdjacentAndOverlappingWritesAreMerged) {
+    auto& inst = MockBackingStore::Instance();
+
+    uint8_t* base = (uint8_t*)KEYMAP_BASE::value;
+    eeprom_update_byte(base + 2, 0x22);
+    eeprom_update_byte(base + 1, 0x11);
+    eeprom_update_word((uint16_t*)(base + 2), 0x4433);
+    eeprom_update_byte(base + 4, 0x44);
+    eeprom_update_byte(base + 0, 0x00);
+    eeprom_update_byte(base + 0, 0x0F);
+    EXPECT_EQ(inst.write_invoke_count(), 0);
+
+    // One byte too many flushes the buffer
+    eeprom_update_byte(base + EEPROM_WRITE_COMBINE_SIZE, 0x55);
+    const std::uint64_t writes = inst.write_invoke_count();
+    EXPECT_GT(writes, 0);
+    flush_after_timeout();
+
+    wear_leveling_init();
+    const uint8_t expected[] = {0x0F, 0x11, 0x33, 0x44, 0x44, 0x55};
+    uint8_t       actual[sizeof(expected)];
+    eeprom_read_block(actual, base, sizeof(actual));
+    EXPECT_THAT(actual, testing::ElementsAreArray(expected));
+}
+
+/**
+ * This test verifies that unrelated writes don't get merged, and writes larger than the buffer go straight through.
+ */
+TEST_F(WearLevelingEeprom, UnrelatedWritesFlushTheBuffer) {
+    auto& inst = MockBackingStore::Instance();
+
+    set_keycode(0, 0x1234);
+    set_keycode(8, 0x5678);
+    const std::uint64_t writes = inst.write_invoke_count();
+    EXPECT_GT(writes, 0) << "First keycode should have been written out";
+
+    uint8_t block[EEPROM_WRITE_COMBINE_SIZE + 1] = {1, 2, 3, 4, 5, 6};
+    eeprom_update_block(block, (void*)(KEYMAP_BASE::value + 64), sizeof(block));
+    EXPECT_GT(inst.write_invoke_count(), writes);
+    EXPECT_EQ(get_keycode(8), 0x5678) << "Second keycode should have been written out";
+
+    wear_leveling_init();
+    EXPECT_EQ(get_keycode(0), 0x1234);
+    EXPECT_EQ(get_keycode(8), 0x5678);
+}
+
+/**
+ * This test verifies that erasing drops anything still buffered.
+ */
+TEST_F(WearLevelingEeprom, EraseDiscardsBufferedWrites) {
+    auto& inst = MockBackingStore::Instance();
+
+    set_keycode(0, 0x1234);
+    eeprom_driver_erase();
+    EXPECT_EQ(get_keycode(0), 0);
+    flush_after_timeout();
+    EXPECT_EQ(inst.write_invoke_count(), 0);
+}
+
+/**
+ * This test measures the write log consumed by remapping each key of a populated keymap, with and without write
+ * combining.
+ */
+TEST_F(WearLevelingEeprom, LogUsagePerKeymapEdit) {
+    auto& inst = MockBackingStore::Instance();
+
+    const std::size_t key_count = 64;
+    auto              original  = [](std::size_t i) { return (uint16_t)(0x0004 + i); };
+    // Modified keys, with every fourth key cleared to KC_NO
+    auto remapped = [](std::size_t i) { return (uint16_t)(i % 4 == 0 ? 0x0000 : 0x0200 | (0x0040 + i)); };
+
+    auto populate = [&]() {
+        inst.reset_instance();
+        eeprom_driver_init();
+        std::array<uint8_t, key_count * 2> keymap;
+        for (std::size_t i = 0; i < key_count; ++i) {
+            keymap[i * 2]     = (uint8_t)(original(i) >> 8);
+            keymap[i * 2 + 1] = (uint8_t)(original(i) & 0xFF);
+        }
+        wear_leveling_write(KEYMAP_BASE::value, keymap.data(), keymap.size());
+        return inst.write_invoke_count();
+    };
+
+    // Without combining, each byte is its own write
+    std::uint64_t initial = populate();
+    for (std::size_t i = 0; i < key_count; ++i) {
+        uint8_t bytes[2] = {(uint8_t)(remapped(i) >> 8), (uint8_t)(remapped(i) & 0xFF)};
+        wear_leveling_write(KEYMAP_BASE::value + i * 2, &bytes[0], 1);
+        wear_leveling_write(KEYMAP_BASE::value + i * 2 + 1, &bytes[1], 1);
+    }
+    const std::uint64_t uncombined = inst.write_invoke_count() - initial;
+
+    initial = populate();
+    for (std::size_t i = 0; i < key_count; ++i) {
+        set_keycode(i, remapped(i));
+        flush_after_timeout();
+    }
+    const std::uint64_t combined = inst.write_invoke_count() - initial;
+    EXPECT_LT(combined, uncombined);
+
+    wear_leveling_init();
+    for (std::size_t i = 0; i < key_count; ++i) {
+        EXPECT_EQ(get_keycode(i), remapped(i));
+    }
+
+    RecordProperty("uncombined_bytes_per_edit", (int)(uncombined * BACKING_STORE_WRITE_SIZE / key_count));
+    RecordProperty("combined_bytes_per_edit", (int)(combined * BACKING_STORE_WRITE_SIZE / key_count));
+    std::printf("[ BENCHMARK] %.2f bytes of write log per keymap edit, down from %.2f\n", (double)combined * BACKING_STORE_WRITE_SIZE / key_count, (double)uncombined * BACKING_STORE_WRITE_SIZE / key_count);
+}
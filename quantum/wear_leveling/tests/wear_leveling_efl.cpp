@@ -0,0 +1,98 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <array>
+#include "gtest/gtest.h"
+#include "efl_mocks.hpp"
+
+extern "C" {
+#include "wear_leveling.h"
+#include "wear_leveling_internal.h"
+}
+
+// Number of single-byte writes which fit in the write log of a bank
+using LOG_ENTRY_COUNT = std::integral_constant<std::size_t, ((WEAR_LEVELING_BANK_SIZE - WEAR_LEVELING_LOGICAL_SIZE - WEAR_LEVELING_BANK_HEADER_SIZE) / BACKING_STORE_WRITE_SIZE)>;
+using SECTOR_SIZE     = std::integral_constant<std::uint32_t, BACKING_STORE_ERASE_SIZE>;
+
+/**
+ * Runs the dual-bank mode of wear_leveling_efl.c against embedded flash with different sector layouts.
+ */
+class WearLevelingEfl : public ::testing::Test {
+   protected:
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> verify_data{};
+
+    void verify_contents() {
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> actual;
+        EXPECT_EQ(wear_leveling_read(0, actual.data(), actual.size()), WEAR_LEVELING_SUCCESS);
+        EXPECT_EQ(actual, verify_data);
+    }
+
+    // Writes until the log of the active bank overflows, then lets the background erase finish
+    void fill_log(uint8_t seed) {
+        wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+        for (std::size_t i = 0; i < LOG_ENTRY_COUNT::value && status == WEAR_LEVELING_SUCCESS; ++i) {
+            verify_data[i % WEAR_LEVELING_LOGICAL_SIZE] = (uint8_t)(seed + i);
+            status                                      = wear_leveling_write(i % WEAR_LEVELING_LOGICAL_SIZE, &verify_data[i % WEAR_LEVELING_LOGICAL_SIZE], 1);
+        }
+        ASSERT_EQ(status, WEAR_LEVELING_CONSOLIDATED);
+        while (wear_leveling_task(true)) {
+        }
+    }
+
+    static std::vector<flash_sector_t> backing_sectors() {
+        MockFlash&                  flash = MockFlash::Instance();
+        std::vector<flash_sector_t> sectors;
+        for (flash_sector_t i = 0; i < flash.sector_sizes.size(); ++i) {
+            if (flash.sector_offset(i) >= flash.memory.size() - WEAR_LEVELING_BACKING_SIZE) {
+                sectors.push_back(i);
+            }
+        }
+        return sectors;
+    }
+};
+
+TEST_F(WearLevelingEfl, ErasesOneSectorAtATime) {
+    MockFlash::Instance().reset_instance(std::vector<std::uint32_t>(8, SECTOR_SIZE::value));
+    ASSERT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS);
+
+    // Each bank of the backing store is half of its sectors
+    auto                        sectors = backing_sectors();
+    std::vector<flash_sector_t> bank0(sectors.begin(), sectors.begin() + sectors.size() / 2);
+    std::vector<flash_sector_t> bank1(sectors.begin() + sectors.size() / 2, sectors.end());
+    ASSERT_EQ(bank0.size(), WEAR_LEVELING_BANK_SIZE / SECTOR_SIZE::value);
+
+    std::vector<flash_sector_t> previous;
+    for (uint8_t round = 0; round < 4; ++round) {
+        MockFlash::Instance().erased_sectors.clear();
+        fill_log(round * 16);
+        verify_contents();
+
+        // The bank which was just left is erased sector by sector, and nothing outside of it is touched
+        const auto& erased = MockFlash::Instance().erased_sectors;
+        EXPECT_TRUE(erased == bank0 || erased == bank1) << "round " << (int)round;
+        EXPECT_NE(erased, previous) << "round " << (int)round;
+        previous = erased;
+        EXPECT_FALSE(MockFlash::Instance().overlapping_erase);
+
+        // Everything was written to erased flash, so it reads back the same from scratch
+        ASSERT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS);
+        verify_contents();
+    }
+}
+
+TEST_F(WearLevelingEfl, OneSectorHoldingBothBanksFailsInit) {
+    MockFlash::Instance().reset_instance({SECTOR_SIZE::value, SECTOR_SIZE::value, WEAR_LEVELING_BACKING_SIZE});
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_FAILED);
+    EXPECT_TRUE(MockFlash::Instance().erased_sectors.empty());
+}
+
+TEST_F(WearLevelingEfl, BankBoundaryWithinSectorFailsInit) {
+    MockFlash::Instance().reset_instance({SECTOR_SIZE::value, SECTOR_SIZE::value, WEAR_LEVELING_BACKING_SIZE - SECTOR_SIZE::value, SECTOR_SIZE::value});
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_FAILED);
+    EXPECT_TRUE(MockFlash::Instance().erased_sectors.empty());
+}
+
+TEST_F(WearLevelingEfl, SectorsOfAnotherSizeFailInit) {
+    MockFlash::Instance().reset_instance({SECTOR_SIZE::value, SECTOR_SIZE::value / 2, SECTOR_SIZE::value / 2, WEAR_LEVELING_BACKING_SIZE - SECTOR_SIZE::value});
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_FAILED);
+    EXPECT_TRUE(MockFlash::Instance().erased_sectors.empty());
+}
@@ -0,0 +1,178 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "dual_bank_fixture.hpp"
+
+// Number of polls each erase remains busy for
+using ERASE_LATENCY = std::integral_constant<std::uint64_t, 3>;
+
+class WearLevelingEraseScheduler : public WearLevelingDualBankFixture {
+   protected:
+    std::uint64_t erase_latency() const override {
+        return ERASE_LATENCY::value;
+    }
+
+    // Fills the log of both banks, leaving the first bank to be erased in its entirety
+    void prepare_full_bank_erase() {
+        fill_log(0x40);
+        run_task();
+        fill_log(0x80);
+        fill_log(0xC0);
+    }
+};
+
+/**
+ * This test verifies that no erase is started unless the keyboard is idle.
+ */
+TEST_F(WearLevelingEraseScheduler, ErasesOnlyStartWhenIdle) {
+    auto& inst = MockBackingStore::Instance();
+
+    fill_log(0x40);
+    const std::uint64_t erases = inst.erase_range_invoke_count();
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(wear_leveling_task(false)) << "Erase should still be pending";
+    }
+    EXPECT_FALSE(inst.is_erasing());
+    EXPECT_EQ(inst.erase_range_invoke_count(), erases);
+    EXPECT_FALSE(bank_is_blank(0));
+
+    while (wear_leveling_task(true)) {
+    }
+    EXPECT_TRUE(bank_is_blank(0));
+    EXPECT_TRUE(inst.is_locked()) << "Backing store should be locked after erasing";
+}
+
+/**
+ * This test verifies that each erase is polled for completion rather than waited upon, and is seen through even if the
+ * keyboard stops being idle.
+ */
+TEST_F(WearLevelingEraseScheduler, ErasesAreSeenThroughWithoutBlocking) {
+    auto& inst = MockBackingStore::Instance();
+
+    prepare_full_bank_erase();
+    EXPECT_FALSE(inst.is_erasing());
+
+    // Starting an erase returns straight away, leaving the backing store unlocked
+    EXPECT_TRUE(wear_leveling_task(true));
+    EXPECT_TRUE(inst.is_erasing());
+    EXPECT_FALSE(inst.is_locked());
+
+    // Subsequent calls poll for completion, regardless of activity
+    for (std::uint64_t i = 0; i < ERASE_LATENCY::value; ++i) {
+        EXPECT_TRUE(wear_leveling_task(false));
+        EXPECT_TRUE(inst.is_erasing());
+    }
+    const std::uint64_t erases = inst.erase_range_invoke_count();
+    EXPECT_TRUE(wear_leveling_task(false));
+    EXPECT_FALSE(inst.is_erasing());
+    EXPECT_TRUE(inst.is_locked());
+    EXPECT_EQ(inst.erase_range_invoke_count(), erases + 1) << "Erase should have completed";
+
+    // No further erases without being idle
+    EXPECT_TRUE(wear_leveling_task(false));
+    EXPECT_FALSE(inst.is_erasing());
+
+    // Each sector takes one call to start, and one per poll
+    std::size_t       calls        = 0;
+    const std::size_t sector_count = BANK_ELEMENT_COUNT::value / SECTOR_ELEMENT_COUNT::value;
+    while (wear_leveling_task(true)) {
+        ++calls;
+    }
+    EXPECT_EQ(calls + 1, (sector_count - 1) * (ERASE_LATENCY::value + 2));
+    EXPECT_TRUE(bank_is_blank(0));
+
+    wear_leveling_init();
+    verify_contents();
+}
+
+/**
+ * This test verifies that writes wait for an erase in progress to complete before accessing the backing store.
+ */
+TEST_F(WearLevelingEraseScheduler, WritesWaitForEraseInProgress) {
+    auto& inst = MockBackingStore::Instance();
+
+    prepare_full_bank_erase();
+    EXPECT_TRUE(wear_leveling_task(true));
+    EXPECT_TRUE(inst.is_erasing());
+
+    // The mock flags any write while erasing
+    EXPECT_EQ(test_write(3, 0x55), WEAR_LEVELING_SUCCESS);
+    EXPECT_FALSE(inst.is_erasing());
+    EXPECT_TRUE(inst.is_locked());
+
+    // Unchanged data has no need to wait
+    EXPECT_TRUE(wear_leveling_task(true));
+    EXPECT_TRUE(inst.is_erasing());
+    EXPECT_EQ(test_write(3, 0x55), WEAR_LEVELING_SUCCESS);
+    EXPECT_TRUE(inst.is_erasing());
+
+    while (wear_leveling_task(true)) {
+    }
+    EXPECT_TRUE(bank_is_blank(0));
+
+    wear_leveling_init();
+    verify_contents();
+}
+
+/**
+ * This test verifies that a consolidation after the background erase has completed doesn't erase anything in-line.
+ */
+TEST_F(WearLevelingEraseScheduler, ConsolidationSkipsPreErasedBank) {
+    auto& inst = MockBackingStore::Instance();
+
+    prepare_full_bank_erase();
+    while (wear_leveling_task(true)) {
+    }
+    const std::uint64_t erases = inst.erase_range_invoke_count();
+
+    fill_log(0x20);
+    EXPECT_EQ(inst.erase_range_invoke_count(), erases) << "Consolidation should not have erased anything";
+    EXPECT_FALSE(bank_is_blank(0));
+
+    wear_leveling_init();
+    verify_contents();
+}
+
+/**
+ * This test verifies that a consolidation finishes off an erase in progress, as well as the rest of the bank.
+ */
+TEST_F(WearLevelingEraseScheduler, ConsolidationFinishesEraseInProgress) {
+    auto& inst = MockBackingStore::Instance();
+
+    prepare_full_bank_erase();
+    EXPECT_TRUE(wear_leveling_task(true));
+    EXPECT_TRUE(inst.is_erasing());
+
+    fill_log(0x20);
+    EXPECT_FALSE(inst.is_erasing());
+    EXPECT_TRUE(inst.is_locked());
+    EXPECT_FALSE(wear_leveling_task(true) && bank_is_blank(1)) << "Consolidated data should be in the first bank";
+
+    wear_leveling_init();
+    verify_contents();
+}
+
+/**
+ * This test verifies that a failed erase is retried the next time the keyboard is idle.
+ */
+TEST_F(WearLevelingEraseScheduler, FailedEraseIsRetried) {
+    auto& inst = MockBackingStore::Instance();
+
+    prepare_full_bank_erase();
+    inst.set_erase_callback([](std::uint64_t) { return false; });
+    EXPECT_TRUE(wear_leveling_task(true));
+    while (inst.is_erasing()) {
+        wear_leveling_task(false);
+    }
+    EXPECT_TRUE(inst.is_locked());
+    EXPECT_FALSE(bank_is_blank(0));
+
+    inst.set_erase_callback(nullptr);
+    while (wear_leveling_task(true)) {
+    }
+    EXPECT_TRUE(bank_is_blank(0));
+
+    wear_leveling_init();
+    verify_contents();
+}
@@ -0,0 +1,131 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <algorithm>
+#include <array>
+#include "gtest/gtest.h"
+#include "spi_flash_mocks.hpp"
+
+extern "C" {
+#include "wear_leveling.h"
+#include "wear_leveling_internal.h"
+}
+
+// Number of status reads each sector erase stays busy for
+using ERASE_POLLS = std::integral_constant<int, 5>;
+
+/**
+ * Runs the dual-bank mode of wear_leveling_flash_spi.c on top of flash_spi.c against a mock SPI flash chip.
+ */
+class WearLevelingFlashSpi : public ::testing::Test {
+   protected:
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> verify_data{};
+
+    void SetUp() override {
+        MockSpiFlash::Instance().reset_instance(EXTERNAL_FLASH_SIZE, EXTERNAL_FLASH_SECTOR_SIZE, ERASE_POLLS::value);
+        ASSERT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS);
+    }
+
+    void TearDown() override {
+        EXPECT_FALSE(MockSpiFlash::Instance().command_while_busy);
+        EXPECT_FALSE(MockSpiFlash::Instance().write_without_enable);
+    }
+
+    void verify_contents() {
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> actual;
+        EXPECT_EQ(wear_leveling_read(0, actual.data(), actual.size()), WEAR_LEVELING_SUCCESS);
+        EXPECT_EQ(actual, verify_data);
+    }
+
+    // Writes until the log of the active bank overflows
+    void fill_log(uint8_t seed) {
+        wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+        for (std::size_t i = 0; i < WEAR_LEVELING_BANK_SIZE && status == WEAR_LEVELING_SUCCESS; ++i) {
+            verify_data[i % WEAR_LEVELING_LOGICAL_SIZE] = (uint8_t)(seed + i);
+            status                                      = wear_leveling_write(i % WEAR_LEVELING_LOGICAL_SIZE, &verify_data[i % WEAR_LEVELING_LOGICAL_SIZE], 1);
+        }
+        ASSERT_EQ(status, WEAR_LEVELING_CONSOLIDATED);
+    }
+
+    // Checks that a bank was left blank, and that nothing outside of it was erased
+    static void expect_bank_erased(int bank) {
+        MockSpiFlash&       flash = MockSpiFlash::Instance();
+        const std::uint32_t begin = WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_OFFSET * EXTERNAL_FLASH_BLOCK_SIZE + bank * WEAR_LEVELING_BANK_SIZE;
+        EXPECT_FALSE(flash.erased_sectors.empty());
+        for (std::uint32_t address : flash.erased_sectors) {
+            EXPECT_GE(address, begin);
+            EXPECT_LT(address, begin + WEAR_LEVELING_BANK_SIZE);
+        }
+        EXPECT_TRUE(std::all_of(flash.memory.begin() + begin, flash.memory.begin() + begin + WEAR_LEVELING_BANK_SIZE, [](std::uint8_t b) { return b == 0xFF; }));
+    }
+};
+
+/**
+ * This test verifies that each sector erase is sent to the flash and left running, with every later call reading the
+ * status register once rather than waiting for the erase to finish.
+ */
+TEST_F(WearLevelingFlashSpi, ErasesWithoutWaiting) {
+    MockSpiFlash& flash = MockSpiFlash::Instance();
+
+    fill_log(0x40);
+    EXPECT_TRUE(flash.erased_sectors.empty()) << "Nothing should be erased until idle";
+
+    std::size_t calls = 0;
+    int         polls = flash.polls_while_erasing;
+    while (wear_leveling_task(true)) {
+        ASSERT_LT(++calls, 1000u) << "Erase never completed";
+        EXPECT_LE(flash.polls_while_erasing - polls, 1) << "A call waited for the erase";
+        polls = flash.polls_while_erasing;
+    }
+    expect_bank_erased(0);
+    // Every sector took one call to start, then one per status read it was busy for
+    EXPECT_GE(calls, flash.erased_sectors.size() * ERASE_POLLS::value);
+    EXPECT_FALSE(flash.erasing);
+
+    verify_contents();
+    ASSERT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS);
+    verify_contents();
+}
+
+/**
+ * This test verifies that banks are erased alternately, and that the data survives a restart after each.
+ */
+TEST_F(WearLevelingFlashSpi, AlternatesBanks) {
+    MockSpiFlash& flash = MockSpiFlash::Instance();
+
+    for (int round = 0; round < 4; ++round) {
+        flash.erased_sectors.clear();
+        fill_log(round * 16);
+        while (wear_leveling_task(true)) {
+        }
+        SCOPED_TRACE(round);
+        expect_bank_erased(round % 2);
+
+        ASSERT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS);
+        verify_contents();
+    }
+}
+
+/**
+ * This test verifies that a write while an erase is in progress waits for it, instead of sending commands to a busy
+ * flash.
+ */
+TEST_F(WearLevelingFlashSpi, WriteDuringEraseWaitsForIt) {
+    MockSpiFlash& flash = MockSpiFlash::Instance();
+
+    fill_log(0x40);
+    // Blank sectors are skipped without sending an erase
+    while (!flash.erasing) {
+        ASSERT_TRUE(wear_leveling_task(true));
+    }
+
+    verify_data[3] = 0x5A;
+    EXPECT_EQ(wear_leveling_write(3, &verify_data[3], 1), WEAR_LEVELING_SUCCESS);
+    EXPECT_FALSE(flash.erasing);
+    verify_contents();
+
+    while (wear_leveling_task(true)) {
+    }
+    expect_bank_erased(0);
+    ASSERT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS);
+    verify_contents();
+}
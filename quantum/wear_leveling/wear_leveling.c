@@ -153,7 +153,34 @@
         ║  │Address >> 1 ║
         ║  └── Value: 1  ║
         ╚════════════════╝
-        0 <= Address <= 0x3FFE (16382) */
+        0 <= Address <= 0x3FFE (16382)
+
+    Dual-bank mode:
+
+        With WEAR_LEVELING_DUAL_BANK defined, the backing store is split into
+        two equally-sized banks, each holding its own consolidated data and
+        write log. Only one bank is active at a time.
+
+        Consolidation writes the cache into the inactive bank, followed by a
+        sequence number and finally the FNV1a_64 hash of both. Writing the hash
+        commits the new bank: until it is complete, the previous bank is still
+        intact and is the one found on the next initialization.
+
+        ╔ Bank ═════════════════╦══════════╦══════════╦═══════════╗
+        ║ Consolidated data     ║ Sequence ║ FNV1a_64 ║ Write log ║
+        ╚═══════════════════════╩══════════╩══════════╩═══════════╝
+
+        During initialization, the valid bank with the highest sequence number
+        becomes active. If neither is valid, the first bank is used the same way
+        as a single-bank store would be.
+
+        The bank that is no longer in use is erased BACKING_STORE_ERASE_SIZE
+        bytes at a time by wear_leveling_task(), skipping sectors that are
+        already blank. Erases are started only while the keyboard is idle, and
+        run in the background if the backing store supports it, with their
+        completion polled by subsequent calls. If the bank is not fully erased
+        by the time the next consolidation occurs, the remainder is erased
+        beforehand. Writes wait for any erase in progress to complete. */
 
 /**
  * Storage area for the wear-leveling cache.
@@ -161,7 +188,14 @@
 static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
-    bool                                                           unlocked;
+    uint32_t                                                       bank_address;
+#ifdef WEAR_LEVELING_DUAL_BANK
+    uint64_t sequence;
+    uint32_t erase_address;
+    bool     erasing;
+    bool     erase_unlocked;
+#endif // WEAR_LEVELING_DUAL_BANK
+    bool unlocked;
 } wear_leveling;
 
 /**
@@ -202,8 +236,193 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+    wear_leveling.write_address = wear_leveling.bank_address + (WEAR_LEVELING_LOGICAL_SIZE) + (WEAR_LEVELING_BANK_HEADER_SIZE);
+#ifdef WEAR_LEVELING_DUAL_BANK
+    wear_leveling.sequence = 0;
+#endif // WEAR_LEVELING_DUAL_BANK
+}
+
+/**
+ * Reads an 8-byte value, such as the FNV1a_64 of the consolidated data, from the backing store.
+ */
+static bool wear_leveling_read_u64(uint32_t address, uint64_t *value) {
+    write_log_entry_t entry;
+#if BACKING_STORE_WRITE_SIZE == 2
+    bool ok = backing_store_read_bulk(address, entry.raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    bool ok = backing_store_read_bulk(address, entry.raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    bool ok = backing_store_read(address, &entry.raw64);
+#endif
+    *value = entry.raw64;
+    return ok;
+}
+
+/**
+ * Writes an 8-byte value, such as the FNV1a_64 of the consolidated data, to the backing store.
+ */
+static bool wear_leveling_write_u64(uint32_t address, uint64_t value) {
+    write_log_entry_t entry;
+    entry.raw64 = value;
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_write_bulk(address, entry.raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_write_bulk(address, entry.raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_write(address, entry.raw64);
+#endif
+}
+
+/**
+ * Calculates the checksum stored alongside the consolidated data.
+ */
+static uint64_t wear_leveling_checksum(void) {
+    uint64_t hash = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
+#ifdef WEAR_LEVELING_DUAL_BANK
+    hash = fnv_64a_buf(&wear_leveling.sequence, sizeof(wear_leveling.sequence), hash);
+#endif // WEAR_LEVELING_DUAL_BANK
+    return hash;
+}
+
+#ifdef WEAR_LEVELING_DUAL_BANK
+/**
+ * Gets the start address of the bank which is not in use.
+ */
+static inline uint32_t wear_leveling_inactive_bank(void) {
+    return wear_leveling.bank_address == 0 ? (WEAR_LEVELING_BANK_SIZE) : 0;
+}
+
+/**
+ * Checks whether a bank holds consolidated data matching its checksum, without disturbing the cache.
+ */
+static bool wear_leveling_bank_is_valid(uint32_t bank_address, uint64_t *sequence) {
+    uint64_t hash = FNV1A_64_INIT;
+    for (uint32_t offset = 0; offset < (WEAR_LEVELING_LOGICAL_SIZE); offset += (BACKING_STORE_WRITE_SIZE)) {
+        backing_store_int_t value;
+        if (!backing_store_read(bank_address + offset, &value)) {
+            return false;
+        }
+        hash = fnv_64a_buf(&value, sizeof(value), hash);
+    }
+
+    uint64_t expected;
+    if (!wear_leveling_read_u64(bank_address + (WEAR_LEVELING_LOGICAL_SIZE), sequence) || !wear_leveling_read_u64(bank_address + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &expected)) {
+        return false;
+    }
+    hash = fnv_64a_buf(sequence, sizeof(*sequence), hash);
+    return hash == expected;
+}
+
+/**
+ * Picks the bank to use, being the valid one with the highest sequence number.
+ * The other bank is scheduled to be erased.
+ */
+static void wear_leveling_select_bank(void) {
+    uint64_t sequence0, sequence1;
+    bool     valid0 = wear_leveling_bank_is_valid(0, &sequence0);
+    bool     valid1 = wear_leveling_bank_is_valid((WEAR_LEVELING_BANK_SIZE), &sequence1);
+
+    wear_leveling.bank_address  = (valid1 && (!valid0 || sequence1 > sequence0)) ? (WEAR_LEVELING_BANK_SIZE) : 0;
+    wear_leveling.erase_address = wear_leveling_inactive_bank();
+    wl_dprintf("Using bank %d\n", (int)(wear_leveling.bank_address / (WEAR_LEVELING_BANK_SIZE)));
+}
+
+/**
+ * Whether the inactive bank is ready to be consolidated into.
+ */
+static inline bool wear_leveling_inactive_bank_erased(void) {
+    return wear_leveling.erase_address >= wear_leveling_inactive_bank() + (WEAR_LEVELING_BANK_SIZE);
+}
+
+/**
+ * Checks whether a sector of the backing store reads back as erased.
+ */
+static bool wear_leveling_sector_is_blank(uint32_t address) {
+    backing_store_int_t values[8];
+    for (uint32_t offset = 0; offset < (BACKING_STORE_ERASE_SIZE); offset += sizeof(values)) {
+        size_t count = sizeof(values) / sizeof(backing_store_int_t);
+        if (offset + sizeof(values) > (BACKING_STORE_ERASE_SIZE)) {
+            count = ((BACKING_STORE_ERASE_SIZE) - offset) / sizeof(backing_store_int_t);
+        }
+        if (!backing_store_read_bulk(address + offset, values, count)) {
+            return false;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if (values[i] != 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Starts erasing the next sector of the inactive bank, or skips over it if it's blank already.
+ * The backing store stays unlocked until the erase completes.
+ */
+static bool wear_leveling_begin_erase_next_sector(void) {
+    if (wear_leveling_sector_is_blank(wear_leveling.erase_address)) {
+        wear_leveling.erase_address += (BACKING_STORE_ERASE_SIZE);
+        return true;
+    }
+
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return false;
+    }
+
+    wl_dprintf("Erasing inactive bank at 0x%04X\n", (int)wear_leveling.erase_address);
+    if (!backing_store_begin_erase_range(wear_leveling.erase_address, (BACKING_STORE_ERASE_SIZE))) {
+        wl_dprintf("Failed to erase inactive bank\n");
+        if (lock_status == STATUS_SUCCESS) {
+            wear_leveling_lock();
+        }
+        return false;
+    }
+
+    wear_leveling.erasing        = true;
+    wear_leveling.erase_unlocked = (lock_status == STATUS_SUCCESS);
+    return true;
+}
+
+/**
+ * Checks on the erase in progress, moving on to the next sector once it's complete.
+ */
+static backing_store_erase_status_t wear_leveling_poll_erase(void) {
+    backing_store_erase_status_t status = backing_store_poll_erase();
+    if (status == BACKING_STORE_ERASE_BUSY) {
+        return status;
+    }
+
+    wear_leveling.erasing = false;
+    if (wear_leveling.erase_unlocked) {
+        wear_leveling.erase_unlocked = false;
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = BACKING_STORE_ERASE_FAILED;
+        }
+    }
+
+    if (status == BACKING_STORE_ERASE_DONE) {
+        wear_leveling.erase_address += (BACKING_STORE_ERASE_SIZE);
+    } else {
+        // The sector is retried next time around
+        wl_dprintf("Failed to erase inactive bank\n");
+    }
+    return status;
+}
+
+/**
+ * Blocks until the erase in progress, if any, has completed.
+ */
+static bool wear_leveling_wait_erase(void) {
+    backing_store_erase_status_t status = BACKING_STORE_ERASE_DONE;
+    while (wear_leveling.erasing) {
+        status = wear_leveling_poll_erase();
+    }
+    return status != BACKING_STORE_ERASE_FAILED;
 }
+#endif // WEAR_LEVELING_DUAL_BANK
 
 /**
  * Reads the consolidated data from the backing store into the cache.
@@ -213,26 +432,27 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
     wl_dprintf("Reading consolidated data\n");
 
     wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
-    if (!backing_store_read_bulk(0, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+    if (!backing_store_read_bulk(wear_leveling.bank_address, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
         wl_dprintf("Failed to read from backing store\n");
         status = WEAR_LEVELING_FAILED;
     }
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+    if (status != WEAR_LEVELING_FAILED && !wear_leveling_read_u64(wear_leveling.bank_address + (WEAR_LEVELING_LOGICAL_SIZE), &wear_leveling.sequence)) {
+        wl_dprintf("Failed to read sequence number\n");
+        status = WEAR_LEVELING_FAILED;
+    }
+#endif // WEAR_LEVELING_DUAL_BANK
+
     // Verify the FNV1a_64 result
     if (status != WEAR_LEVELING_FAILED) {
-        uint64_t          expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
-        write_log_entry_t entry;
+        uint64_t expected = wear_leveling_checksum();
+        uint64_t actual   = 0;
         wl_dprintf("Reading checksum\n");
-#if BACKING_STORE_WRITE_SIZE == 2
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4);
-#elif BACKING_STORE_WRITE_SIZE == 4
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2);
-#elif BACKING_STORE_WRITE_SIZE == 8
-        backing_store_read((WEAR_LEVELING_LOGICAL_SIZE) + 0, &entry.raw64);
-#endif
+        wear_leveling_read_u64(wear_leveling.bank_address + (WEAR_LEVELING_LOGICAL_SIZE) + (WEAR_LEVELING_BANK_HEADER_SIZE) - 8, &actual);
         // If we have a mismatch, clear the cache but do not flag a failure,
         // which will cater for the completely clean MCU case.
-        if (entry.raw64 == expected) {
+        if (actual == expected) {
             wl_dprintf("Checksum matches, consolidated data is correct\n");
         } else {
             wl_dprintf("Checksum mismatch, clearing cache\n");
@@ -249,43 +469,35 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
 }
 
 /**
- * Writes the current cache to consolidated data at the beginning of the backing store.
+ * Writes the current cache to consolidated data at the beginning of the supplied bank.
  * Does not clear the write log.
  * Pre-condition: this is just after an erase, so we can write directly without reading.
  */
-static wear_leveling_status_t wear_leveling_write_consolidated(void) {
+static wear_leveling_status_t wear_leveling_write_consolidated(uint32_t bank_address) {
     wl_dprintf("Writing consolidated data\n");
 
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     wear_leveling_status_t      status      = WEAR_LEVELING_CONSOLIDATED;
-    if (!backing_store_write_bulk(0, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+    if (!backing_store_write_bulk(bank_address, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
         wl_dprintf("Failed to write to backing store\n");
         status = WEAR_LEVELING_FAILED;
     }
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+    if (status != WEAR_LEVELING_FAILED) {
+        wl_dprintf("Writing sequence number\n");
+        if (!wear_leveling_write_u64(bank_address + (WEAR_LEVELING_LOGICAL_SIZE), wear_leveling.sequence)) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+#endif // WEAR_LEVELING_DUAL_BANK
+
     if (status != WEAR_LEVELING_FAILED) {
-        // Write out the FNV1a_64 result of the consolidated data
-        write_log_entry_t entry;
-        entry.raw64 = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
+        // Write out the FNV1a_64 result of the consolidated data -- in dual-bank mode, this commits the bank
         wl_dprintf("Writing checksum\n");
-        do {
-#if BACKING_STORE_WRITE_SIZE == 2
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 4
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 8
-            if (!backing_store_write((WEAR_LEVELING_LOGICAL_SIZE), entry.raw64)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#endif
-        } while (0);
+        if (!wear_leveling_write_u64(bank_address + (WEAR_LEVELING_LOGICAL_SIZE) + (WEAR_LEVELING_BANK_HEADER_SIZE) - 8, wear_leveling_checksum())) {
+            status = WEAR_LEVELING_FAILED;
+        }
     }
 
     if (lock_status == STATUS_SUCCESS) {
@@ -294,6 +506,44 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
     return status;
 }
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+/**
+ * Forces a write of the current cache.
+ * Writes into the inactive bank, which becomes the active bank once complete.
+ * A power loss before the checksum is written leaves the previous bank in use.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_force(void) {
+    const uint32_t target = wear_leveling_inactive_bank();
+
+    // The inactive bank is normally erased in the background, finish off anything that's left.
+    while (wear_leveling.erasing || !wear_leveling_inactive_bank_erased()) {
+        bool ok = wear_leveling.erasing ? wear_leveling_wait_erase() : wear_leveling_begin_erase_next_sector();
+        if (!ok) {
+            return WEAR_LEVELING_FAILED;
+        }
+    }
+
+    // Write the cache to the start of the inactive bank.
+    wear_leveling.sequence++;
+    wear_leveling_status_t status = wear_leveling_write_consolidated(target);
+    if (status == WEAR_LEVELING_FAILED) {
+        wl_dprintf("Failed to write consolidated data\n");
+        // Stay on the current bank, the partially-written one needs erasing again before the next attempt.
+        wear_leveling.sequence--;
+        wear_leveling.erase_address = target;
+        return status;
+    }
+
+    // Swap banks, the previous one gets erased in the background.
+    wear_leveling.erase_address = wear_leveling.bank_address;
+    wear_leveling.bank_address  = target;
+
+    // Next write of the log occurs after the consolidated values at the start of the bank.
+    wear_leveling.write_address = target + (WEAR_LEVELING_LOGICAL_SIZE) + (WEAR_LEVELING_BANK_HEADER_SIZE);
+
+    return status;
+}
+#else
 /**
  * Forces a write of the current cache.
  * Erases the backing store, including the write log.
@@ -310,16 +560,17 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     }
 
     // Write the cache to the first section of the backing store.
-    wear_leveling_status_t status = wear_leveling_write_consolidated();
+    wear_leveling_status_t status = wear_leveling_write_consolidated(0);
     if (status == WEAR_LEVELING_FAILED) {
         wl_dprintf("Failed to write consolidated data\n");
     }
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + (WEAR_LEVELING_BANK_HEADER_SIZE);
 
     return status;
 }
+#endif // WEAR_LEVELING_DUAL_BANK
 
 /**
  * Potential write of the current cache to the backing store.
@@ -329,7 +580,7 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
-    if (wear_leveling.write_address >= (WEAR_LEVELING_BACKING_SIZE)) {
+    if (wear_leveling.write_address >= wear_leveling.bank_address + (WEAR_LEVELING_BANK_SIZE)) {
         return wear_leveling_consolidate_force();
     }
 
@@ -342,6 +593,11 @@ static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_append_raw(backing_store_int_t value) {
+    // If an earlier consolidation failed the log is still full -- retry it, the cache already holds the new value
+    if (wear_leveling.write_address >= wear_leveling.bank_address + (WEAR_LEVELING_BANK_SIZE)) {
+        return wear_leveling_consolidate_force();
+    }
+
     bool ok = backing_store_write(wear_leveling.write_address, value);
     if (!ok) {
         wl_dprintf("Failed to write to backing store\n");
@@ -477,8 +733,8 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
     wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
     bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
-    while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
+    uint32_t               address         = wear_leveling.bank_address + (WEAR_LEVELING_LOGICAL_SIZE) + (WEAR_LEVELING_BANK_HEADER_SIZE);
+    while (!cancel_playback && address < wear_leveling.bank_address + (WEAR_LEVELING_BANK_SIZE)) {
         backing_store_int_t value;
         bool                ok = backing_store_read(address, &value);
         if (!ok) {
@@ -617,6 +873,11 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 wear_leveling_status_t wear_leveling_init(void) {
     wl_dprintf("Init\n");
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+    // Don't pull the rug out from under an erase in progress
+    wear_leveling_wait_erase();
+#endif // WEAR_LEVELING_DUAL_BANK
+
     // Reset the cache
     wear_leveling_clear_cache();
 
@@ -627,6 +888,11 @@ wear_leveling_status_t wear_leveling_init(void) {
         return WEAR_LEVELING_FAILED;
     }
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+    // Work out which bank holds the latest consolidated values
+    wear_leveling_select_bank();
+#endif // WEAR_LEVELING_DUAL_BANK
+
     // Read the previous consolidated values, then replay the existing write log so that the cache has the "live" values
     wear_leveling_status_t status = wear_leveling_read_consolidated();
     if (status == WEAR_LEVELING_FAILED) {
@@ -652,6 +918,11 @@ wear_leveling_status_t wear_leveling_init(void) {
 wear_leveling_status_t wear_leveling_erase(void) {
     wl_dprintf("Erase\n");
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+    // Let any erase in progress complete first, it's superseded anyway
+    wear_leveling_wait_erase();
+#endif // WEAR_LEVELING_DUAL_BANK
+
     // Unlock the backing store
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     if (lock_status == STATUS_FAILURE) {
@@ -660,8 +931,13 @@ wear_leveling_status_t wear_leveling_erase(void) {
     }
 
     // Perform the erase
-    bool ret = backing_store_erase();
+    bool ret                   = backing_store_erase();
+    wear_leveling.bank_address = 0;
     wear_leveling_clear_cache();
+#ifdef WEAR_LEVELING_DUAL_BANK
+    // Both banks are blank if the erase succeeded, otherwise the inactive one needs another go
+    wear_leveling.erase_address = ret ? (WEAR_LEVELING_BACKING_SIZE) : (WEAR_LEVELING_BANK_SIZE);
+#endif // WEAR_LEVELING_DUAL_BANK
 
     // Lock the backing store if we acquired the lock successfully
     if (lock_status == STATUS_SUCCESS) {
@@ -691,6 +967,11 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
     memcpy(&wear_leveling.cache[address], value, length);
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+    // The backing store can't be written to while an erase is in progress
+    wear_leveling_wait_erase();
+#endif // WEAR_LEVELING_DUAL_BANK
+
     // Unlock the backing store
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     if (lock_status == STATUS_FAILURE) {
@@ -743,6 +1024,24 @@ wear_leveling_status_t wear_leveling_read(const uint32_t address, void *value, s
     return WEAR_LEVELING_SUCCESS;
 }
 
+/**
+ * Wear-leveling background maintenance.
+ */
+bool wear_leveling_task(bool idle) {
+#ifdef WEAR_LEVELING_DUAL_BANK
+    if (wear_leveling.erasing) {
+        // Erases already underway are seen through regardless, failed sectors are retried when next idle
+        wear_leveling_poll_erase();
+    } else if (idle && !wear_leveling_inactive_bank_erased()) {
+        wear_leveling_begin_erase_next_sector();
+    }
+    return wear_leveling.erasing || !wear_leveling_inactive_bank_erased();
+#else
+    (void)idle;
+    return false;
+#endif // WEAR_LEVELING_DUAL_BANK
+}
+
 /**
  * Weak implementation of bulk read, drivers can implement more optimised implementations.
  */
@@ -766,3 +1065,19 @@ __attribute__((weak)) bool backing_store_write_bulk(uint32_t address, backing_st
     }
     return true;
 }
+
+#ifdef WEAR_LEVELING_DUAL_BANK
+/**
+ * Weak implementation of a non-blocking erase, for drivers which can only erase synchronously.
+ */
+__attribute__((weak)) bool backing_store_begin_erase_range(uint32_t address, uint32_t length) {
+    return backing_store_erase_range(address, length);
+}
+
+/**
+ * Weak implementation of polling for erase completion, matching the synchronous backing_store_begin_erase_range().
+ */
+__attribute__((weak)) backing_store_erase_status_t backing_store_poll_erase(void) {
+    return BACKING_STORE_ERASE_DONE;
+}
+#endif // WEAR_LEVELING_DUAL_BANK
@@ -1,9 +1,17 @@
 // Copyright 2022 Nick Brassel (@tzarc)
 // SPDX-License-Identifier: GPL-2.0-or-later
 #pragma once
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 
+/**
+ * Time without any input, in milliseconds, before background maintenance is started.
+ */
+#ifndef WEAR_LEVELING_IDLE_TIMEOUT
+#    define WEAR_LEVELING_IDLE_TIMEOUT 500
+#endif // WEAR_LEVELING_IDLE_TIMEOUT
+
 /**
  * @typedef Status returned from any wear-leveling API.
  */
@@ -52,3 +60,14 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+/**
+ * Performs background maintenance, such as erasing the bank no longer in use in dual-bank mode.
+ *
+ * Each invocation starts at most a single sector erase, and polls for its completion on subsequent invocations. It
+ * should be called periodically.
+ *
+ * @param idle[in] whether new erases may be started, erases already in progress are polled regardless
+ * @return true if further maintenance is pending
+ */
+bool wear_leveling_task(bool idle);
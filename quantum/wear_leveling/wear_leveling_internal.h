@@ -61,10 +61,31 @@ typedef uint64_t backing_store_int_t;
         } while (0)
 #endif // WEAR_LEVELING_ASSERTS
 
+// Dual-bank mode splits the backing store in two, consolidating into whichever one is not in use
+#ifdef WEAR_LEVELING_DUAL_BANK
+#    define WEAR_LEVELING_BANK_COUNT 2
+#    define WEAR_LEVELING_BANK_HEADER_SIZE 16 // sequence number + FNV1a_64 of the consolidated area
+#else
+#    define WEAR_LEVELING_BANK_COUNT 1
+#    define WEAR_LEVELING_BANK_HEADER_SIZE 8 // FNV1a_64 of the consolidated area
+#endif // WEAR_LEVELING_DUAL_BANK
+
+#define WEAR_LEVELING_BANK_SIZE ((WEAR_LEVELING_BACKING_SIZE) / (WEAR_LEVELING_BANK_COUNT))
+
+// The granularity of backing_store_erase_range(), defaults to erasing a whole bank at once
+#ifndef BACKING_STORE_ERASE_SIZE
+#    define BACKING_STORE_ERASE_SIZE (WEAR_LEVELING_BANK_SIZE)
+#endif // BACKING_STORE_ERASE_SIZE
+
 // Compile-time validation of configurable options
-_Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "Total backing size must be at least twice the size of the logical size");
+_Static_assert(WEAR_LEVELING_BANK_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "Bank size must be at least twice the size of the logical size");
 _Static_assert(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
-_Static_assert(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
+_Static_assert(WEAR_LEVELING_BANK_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Bank size must be a multiple of logical size");
+_Static_assert(WEAR_LEVELING_BANK_SIZE > (WEAR_LEVELING_LOGICAL_SIZE + WEAR_LEVELING_BANK_HEADER_SIZE), "Bank size must leave room for the write log");
+#ifdef WEAR_LEVELING_DUAL_BANK
+_Static_assert(WEAR_LEVELING_BACKING_SIZE % (WEAR_LEVELING_BANK_COUNT * WEAR_LEVELING_LOGICAL_SIZE) == 0, "Backing size must be a multiple of twice the logical size");
+_Static_assert(WEAR_LEVELING_BANK_SIZE % BACKING_STORE_ERASE_SIZE == 0, "Bank size must be a multiple of erase size");
+#endif // WEAR_LEVELING_DUAL_BANK
 
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
@@ -75,6 +96,13 @@ bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, siz
 bool backing_store_lock(void);
 bool backing_store_read(uint32_t address, backing_store_int_t* value);
 bool backing_store_read_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
+#ifdef WEAR_LEVELING_DUAL_BANK
+typedef enum backing_store_erase_status_t { BACKING_STORE_ERASE_DONE = 0, BACKING_STORE_ERASE_BUSY, BACKING_STORE_ERASE_FAILED } backing_store_erase_status_t;
+
+bool                         backing_store_erase_range(uint32_t address, uint32_t length);       // address and length are multiples of BACKING_STORE_ERASE_SIZE
+bool                         backing_store_begin_erase_range(uint32_t address, uint32_t length); // weak implementation already provided which erases synchronously, non-blocking implementation can be implemented by driver
+backing_store_erase_status_t backing_store_poll_erase(void);                                     // weak implementation already provided, needs implementing alongside backing_store_begin_erase_range()
+#endif // WEAR_LEVELING_DUAL_BANK
 
 /**
  * Helper type used to contain a write log entry.
@@ -0,0 +1,100 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "audio.h"
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+static_assert(sizeof(musical_note_t) == 2 * sizeof(uint16_t), "packed notes should be two integers");
+
+musical_note_t packed_song[] = SONG(Q__NOTE(_A4), E__NOTE(_C5), Q__NOTE(_C5), M__NOTE(_E5, 20));
+
+class AudioPackedSongs : public TestFixture {
+   public:
+    void SetUp() override {
+        audio_on();
+        audio_stop_all();
+        audio_set_tempo(TEMPO_DEFAULT);
+    }
+
+    /* Advances time one millisecond at a time, as the driver's timer would */
+    void play_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            advance_time(1);
+            audio_update_state();
+        }
+    }
+};
+
+TEST_F(AudioPackedSongs, PacksNotesAtCompileTime) {
+    EXPECT_EQ(packed_song[0].pitch, 440 * AUDIO_PACKED_PITCH_SCALE);
+    EXPECT_EQ(packed_song[1].pitch, (uint16_t)(NOTE_C5 * AUDIO_PACKED_PITCH_SCALE + 0.5f));
+    // a quarter note at 120 bpm, and a note of 20/64 of a beat rounded to the nearest millisecond
+    EXPECT_EQ(packed_song[0].duration, 125);
+    EXPECT_EQ(packed_song[3].duration, 156);
+}
+
+TEST_F(AudioPackedSongs, ClampsOutOfRangeNotes) {
+    // the highest note fits, anything above it is clamped rather than wrapping around
+    musical_note_t notes[] = SONG(MUSICAL_NOTE(_B8, 64), {AUDIO_PACK_PITCH(9000.0f), AUDIO_PACK_DURATION(100000)}, {AUDIO_PACK_PITCH(-1.0f), 0});
+    EXPECT_EQ(notes[0].pitch, (uint16_t)(NOTE_B8 * AUDIO_PACKED_PITCH_SCALE + 0.5f));
+    EXPECT_EQ(notes[1].pitch, UINT16_MAX);
+    EXPECT_EQ(notes[1].duration, UINT16_MAX);
+    EXPECT_EQ(notes[2].pitch, 0);
+
+    MUSICAL_NOTE_SET(notes[0], 20000.0f, 16);
+    EXPECT_EQ(notes[0].pitch, UINT16_MAX);
+    EXPECT_EQ(notes[0].duration, 125);
+}
+
+TEST_F(AudioPackedSongs, PlaysNotesForTheirDuration) {
+    PLAY_SONG(packed_song);
+    EXPECT_TRUE(audio_is_playing_melody());
+    EXPECT_FLOAT_EQ(audio_get_frequency(0), 440.0f);
+
+    play_for(124);
+    EXPECT_FLOAT_EQ(audio_get_frequency(0), 440.0f);
+    play_for(1);
+    EXPECT_NEAR(audio_get_frequency(0), NOTE_C5, 1.0f / AUDIO_PACKED_PITCH_SCALE);
+
+    // the second C5 is separated from the first by a short rest
+    play_for(62);
+    EXPECT_NEAR(audio_get_frequency(0), NOTE_C5, 1.0f / AUDIO_PACKED_PITCH_SCALE);
+    play_for(1);
+    EXPECT_EQ(audio_get_frequency(0), 0.0f);
+    play_for(audio_duration_to_ms(2));
+    EXPECT_NEAR(audio_get_frequency(0), NOTE_C5, 1.0f / AUDIO_PACKED_PITCH_SCALE);
+
+    play_for(125);
+    EXPECT_NEAR(audio_get_frequency(0), NOTE_E5, 1.0f / AUDIO_PACKED_PITCH_SCALE);
+    play_for(155);
+    EXPECT_TRUE(audio_is_playing_melody());
+    play_for(1);
+    EXPECT_FALSE(audio_is_playing_melody());
+}
+
+TEST_F(AudioPackedSongs, ScalesDurationsToTempo) {
+    audio_set_tempo(TEMPO_DEFAULT / 2);
+    PLAY_SONG(packed_song);
+
+    play_for(249);
+    EXPECT_FLOAT_EQ(audio_get_frequency(0), 440.0f);
+    play_for(1);
+    EXPECT_NEAR(audio_get_frequency(0), NOTE_C5, 1.0f / AUDIO_PACKED_PITCH_SCALE);
+}
+
+TEST_F(AudioPackedSongs, PlaysClicks) {
+    audio_play_click(10, 1000.0f, 20);
+    EXPECT_EQ(audio_get_frequency(0), 0.0f);
+
+    play_for(10);
+    EXPECT_NEAR(audio_get_frequency(0), 1000.0f, 1.0f / AUDIO_PACKED_PITCH_SCALE);
+}
+
+} // namespace
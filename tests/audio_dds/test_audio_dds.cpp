@@ -0,0 +1,327 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "audio.h"
+#include "audio_dds.h"
+}
+
+namespace {
+
+using pcm_t = std::vector<int16_t>;
+
+constexpr int16_t VOICE_FULL_SCALE = 32767 / AUDIO_DDS_VOICES;
+
+size_t ms_to_samples(uint32_t ms) {
+    return ms * AUDIO_DDS_SAMPLE_RATE / 1000;
+}
+
+void render(pcm_t &pcm, size_t length) {
+    size_t start = pcm.size();
+    pcm.resize(start + length);
+    // render in chunks of a typical DMA half buffer
+    for (size_t done = 0; done < length; done += 64) {
+        audio_dds_render(pcm.data() + start + done, std::min<size_t>(64, length - done));
+    }
+}
+
+/* Plays a song in the format of song_list.h on the first voice */
+template <size_t N>
+pcm_t render_song(const float (&song)[N][2]) {
+    pcm_t pcm;
+    for (size_t i = 0; i < N; i++) {
+        uint32_t increment = audio_dds_increment(song[i][0]);
+        audio_dds_voice_stop(0);
+        if (increment) {
+            audio_dds_voice_start(0, increment);
+        }
+        render(pcm, ms_to_samples(audio_duration_to_ms(song[i][1])));
+    }
+    audio_dds_stop_all();
+    while (audio_dds_is_active()) {
+        render(pcm, 64);
+    }
+    return pcm;
+}
+
+/* Plays chords, each row holding one frequency per voice */
+template <size_t N>
+pcm_t render_chords(const float (&chords)[N][AUDIO_DDS_VOICES], uint32_t ms) {
+    pcm_t pcm;
+    for (size_t i = 0; i < N; i++) {
+        for (uint8_t v = 0; v < AUDIO_DDS_VOICES; v++) {
+            uint32_t increment = audio_dds_increment(chords[i][v]);
+            if (increment) {
+                audio_dds_voice_start(v, increment);
+            } else {
+                audio_dds_voice_stop(v);
+            }
+        }
+        render(pcm, ms_to_samples(ms));
+    }
+    audio_dds_stop_all();
+    while (audio_dds_is_active()) {
+        render(pcm, 64);
+    }
+    return pcm;
+}
+
+/* FNV-1a over the little endian samples */
+uint32_t pcm_hash(const pcm_t &pcm) {
+    uint32_t hash = 2166136261u;
+    for (int16_t sample : pcm) {
+        uint16_t bits = (uint16_t)sample;
+        hash          = (hash ^ (bits & 0xff)) * 16777619u;
+        hash          = (hash ^ (bits >> 8)) * 16777619u;
+    }
+    return hash;
+}
+
+/* Writes raw PCM to $AUDIO_DDS_PCM_DIR for listening to, or for regenerating the golden hashes */
+void dump_pcm(const pcm_t &pcm, const char *name) {
+    const char *dir = std::getenv("AUDIO_DDS_PCM_DIR");
+    if (dir == nullptr) {
+        return;
+    }
+    std::string path = std::string(dir) + "/" + name + ".pcm";
+    FILE       *file = std::fopen(path.c_str(), "wb");
+    if (file != nullptr) {
+        std::fwrite(pcm.data(), sizeof(int16_t), pcm.size(), file);
+        std::fclose(file);
+    }
+}
+
+size_t rising_zero_crossings(const pcm_t &pcm, size_t from, size_t to) {
+    size_t crossings = 0;
+    for (size_t i = from + 1; i < to; i++) {
+        if (pcm[i - 1] < 0 && pcm[i] >= 0) {
+            crossings++;
+        }
+    }
+    return crossings;
+}
+
+int16_t peak(const pcm_t &pcm, size_t from, size_t to) {
+    int16_t result = 0;
+    for (size_t i = from; i < to; i++) {
+        result = std::max<int16_t>(result, std::abs(pcm[i]));
+    }
+    return result;
+}
+
+class AudioDds : public testing::Test {
+   protected:
+    void SetUp() override {
+        audio_dds_init();
+    }
+};
+
+} // namespace
+
+TEST_F(AudioDds, SilentWithoutVoices) {
+    pcm_t pcm;
+    render(pcm, 256);
+
+    EXPECT_FALSE(audio_dds_is_active());
+    EXPECT_EQ(peak(pcm, 0, pcm.size()), 0);
+}
+
+TEST_F(AudioDds, PlaysRequestedFrequency) {
+    pcm_t pcm;
+    audio_dds_voice_start(0, audio_dds_increment(440.0f));
+    render(pcm, AUDIO_DDS_SAMPLE_RATE);
+
+    size_t crossings = rising_zero_crossings(pcm, 0, pcm.size());
+    EXPECT_GE(crossings, 439u);
+    EXPECT_LE(crossings, 441u);
+}
+
+TEST_F(AudioDds, FollowsEnvelope) {
+    pcm_t pcm;
+    audio_dds_voice_start(0, audio_dds_increment(1000.0f));
+    render(pcm, ms_to_samples(AUDIO_DDS_ATTACK_MS + AUDIO_DDS_DECAY_MS + 100));
+
+    // the attack ramps up from silence instead of clicking
+    EXPECT_LT(peak(pcm, 0, ms_to_samples(1)), VOICE_FULL_SCALE / 4);
+    // reaching full scale at the end of the attack
+    EXPECT_GT(peak(pcm, 0, ms_to_samples(AUDIO_DDS_ATTACK_MS + 2)), VOICE_FULL_SCALE * 95 / 100);
+    // and holding the sustain level after the decay
+    int16_t sustain = peak(pcm, pcm.size() - ms_to_samples(20), pcm.size());
+    EXPECT_NEAR(sustain, VOICE_FULL_SCALE * AUDIO_DDS_SUSTAIN_PERCENT / 100, VOICE_FULL_SCALE / 50);
+
+    audio_dds_voice_stop(0);
+    EXPECT_TRUE(audio_dds_is_active());
+    size_t released = pcm.size();
+    render(pcm, ms_to_samples(AUDIO_DDS_RELEASE_MS + 1));
+
+    EXPECT_FALSE(audio_dds_is_active());
+    EXPECT_LT(peak(pcm, released + ms_to_samples(AUDIO_DDS_RELEASE_MS / 2), pcm.size()), sustain / 2 + 1);
+    EXPECT_EQ(pcm.back(), 0);
+}
+
+TEST_F(AudioDds, RetuningKeepsPhase) {
+    pcm_t pcm;
+    audio_dds_voice_start(0, audio_dds_increment(440.0f));
+    render(pcm, 100);
+    audio_dds_voice_start(0, audio_dds_increment(445.0f));
+    render(pcm, 2);
+
+    // a jump in pitch continues the waveform rather than starting it over
+    EXPECT_LT(std::abs(pcm[100] - pcm[99]), VOICE_FULL_SCALE / 8);
+}
+
+TEST_F(AudioDds, SurvivingTonesKeepTheirVoices) {
+    const uint32_t c4 = audio_dds_increment(NOTE_C4), e4 = audio_dds_increment(NOTE_E4), g4 = audio_dds_increment(NOTE_G4);
+
+    // each voice playing one tone throughout
+    pcm_t expected;
+    audio_dds_voice_start(0, c4);
+    audio_dds_voice_start(1, e4);
+    audio_dds_voice_start(2, g4);
+    render(expected, 300);
+    audio_dds_voice_stop(0);
+    render(expected, ms_to_samples(AUDIO_DDS_RELEASE_MS + 10));
+
+    // the tones as the audio core lists them, most recent first
+    audio_dds_init();
+    pcm_t          pcm;
+    const uint32_t chord[] = {g4, e4, c4};
+    audio_dds_set_tones(chord, chord, 3);
+    render(pcm, 300);
+    const uint32_t without_c4[] = {g4, e4};
+    audio_dds_set_tones(without_c4, without_c4, 2);
+    render(pcm, ms_to_samples(AUDIO_DDS_RELEASE_MS + 10));
+
+    EXPECT_EQ(pcm, expected);
+}
+
+TEST_F(AudioDds, ToneKeepsItsVoiceThroughVibrato) {
+    const uint32_t a4 = audio_dds_increment(NOTE_A4), wobble = audio_dds_increment(NOTE_A4 * 1.01f);
+
+    pcm_t expected;
+    audio_dds_voice_start(0, audio_dds_increment(NOTE_E4));
+    audio_dds_voice_start(1, a4);
+    render(expected, 200);
+    audio_dds_voice_start(1, wobble);
+    render(expected, 200);
+
+    audio_dds_init();
+    pcm_t    pcm;
+    uint32_t keys[]       = {audio_dds_increment(NOTE_E4), a4};
+    uint32_t increments[] = {audio_dds_increment(NOTE_E4), a4};
+    audio_dds_set_tones(keys, increments, 2);
+    render(pcm, 200);
+    increments[1] = wobble;
+    audio_dds_set_tones(keys, increments, 2);
+    render(pcm, 200);
+
+    EXPECT_EQ(pcm, expected);
+}
+
+TEST_F(AudioDds, NewToneTakesReleasedVoice) {
+    const uint32_t tones[] = {audio_dds_increment(NOTE_C4), audio_dds_increment(NOTE_E4), audio_dds_increment(NOTE_G4), audio_dds_increment(NOTE_C5), audio_dds_increment(NOTE_E5)};
+
+    pcm_t expected;
+    for (uint8_t v = 0; v < AUDIO_DDS_VOICES; v++) {
+        audio_dds_voice_start(v, tones[v]);
+    }
+    render(expected, 100);
+    audio_dds_voice_stop(0);
+    render(expected, 10);
+    audio_dds_voice_start(0, tones[AUDIO_DDS_VOICES]);
+    render(expected, ms_to_samples(AUDIO_DDS_RELEASE_MS + 10));
+
+    // the first tone stops, and a new one starts while its voice is still fading out
+    audio_dds_init();
+    pcm_t pcm;
+    audio_dds_set_tones(tones, tones, AUDIO_DDS_VOICES);
+    render(pcm, 100);
+    audio_dds_set_tones(tones + 1, tones + 1, AUDIO_DDS_VOICES - 1);
+    render(pcm, 10);
+    audio_dds_set_tones(tones + 1, tones + 1, AUDIO_DDS_VOICES);
+    render(pcm, ms_to_samples(AUDIO_DDS_RELEASE_MS + 10));
+
+    EXPECT_EQ(pcm, expected);
+
+    audio_dds_set_tones(tones, tones, 0);
+    render(pcm, ms_to_samples(AUDIO_DDS_RELEASE_MS + 1));
+    EXPECT_FALSE(audio_dds_is_active());
+}
+
+TEST_F(AudioDds, MixesVoicesWithoutInteraction) {
+    const float  frequencies[] = {NOTE_C4, NOTE_E4, NOTE_G4, NOTE_C5};
+    const size_t length        = ms_to_samples(200);
+
+    std::vector<pcm_t> alone;
+    for (uint8_t v = 0; v < AUDIO_DDS_VOICES; v++) {
+        audio_dds_init();
+        audio_dds_voice_start(v, audio_dds_increment(frequencies[v]));
+        pcm_t pcm;
+        render(pcm, length);
+        alone.push_back(pcm);
+    }
+
+    audio_dds_init();
+    for (uint8_t v = 0; v < AUDIO_DDS_VOICES; v++) {
+        audio_dds_voice_start(v, audio_dds_increment(frequencies[v]));
+    }
+    pcm_t mixed;
+    render(mixed, length);
+
+    for (size_t i = 0; i < length; i++) {
+        int32_t sum = 0;
+        for (const pcm_t &pcm : alone) {
+            sum += pcm[i];
+        }
+        ASSERT_EQ(mixed[i], sum) << "at sample " << i;
+    }
+}
+
+TEST_F(AudioDds, AllVoicesInPhaseDoNotClip) {
+    for (uint8_t v = 0; v < AUDIO_DDS_VOICES; v++) {
+        audio_dds_voice_start(v, audio_dds_increment(100.0f));
+    }
+    pcm_t pcm;
+    render(pcm, ms_to_samples(AUDIO_DDS_ATTACK_MS + 20));
+
+    int16_t loudest = peak(pcm, 0, pcm.size());
+    EXPECT_GT(loudest, 32767 * 95 / 100);
+    EXPECT_LE(loudest, 32767);
+}
+
+TEST_F(AudioDds, StartupSongMatchesGolden) {
+    float song[][2] = SONG(STARTUP_SOUND);
+    pcm_t pcm       = render_song(song);
+    dump_pcm(pcm, "startup_sound");
+
+    EXPECT_EQ(pcm_hash(pcm), 0xfd4d9ac1u);
+}
+
+TEST_F(AudioDds, ColemakSongMatchesGolden) {
+    float song[][2] = SONG(COLEMAK_SOUND);
+    pcm_t pcm       = render_song(song);
+    dump_pcm(pcm, "colemak_sound");
+
+    EXPECT_EQ(pcm_hash(pcm), 0xc4c78deeu);
+}
+
+TEST_F(AudioDds, ChordsMatchGolden) {
+    const float chords[][AUDIO_DDS_VOICES] = {
+        {NOTE_C4, NOTE_E4, NOTE_G4, NOTE_C5},
+        {NOTE_F4, NOTE_A4, NOTE_C5, 0.0f},
+        {NOTE_G4, NOTE_B4, NOTE_D5, NOTE_F5},
+        {NOTE_C4, NOTE_E4, NOTE_G4, NOTE_C5},
+    };
+    pcm_t pcm = render_chords(chords, 150);
+    dump_pcm(pcm, "chords");
+
+    EXPECT_EQ(pcm_hash(pcm), 0x05621a13u);
+}
@@ -0,0 +1,11 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+KEYEVENT_QUEUE_ENABLE = yes
+
+# Run the basic tests, with key events going through the queue
+SRC += $(wildcard tests/basic/*.cpp)
@@ -0,0 +1,361 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <random>
+#include <vector>
+
+#include <functional>
+#include "gtest/gtest.h"
+#include "test_logger.hpp"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+}
+
+namespace {
+
+struct call_t {
+    uint32_t now;
+    uint32_t trigger_time;
+    uint8_t  id;
+};
+
+std::vector<call_t>          calls;
+std::map<uint8_t, uint32_t>  repeat_delays;
+std::function<void(uint8_t)> on_call = [](uint8_t) {};
+extern "C" void              advance_time(uint32_t ms);
+
+uint32_t record_call(uint32_t trigger_time, void *cb_arg) {
+    uint8_t id = (uint8_t)(uintptr_t)cb_arg;
+    calls.push_back({timer_read32(), trigger_time, id});
+    on_call(id);
+    return repeat_delays[id];
+}
+
+void *arg(uint8_t id) {
+    return (void *)(uintptr_t)id;
+}
+
+// One task per millisecond, like the main loop
+void tick(uint32_t ms = 1) {
+    for (uint32_t i = 0; i < ms; i++) {
+        advance_time(1);
+        deferred_exec_task();
+    }
+}
+
+// Not a TestFixture, as that winds the timer back to zero between tests
+class DeferredExec : public testing::Test {
+   public:
+    void SetUp() override {
+        calls.clear();
+        repeat_delays.clear();
+        on_call = [](uint8_t) {};
+    }
+};
+
+TEST_F(DeferredExec, RunsOnceAfterDelay) {
+    deferred_token token = defer_exec(10, record_call, arg(1));
+    EXPECT_NE(token, INVALID_DEFERRED_TOKEN);
+    uint32_t start = timer_read32();
+
+    tick(9);
+    EXPECT_TRUE(calls.empty());
+    tick(1);
+    ASSERT_EQ(calls.size(), 1);
+    EXPECT_EQ(calls[0].now, start + 10);
+    EXPECT_EQ(calls[0].trigger_time, start + 10);
+
+    tick(100);
+    EXPECT_EQ(calls.size(), 1);
+    EXPECT_FALSE(cancel_deferred_exec(token));
+}
+
+TEST_F(DeferredExec, EarlierExecutorScheduledLaterRunsFirst) {
+    defer_exec(50, record_call, arg(1));
+    defer_exec(30, record_call, arg(2));
+    defer_exec(40, record_call, arg(3));
+    deferred_token token = defer_exec(10, record_call, arg(4));
+    EXPECT_TRUE(cancel_deferred_exec(token));
+
+    tick(60);
+    ASSERT_EQ(calls.size(), 3);
+    EXPECT_EQ(calls[0].id, 2);
+    EXPECT_EQ(calls[1].id, 3);
+    EXPECT_EQ(calls[2].id, 1);
+}
+
+TEST_F(DeferredExec, SameTickRunsInSlotOrder) {
+    defer_exec(30, record_call, arg(1));
+    defer_exec(30, record_call, arg(2));
+    defer_exec(10, record_call, arg(3));
+    uint32_t start = timer_read32();
+
+    tick(20);
+    ASSERT_EQ(calls.size(), 1);
+
+    // Takes the slot freed by the third
+    defer_exec(10, record_call, arg(4));
+    tick(10);
+    ASSERT_EQ(calls.size(), 4);
+    EXPECT_EQ(calls[1].id, 1);
+    EXPECT_EQ(calls[2].id, 2);
+    EXPECT_EQ(calls[3].id, 4);
+    for (size_t i = 1; i < calls.size(); i++) {
+        EXPECT_EQ(calls[i].now, start + 30);
+    }
+}
+
+TEST_F(DeferredExec, ExtendingFirstExecutorLetsNextRun) {
+    deferred_token token = defer_exec(10, record_call, arg(1));
+    defer_exec(20, record_call, arg(2));
+    uint32_t start = timer_read32();
+
+    tick(5);
+    EXPECT_TRUE(extend_deferred_exec(token, 30));
+
+    tick(40);
+    ASSERT_EQ(calls.size(), 2);
+    EXPECT_EQ(calls[0].id, 2);
+    EXPECT_EQ(calls[0].now, start + 20);
+    EXPECT_EQ(calls[1].id, 1);
+    EXPECT_EQ(calls[1].now, start + 35);
+}
+
+TEST_F(DeferredExec, RepeatingExecutorCatchesUpOncePerTick) {
+    repeat_delays[1] = 1;
+    deferred_token token = defer_exec(1, record_call, arg(1));
+    uint32_t start = timer_read32();
+
+    // Stall for 5ms, then run once per tick, each with the next trigger time
+    advance_time(5);
+    tick(3);
+    ASSERT_EQ(calls.size(), 3);
+    for (uint32_t i = 0; i < 3; i++) {
+        EXPECT_EQ(calls[i].trigger_time, start + 1 + i);
+        EXPECT_EQ(calls[i].now, start + 6 + i);
+    }
+    EXPECT_TRUE(cancel_deferred_exec(token));
+}
+
+TEST_F(DeferredExec, CallbackCanCancelAndScheduleOthers) {
+    deferred_token later = defer_exec(20, record_call, arg(2));
+    defer_exec(10, record_call, arg(1));
+    uint32_t start = timer_read32();
+
+    on_call = [&](uint8_t id) {
+        if (id == 1) {
+            EXPECT_TRUE(cancel_deferred_exec(later));
+            defer_exec(5, record_call, arg(3));
+        }
+    };
+
+    tick(30);
+    ASSERT_EQ(calls.size(), 2);
+    EXPECT_EQ(calls[0].id, 1);
+    EXPECT_EQ(calls[1].id, 3);
+    EXPECT_EQ(calls[1].now, start + 15);
+}
+
+TEST_F(DeferredExec, TableFull) {
+    std::vector<deferred_token> tokens;
+    for (uint8_t i = 0; i < MAX_DEFERRED_EXECUTORS; i++) {
+        tokens.push_back(defer_exec(100 + i, record_call, arg(i)));
+        EXPECT_NE(tokens.back(), INVALID_DEFERRED_TOKEN);
+    }
+    EXPECT_EQ(defer_exec(1, record_call, arg(0xFF)), INVALID_DEFERRED_TOKEN);
+
+    for (auto token : tokens) {
+        EXPECT_TRUE(cancel_deferred_exec(token));
+    }
+    tick(200);
+    EXPECT_TRUE(calls.empty());
+}
+
+// Random scheduling, extension, cancellation and repetition, checked against a model of when each should run
+TEST_F(DeferredExec, StressAgainstModel) {
+    std::mt19937                      rng(1234);
+    std::map<deferred_token, uint8_t> ids;      // token to id
+    std::map<uint8_t, deferred_token> tokens;   // id to token
+    std::map<uint8_t, uint32_t>       triggers; // id to expected trigger time
+    uint8_t                           next_id = 0;
+
+    for (uint32_t step = 0; step < 20000; step++) {
+        uint32_t now = timer_read32();
+        switch (rng() % 8) {
+            case 0:
+            case 1:
+                if (tokens.size() < MAX_DEFERRED_EXECUTORS) {
+                    while (tokens.count(next_id)) {
+                        next_id++;
+                    }
+                    uint8_t  id    = next_id++;
+                    uint32_t delay = 1 + rng() % 200;
+                    repeat_delays[id] = rng() % 3 == 0 ? 1 + rng() % 50 : 0;
+                    deferred_token token = defer_exec(delay, record_call, arg(id));
+                    ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+                    ids[token]   = id;
+                    tokens[id]   = token;
+                    triggers[id] = now + delay;
+                }
+                break;
+            case 2:
+                if (!tokens.empty()) {
+                    auto     it    = std::next(tokens.begin(), rng() % tokens.size());
+                    uint32_t delay = 1 + rng() % 200;
+                    ASSERT_TRUE(extend_deferred_exec(it->second, delay));
+                    triggers[it->first] = now + delay;
+                }
+                break;
+            case 3:
+                if (!tokens.empty()) {
+                    auto it = std::next(tokens.begin(), rng() % tokens.size());
+                    ASSERT_TRUE(cancel_deferred_exec(it->second));
+                    ids.erase(it->second);
+                    triggers.erase(it->first);
+                    tokens.erase(it);
+                }
+                break;
+            default:
+                break;
+        }
+
+        calls.clear();
+        tick();
+        now = timer_read32();
+
+        // Everything due this tick ran once, at its trigger time, and nothing else did
+        std::map<uint8_t, bool> ran;
+        for (auto &call : calls) {
+            ASSERT_TRUE(triggers.count(call.id)) << "step " << step;
+            ASSERT_FALSE(ran[call.id]) << "step " << step;
+            ASSERT_EQ(call.trigger_time, triggers[call.id]) << "step " << step;
+            ran[call.id] = true;
+        }
+        for (auto it = triggers.begin(); it != triggers.end();) {
+            uint8_t id  = it->first;
+            bool    due = (int32_t)(it->second - now) <= 0;
+            ASSERT_EQ(ran[id], due) << "step " << step << " id " << (int)id;
+            if (due && repeat_delays[id]) {
+                it->second += repeat_delays[id];
+                ++it;
+            } else if (due) {
+                ids.erase(tokens[id]);
+                tokens.erase(id);
+                it = triggers.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    for (auto &token : tokens) {
+        EXPECT_TRUE(cancel_deferred_exec(token.second));
+    }
+}
+
+TEST_F(DeferredExec, TableSizeLimit) {
+    static deferred_executor_t table[DEFERRED_EXEC_MAX_TABLE_COUNT + 1];
+    uint32_t                   last_execution_time = timer_read32();
+
+    // The index of the soonest executor has to fit in its byte
+    EXPECT_EQ(defer_exec_advanced(table, DEFERRED_EXEC_MAX_TABLE_COUNT + 1, 10, record_call, arg(1)), INVALID_DEFERRED_TOKEN);
+
+    // The last slot of the largest table accepted is still found
+    std::vector<deferred_token> tokens;
+    for (size_t i = 0; i < DEFERRED_EXEC_MAX_TABLE_COUNT; i++) {
+        tokens.push_back(defer_exec_advanced(table, DEFERRED_EXEC_MAX_TABLE_COUNT, i == DEFERRED_EXEC_MAX_TABLE_COUNT - 1 ? 5 : 100, record_call, arg(i)));
+        ASSERT_NE(tokens.back(), INVALID_DEFERRED_TOKEN);
+    }
+    for (int i = 0; i < 5; i++) {
+        advance_time(1);
+        deferred_exec_advanced_task(table, DEFERRED_EXEC_MAX_TABLE_COUNT, &last_execution_time);
+    }
+    ASSERT_EQ(calls.size(), 1u);
+    EXPECT_EQ(calls[0].id, DEFERRED_EXEC_MAX_TABLE_COUNT - 1);
+
+    for (auto token : tokens) {
+        cancel_deferred_exec_advanced(table, DEFERRED_EXEC_MAX_TABLE_COUNT, token);
+    }
+}
+
+// The pass over every slot each tick used to make, for comparison
+void linear_scan_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
+    uint32_t now = timer_read32();
+    if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
+        *last_execution_time = now;
+        for (size_t i = 0; i < table_count; ++i) {
+            deferred_executor_t *entry = &table[i];
+            if (entry->token != INVALID_DEFERRED_TOKEN && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
+                uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
+                if (delay_ms > 0) {
+                    entry->trigger_time += delay_ms;
+                } else {
+                    entry->token = INVALID_DEFERRED_TOKEN;
+                }
+            }
+        }
+    }
+}
+
+uint32_t count_call(uint32_t trigger_time, void *cb_arg) {
+    ++*(uint32_t *)cb_arg;
+    return trigger_time % 2 ? 999 : 1001; // staggered around a second
+}
+
+uint32_t count_rare_call(uint32_t trigger_time, void *cb_arg) {
+    ++*(uint32_t *)cb_arg;
+    return 60000;
+}
+
+// Time per tick with a full table of repeating executors, against the linear scan. Timings vary between runs and
+// machines, so nothing is asserted on them: they are logged, and recorded in the XML output.
+TEST_F(DeferredExec, TickCostBenchmark) {
+    const size_t   executors = 32;
+    const uint32_t ticks     = 600000;
+
+    const struct {
+        const char            *name;
+        deferred_exec_callback callback;
+    } loads[] = {{"every_1s", count_call}, {"every_60s", count_rare_call}};
+    const struct {
+        const char *name;
+        void (*task)(deferred_executor_t *, size_t, uint32_t *);
+    } tasks[] = {{"linear_scan", linear_scan_task}, {"soonest_slot", deferred_exec_advanced_task}};
+
+    for (auto &load : loads) {
+        uint32_t call_counts[2] = {0, 0};
+        for (size_t t = 0; t < 2; t++) {
+            std::vector<deferred_executor_t> table(executors);
+            std::vector<deferred_token>      tokens;
+            for (size_t i = 0; i < executors; i++) {
+                tokens.push_back(defer_exec_advanced(table.data(), executors, 1 + i * 31, load.callback, &call_counts[t]));
+            }
+            uint32_t last_execution_time = timer_read32();
+
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < ticks; i++) {
+                advance_time(1);
+                tasks[t].task(table.data(), executors, &last_execution_time);
+            }
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+            double ns_per_tick = (double)elapsed / ticks;
+            test_logger.info() << load.name << " " << tasks[t].name << ": " << ns_per_tick << "ns/tick" << std::endl;
+            RecordProperty(std::string("ns_per_tick_") + load.name + "_" + tasks[t].name, std::to_string(ns_per_tick));
+
+            for (auto token : tokens) {
+                cancel_deferred_exec_advanced(table.data(), executors, token);
+            }
+        }
+        // Both ran the same executors
+        EXPECT_EQ(call_counts[0], call_counts[1]) << load.name;
+        EXPECT_GT(call_counts[0], 0u);
+    }
+}
+
+} // namespace
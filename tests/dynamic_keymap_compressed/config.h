@@ -0,0 +1,13 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define DYNAMIC_KEYMAP_COMPRESSED
+#define DYNAMIC_KEYMAP_LAYER_COUNT 16
+#define DYNAMIC_KEYMAP_COMPRESSED_LAYER_KEYCODE_COUNT 12
+
+// 16 uncompressed layers of 4x10 keys would take 1280 bytes
+#define TOTAL_EEPROM_BYTE_COUNT 1024
@@ -0,0 +1,304 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom.h"
+#include "raw_hid.h"
+#include "via.h"
+
+extern uint32_t eeprom_write_count;
+}
+
+namespace {
+
+constexpr uint16_t LAYER_KEY_COUNT = MATRIX_ROWS * MATRIX_COLS;
+constexpr uint16_t KEY_COUNT       = DYNAMIC_KEYMAP_LAYER_COUNT * LAYER_KEY_COUNT;
+
+/* The logical keymap, as the uncompressed buffer would hold it */
+using keymap_t = std::array<uint16_t, KEY_COUNT>;
+
+uint16_t key_of(uint8_t layer, uint8_t row, uint8_t col) {
+    return (layer * MATRIX_ROWS + row) * MATRIX_COLS + col;
+}
+
+keymap_t read_keymap() {
+    keymap_t keymap;
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                keymap[key_of(layer, row, col)] = dynamic_keymap_get_keycode(layer, row, col);
+            }
+        }
+    }
+    return keymap;
+}
+
+keymap_t read_buffer() {
+    std::array<uint8_t, KEY_COUNT * 2> buffer;
+    dynamic_keymap_get_buffer(0, buffer.size(), buffer.data());
+    keymap_t keymap;
+    for (uint16_t key = 0; key < KEY_COUNT; key++) {
+        keymap[key] = (buffer[key * 2] << 8) | buffer[key * 2 + 1];
+    }
+    return keymap;
+}
+
+/* The keymap the test keymap resets to, layer 0 of KC_NO and transparent above it */
+keymap_t default_keymap() {
+    keymap_t keymap;
+    keymap.fill(KC_TRANSPARENT);
+    std::fill(keymap.begin(), keymap.begin() + LAYER_KEY_COUNT, KC_NO);
+    return keymap;
+}
+
+/* Number of keys of a layer which are not transparent */
+uint16_t layer_used(const keymap_t &keymap, uint8_t layer) {
+    return LAYER_KEY_COUNT - std::count(keymap.begin() + layer * LAYER_KEY_COUNT, keymap.begin() + (layer + 1) * LAYER_KEY_COUNT, KC_TRANSPARENT);
+}
+
+uint16_t layer_capacity(uint8_t layer) {
+    return layer == 0 ? LAYER_KEY_COUNT : DYNAMIC_KEYMAP_COMPRESSED_LAYER_KEYCODE_COUNT;
+}
+
+bool set_key(uint16_t key, uint16_t keycode) {
+    return dynamic_keymap_set_keycode(key / LAYER_KEY_COUNT, (key / MATRIX_COLS) % MATRIX_ROWS, key % MATRIX_COLS, keycode);
+}
+
+std::vector<uint8_t> read_eeprom() {
+    std::vector<uint8_t> eeprom(TOTAL_EEPROM_BYTE_COUNT);
+    for (uint16_t address = 0; address < eeprom.size(); address++) {
+        eeprom[address] = eeprom_read_byte((uint8_t *)(uintptr_t)address);
+    }
+    return eeprom;
+}
+
+void write_eeprom(const std::vector<uint8_t> &eeprom) {
+    for (uint16_t address = 0; address < eeprom.size(); address++) {
+        eeprom_update_byte((uint8_t *)(uintptr_t)address, eeprom[address]);
+    }
+}
+
+std::vector<uint8_t> via_reply;
+
+} // namespace
+
+extern "C" void raw_hid_send(uint8_t *data, uint8_t length) {
+    via_reply.assign(data, data + length);
+}
+
+class DynamicKeymapCompressed : public TestFixture {
+   protected:
+    DynamicKeymapCompressed() {
+        dynamic_keymap_reset();
+    }
+
+    void verify(const keymap_t &expected) {
+        EXPECT_EQ(read_keymap(), expected);
+        EXPECT_EQ(read_buffer(), expected);
+
+        // The index rebuilt from EEPROM agrees
+        dynamic_keymap_reload();
+        EXPECT_EQ(read_keymap(), expected);
+    }
+};
+
+TEST_F(DynamicKeymapCompressed, ResetStoresKeymapFromFlash) {
+    verify(default_keymap());
+}
+
+TEST_F(DynamicKeymapCompressed, SetKeycodeRoundTrips) {
+    keymap_t expected = default_keymap();
+
+    dynamic_keymap_set_keycode(3, 1, 4, KC_A);
+    expected[key_of(3, 1, 4)] = KC_A;
+    dynamic_keymap_set_keycode(15, 3, 9, KC_B);
+    expected[key_of(15, 3, 9)] = KC_B;
+    dynamic_keymap_set_keycode(3, 1, 2, KC_C);
+    expected[key_of(3, 1, 2)] = KC_C;
+    dynamic_keymap_set_keycode(0, 2, 2, KC_TRANSPARENT);
+    expected[key_of(0, 2, 2)] = KC_TRANSPARENT;
+    dynamic_keymap_set_keycode(3, 1, 4, KC_D);
+    expected[key_of(3, 1, 4)] = KC_D;
+    verify(expected);
+
+    dynamic_keymap_set_keycode(3, 1, 2, KC_TRANSPARENT);
+    expected[key_of(3, 1, 2)] = KC_TRANSPARENT;
+    verify(expected);
+}
+
+TEST_F(DynamicKeymapCompressed, RandomEditsRoundTrip) {
+    keymap_t                                expected = default_keymap();
+    std::mt19937                            rng(42);
+    std::uniform_int_distribution<uint16_t> key_dist(0, KEY_COUNT - 1);
+
+    for (int i = 0; i < 2000; i++) {
+        uint16_t key     = key_dist(rng);
+        uint16_t keycode = (rng() % 3 == 0) ? KC_TRANSPARENT : (uint16_t)(rng() & 0x7FFF);
+        uint8_t  layer   = key / LAYER_KEY_COUNT;
+        bool     fits    = keycode == KC_TRANSPARENT || expected[key] != KC_TRANSPARENT || layer_used(expected, layer) < layer_capacity(layer);
+
+        ASSERT_EQ(set_key(key, keycode), fits) << "edit " << i;
+        if (fits) {
+            expected[key] = keycode;
+        }
+        if (i % 100 == 0) {
+            ASSERT_EQ(read_keymap(), expected) << "after " << i << " edits";
+        }
+    }
+    verify(expected);
+}
+
+TEST_F(DynamicKeymapCompressed, BufferRoundTrips) {
+    keymap_t expected = default_keymap();
+    for (uint16_t key = 0; key < KEY_COUNT; key += 7) {
+        expected[key] = (key & 1) ? KC_TRANSPARENT : (uint16_t)(KC_A + key % 26);
+    }
+
+    // Write in chunks of 28 bytes like VIA does, but starting at an odd offset
+    std::array<uint8_t, KEY_COUNT * 2> buffer;
+    for (uint16_t key = 0; key < KEY_COUNT; key++) {
+        buffer[key * 2]     = expected[key] >> 8;
+        buffer[key * 2 + 1] = expected[key] & 0xFF;
+    }
+    EXPECT_TRUE(dynamic_keymap_set_buffer(0, 1, buffer.data()));
+    for (uint16_t offset = 1; offset < buffer.size(); offset += 28) {
+        uint16_t size = std::min<uint16_t>(28, buffer.size() - offset);
+        EXPECT_TRUE(dynamic_keymap_set_buffer(offset, size, buffer.data() + offset));
+    }
+    verify(expected);
+
+    // Reading past the end of the keymap returns zeroes
+    uint8_t tail[4] = {0xAA, 0xAA, 0xAA, 0xAA};
+    dynamic_keymap_get_buffer(KEY_COUNT * 2 - 2, sizeof(tail), tail);
+    EXPECT_EQ(tail[2], 0);
+    EXPECT_EQ(tail[3], 0);
+}
+
+TEST_F(DynamicKeymapCompressed, FullLayerRejectsNewKeys) {
+    keymap_t expected = default_keymap();
+
+    for (uint16_t key = 0; key < DYNAMIC_KEYMAP_COMPRESSED_LAYER_KEYCODE_COUNT; key++) {
+        EXPECT_TRUE(set_key(key_of(5, 0, 0) + key, KC_X));
+        expected[key_of(5, 0, 0) + key] = KC_X;
+    }
+    EXPECT_FALSE(dynamic_keymap_set_keycode(5, 3, 9, KC_Y));
+    // Other layers have room of their own
+    EXPECT_TRUE(dynamic_keymap_set_keycode(6, 3, 9, KC_Y));
+    expected[key_of(6, 3, 9)] = KC_Y;
+    verify(expected);
+
+    // Changing a stored key still works, and making one transparent frees up room
+    EXPECT_TRUE(dynamic_keymap_set_keycode(5, 0, 0, KC_Z));
+    EXPECT_TRUE(dynamic_keymap_set_keycode(5, 0, 1, KC_TRANSPARENT));
+    EXPECT_TRUE(dynamic_keymap_set_keycode(5, 3, 9, KC_Y));
+    expected[key_of(5, 0, 0)] = KC_Z;
+    expected[key_of(5, 0, 1)] = KC_TRANSPARENT;
+    expected[key_of(5, 3, 9)] = KC_Y;
+    verify(expected);
+}
+
+TEST_F(DynamicKeymapCompressed, BufferThatDoesNotFitLeavesLayerUnchanged) {
+    keymap_t             expected = default_keymap();
+    std::vector<uint8_t> buffer(LAYER_KEY_COUNT * 2);
+    for (uint16_t key = 0; key < LAYER_KEY_COUNT; key++) {
+        buffer[key * 2 + 1] = KC_A;
+    }
+
+    EXPECT_FALSE(dynamic_keymap_set_buffer(key_of(2, 0, 0) * 2, 28, buffer.data()));
+    verify(expected);
+}
+
+TEST_F(DynamicKeymapCompressed, EditOnlyWritesItsLayer) {
+    for (uint16_t key = 0; key < 6; key++) {
+        set_key(key_of(4, 1, 0) + key, KC_A + key);
+    }
+
+    std::vector<uint8_t> before = read_eeprom();
+    eeprom_write_count          = 0;
+    EXPECT_TRUE(dynamic_keymap_set_keycode(4, 0, 0, KC_B));
+    std::vector<uint8_t> after = read_eeprom();
+
+    // The keycodes after the new one move up, then the bitmap and the checksum are updated
+    EXPECT_EQ(eeprom_write_count, 7 * 2 + ((MATRIX_COLS + 7) / 8) + 2);
+    std::vector<size_t> changed;
+    for (size_t address = 0; address < before.size(); address++) {
+        if (before[address] != after[address]) {
+            changed.push_back(address);
+        }
+    }
+    ASSERT_FALSE(changed.empty());
+    EXPECT_LT(changed.back() - changed.front(), MATRIX_ROWS * ((MATRIX_COLS + 7) / 8) + DYNAMIC_KEYMAP_COMPRESSED_LAYER_KEYCODE_COUNT * 2 + 2);
+}
+
+TEST_F(DynamicKeymapCompressed, InterruptedEditResetsOnlyThatLayer) {
+    keymap_t expected = default_keymap();
+    EXPECT_TRUE(dynamic_keymap_set_keycode(2, 0, 0, KC_A));
+    expected[key_of(2, 0, 0)] = KC_A;
+    EXPECT_TRUE(dynamic_keymap_set_keycode(3, 1, 1, KC_B));
+
+    // Power is lost before the checksum, the last byte of the layer, is written
+    std::vector<uint8_t> before = read_eeprom();
+    EXPECT_TRUE(dynamic_keymap_set_keycode(3, 0, 0, KC_C));
+    std::vector<uint8_t> torn = read_eeprom();
+    for (size_t address = torn.size(); address-- > 0;) {
+        if (torn[address] != before[address]) {
+            torn[address] = before[address];
+            break;
+        }
+    }
+    write_eeprom(torn);
+
+    dynamic_keymap_reload();
+    EXPECT_EQ(read_keymap(), expected);
+}
+
+TEST_F(DynamicKeymapCompressed, InvalidEepromIsReset) {
+    dynamic_keymap_set_keycode(2, 0, 0, KC_A);
+
+    write_eeprom(std::vector<uint8_t>(TOTAL_EEPROM_BYTE_COUNT, 0xFF));
+    dynamic_keymap_reload();
+    EXPECT_EQ(read_keymap(), default_keymap());
+}
+
+TEST_F(DynamicKeymapCompressed, ViaReportsKeysThatDoNotFit) {
+    for (uint8_t col = 0; col < DYNAMIC_KEYMAP_COMPRESSED_LAYER_KEYCODE_COUNT; col++) {
+        dynamic_keymap_set_keycode(1, col / MATRIX_COLS, col % MATRIX_COLS, KC_X);
+    }
+
+    std::vector<uint8_t> command = {id_dynamic_keymap_set_keycode, 1, 3, 9, 0, KC_Y};
+    command.resize(32);
+    raw_hid_receive(command.data(), command.size());
+    EXPECT_EQ(via_reply[0], id_unhandled);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 3, 9), KC_TRANSPARENT);
+
+    command = {id_dynamic_keymap_set_keycode, 1, 0, 0, 0, KC_Y};
+    command.resize(32);
+    raw_hid_receive(command.data(), command.size());
+    EXPECT_EQ(via_reply[0], id_dynamic_keymap_set_keycode);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 0), KC_Y);
+}
+
+TEST_F(DynamicKeymapCompressed, LookupBenchmark) {
+    for (uint8_t layer = 1; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer += 3) {
+        dynamic_keymap_set_keycode(layer, 2, 5, KC_A);
+    }
+
+    const int lookups = 1000000;
+    uint32_t  sum     = 0;
+    auto      start   = std::chrono::steady_clock::now();
+    for (int i = 0; i < lookups; i++) {
+        sum += dynamic_keymap_get_keycode(i % DYNAMIC_KEYMAP_LAYER_COUNT, (i / 16) % MATRIX_ROWS, (i / 64) % MATRIX_COLS);
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_NE(sum, 0u);
+
+    RecordProperty("lookups_per_second", (int)(lookups / elapsed));
+}
@@ -0,0 +1,11 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Room for the sections of the tests after eeconfig
+#define TOTAL_EEPROM_BYTE_COUNT 128
+
+#define EECONFIG_FLUSH_TIMEOUT 500
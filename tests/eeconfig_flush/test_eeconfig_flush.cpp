@@ -0,0 +1,180 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdio>
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "eeconfig.h"
+#include "suspend.h"
+
+extern uint32_t eeprom_write_count;
+}
+
+namespace {
+
+/* Stand-in for a feature keeping its settings in the user datablock area */
+struct {
+    uint8_t  hue;
+    uint8_t  sat;
+    uint16_t speed;
+    uint32_t flags;
+} lighting;
+
+uint8_t layout;
+
+eeconfig_section_t lighting_section = {
+    .data    = &lighting,
+    .address = (void *)(EECONFIG_SIZE),
+    .size    = sizeof(lighting),
+};
+
+eeconfig_section_t layout_section = {
+    .data    = &layout,
+    .address = (void *)(EECONFIG_SIZE + sizeof(lighting)),
+    .size    = sizeof(layout),
+};
+
+} // namespace
+
+class EeconfigFlush : public TestFixture {
+   public:
+    void SetUp() override {
+        eeconfig_flush_all();
+        eeprom_write_count = 0;
+    }
+};
+
+TEST_F(EeconfigFlush, unicode_mode_is_written_once_quiet) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_MACOS);
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+    set_unicode_input_mode(UNICODE_MODE_WINDOWS);
+    EXPECT_EQ(eeprom_write_count, 0u);
+    EXPECT_NE(eeprom_read_byte(EECONFIG_UNICODEMODE), UNICODE_MODE_WINDOWS);
+
+    idle_for(EECONFIG_FLUSH_TIMEOUT);
+    EXPECT_EQ(eeprom_write_count, 0u);
+
+    run_one_scan_loop();
+    EXPECT_EQ(eeprom_write_count, 1u);
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_UNICODEMODE), UNICODE_MODE_WINDOWS);
+
+    // nothing left to write
+    idle_for(EECONFIG_FLUSH_TIMEOUT * 2);
+    EXPECT_EQ(eeprom_write_count, 1u);
+}
+
+TEST_F(EeconfigFlush, changes_restart_the_wait) {
+    TestDriver driver;
+
+    for (uint8_t i = 0; i < 10; i++) {
+        layout = i;
+        eeconfig_flag_section(&layout_section);
+        idle_for(EECONFIG_FLUSH_TIMEOUT / 2);
+    }
+    EXPECT_EQ(eeprom_write_count, 0u);
+
+    idle_for(EECONFIG_FLUSH_TIMEOUT / 2 + 1);
+    EXPECT_EQ(eeprom_write_count, 1u);
+    EXPECT_EQ(eeprom_read_byte((uint8_t *)layout_section.address), 9);
+}
+
+TEST_F(EeconfigFlush, sections_are_written_together) {
+    TestDriver driver;
+
+    lighting.hue = 10;
+    eeconfig_flag_section(&lighting_section);
+    idle_for(EECONFIG_FLUSH_TIMEOUT / 2);
+    layout = 3;
+    eeconfig_flag_section(&layout_section);
+    lighting.hue = 20;
+    eeconfig_flag_section(&lighting_section);
+
+    idle_for(EECONFIG_FLUSH_TIMEOUT);
+    EXPECT_EQ(eeprom_write_count, 0u);
+    run_one_scan_loop();
+    EXPECT_EQ(eeprom_write_count, sizeof(lighting) + sizeof(layout));
+    EXPECT_EQ(eeprom_read_byte((uint8_t *)lighting_section.address), 20);
+    EXPECT_EQ(eeprom_read_byte((uint8_t *)layout_section.address), 3);
+}
+
+TEST_F(EeconfigFlush, flush_section_writes_only_that_section) {
+    TestDriver driver;
+
+    layout = 4;
+    eeconfig_flag_section(&layout_section);
+    lighting.hue = 30;
+    eeconfig_flag_section(&lighting_section);
+
+    eeconfig_flush_section(&lighting_section);
+    EXPECT_EQ(eeprom_write_count, sizeof(lighting));
+    EXPECT_FALSE(lighting_section.dirty);
+    EXPECT_TRUE(layout_section.dirty);
+
+    idle_for(EECONFIG_FLUSH_TIMEOUT + 1);
+    EXPECT_EQ(eeprom_write_count, sizeof(lighting) + sizeof(layout));
+    EXPECT_EQ(eeprom_read_byte((uint8_t *)layout_section.address), 4);
+}
+
+TEST_F(EeconfigFlush, suspend_writes_straight_away) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_EMACS);
+    layout = 5;
+    eeconfig_flag_section(&layout_section);
+    EXPECT_EQ(eeprom_write_count, 0u);
+
+    suspend_power_down_quantum();
+    EXPECT_EQ(eeprom_write_count, 2u);
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_UNICODEMODE), UNICODE_MODE_EMACS);
+    EXPECT_EQ(eeprom_read_byte((uint8_t *)layout_section.address), 5);
+
+    idle_for(EECONFIG_FLUSH_TIMEOUT);
+    EXPECT_EQ(eeprom_write_count, 2u);
+}
+
+TEST_F(EeconfigFlush, reset_discards_pending_changes) {
+    TestDriver driver;
+
+    layout = 6;
+    eeconfig_flush_section(&layout_section);
+    layout = 7;
+    eeconfig_flag_section(&layout_section);
+
+    eeconfig_init_quantum();
+    eeprom_write_count = 0;
+
+    idle_for(EECONFIG_FLUSH_TIMEOUT);
+    EXPECT_EQ(eeprom_write_count, 0u);
+    EXPECT_FALSE(layout_section.dirty);
+}
+
+TEST_F(EeconfigFlush, EncoderSpinBenchmark) {
+    TestDriver driver;
+
+    // an encoder turned through 100 detents, each changing the lighting settings
+    const uint8_t steps = 100;
+
+    for (uint8_t i = 0; i < steps; i++) {
+        lighting.hue = i;
+        eeconfig_flush_section(&lighting_section);
+        idle_for(10);
+    }
+    const uint32_t immediate = eeprom_write_count;
+
+    eeprom_write_count = 0;
+    for (uint8_t i = 0; i < steps; i++) {
+        lighting.hue = i;
+        eeconfig_flag_section(&lighting_section);
+        idle_for(10);
+    }
+    idle_for(EECONFIG_FLUSH_TIMEOUT);
+    const uint32_t deferred = eeprom_write_count;
+
+    EXPECT_EQ(immediate, steps * sizeof(lighting));
+    EXPECT_EQ(deferred, sizeof(lighting));
+    std::printf("[ BENCHMARK] %u changes: %u bytes written immediately, %u bytes written deferred\n", steps, (unsigned)immediate, (unsigned)deferred);
+}
@@ -0,0 +1,208 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <sstream>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+#include "test_key_trace.hpp"
+
+extern "C" {
+#include "key_trace.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+using testing::Invoke;
+
+namespace {
+std::vector<uint8_t> read_key_trace() {
+    std::vector<uint8_t> dump(key_trace_get_size());
+    key_trace_get_buffer(0, dump.size(), dump.data());
+    return dump;
+}
+} // namespace
+
+class KeyTrace : public TestFixture {
+   public:
+    void SetUp() override {
+        key_trace_clear();
+    }
+};
+
+TEST_F(KeyTrace, records_key_events_and_state) {
+    TestDriver driver;
+    auto       key_shift = KeymapKey(0, 0, 0, KC_LSFT);
+    auto       key_b     = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_shift, key_b});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    key_shift.press();
+    idle_for(20);
+    tap_key(key_b, 30);
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    auto dump = read_key_trace();
+    EXPECT_EQ(dump.size(), KEY_TRACE_HEADER_SIZE + 2 * KEY_TRACE_STATE_SIZE + 4 * KEY_TRACE_KEY_SIZE);
+
+    DecodedKeyTrace trace;
+    ASSERT_TRUE(decode_key_trace(dump, &trace));
+    EXPECT_EQ(trace.flags, 0);
+    ASSERT_EQ(trace.entries.size(), 4u);
+
+    const auto& entries = trace.entries;
+    EXPECT_EQ(entries[0].event.key.col, 0);
+    EXPECT_TRUE(entries[0].event.pressed);
+    ASSERT_TRUE(entries[0].has_state);
+    EXPECT_EQ(entries[0].state.mods, 0);
+
+    EXPECT_EQ(entries[1].event.key.col, 1);
+    EXPECT_TRUE(entries[1].event.pressed);
+    EXPECT_EQ(entries[1].event.time - entries[0].event.time, 20);
+    ASSERT_TRUE(entries[1].has_state);
+    EXPECT_EQ(entries[1].state.mods, MOD_BIT(KC_LSFT));
+
+    // nothing changed since the last state was recorded
+    EXPECT_FALSE(entries[2].event.pressed);
+    EXPECT_EQ(entries[2].event.time - entries[1].event.time, 30);
+    EXPECT_FALSE(entries[2].has_state);
+    EXPECT_FALSE(entries[3].event.pressed);
+    EXPECT_FALSE(entries[3].has_state);
+}
+
+TEST_F(KeyTrace, drops_oldest_records_when_full) {
+    TestDriver driver;
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_b});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    for (int i = 0; i < 20; i++) {
+        tap_key(key_b);
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    auto dump = read_key_trace();
+    EXPECT_LE(dump.size(), KEY_TRACE_HEADER_SIZE + KEY_TRACE_BUFFER_SIZE);
+
+    DecodedKeyTrace trace;
+    ASSERT_TRUE(decode_key_trace(dump, &trace));
+    EXPECT_EQ(trace.flags, KEY_TRACE_WRAPPED);
+    ASSERT_GE(trace.entries.size(), 8u);
+    EXPECT_FALSE(trace.entries.back().event.pressed);
+
+    key_trace_clear();
+    EXPECT_EQ(key_trace_get_size(), KEY_TRACE_HEADER_SIZE);
+}
+
+TEST_F(KeyTrace, reading_the_dump_pauses_recording) {
+    TestDriver driver;
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_b});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_b);
+
+    const uint16_t size = key_trace_get_size();
+    uint8_t        header[KEY_TRACE_HEADER_SIZE];
+    key_trace_get_buffer(0, sizeof(header), header);
+
+    tap_key(key_b);
+    EXPECT_EQ(key_trace_get_size(), size);
+
+    // reading up to the end carries on recording
+    std::vector<uint8_t> rest(size - sizeof(header));
+    key_trace_get_buffer(sizeof(header), rest.size(), rest.data());
+    tap_key(key_b);
+    EXPECT_EQ(key_trace_get_size(), size + 2 * KEY_TRACE_KEY_SIZE);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyTrace, abandoned_read_resumes_recording_after_timeout) {
+    TestDriver driver;
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_b});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_b);
+
+    const uint16_t size = key_trace_get_size();
+    uint8_t        header[KEY_TRACE_HEADER_SIZE];
+    key_trace_get_buffer(0, sizeof(header), header);
+
+    tap_key(key_b);
+    EXPECT_EQ(key_trace_get_size(), size);
+
+    // the host never reads the rest
+    wait_ms(KEY_TRACE_READ_TIMEOUT);
+    tap_key(key_b);
+    EXPECT_EQ(key_trace_get_size(), size + 2 * KEY_TRACE_KEY_SIZE);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyTrace, replay_reproduces_reports) {
+    TestDriver driver;
+    auto       key_lt = KeymapKey(0, 0, 0, LT(1, KC_A));
+    auto       key_b  = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c  = KeymapKey(1, 1, 0, KC_C);
+
+    set_keymap({key_lt, key_b, key_c});
+
+    // B is rolled over the layer tap key, and released after it
+    auto type = [&]() {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_REPORT(driver, (KC_A, KC_B));
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    };
+
+    type();
+    key_lt.press();
+    idle_for(50);
+    key_b.press();
+    idle_for(40);
+    key_lt.release();
+    idle_for(30);
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    auto dump = read_key_trace();
+    idle_for(1000);
+
+    type();
+    replay_key_trace(dump);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyTrace, replay_from_console) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_lt = KeymapKey(0, 0, 0, LT(1, KC_A));
+    auto       key_b  = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c  = KeymapKey(1, 1, 0, KC_C);
+
+    set_keymap({key_lt, key_b, key_c});
+
+    // As reported: the layer tap key is held past the tapping term, and B gets C
+    std::istringstream console(
+        "some debug output\n"
+        "KT 4B 54 01 00 1F 00 03 00 00 00 00 00 00 01 00 00 00 01 00\n"
+        "KT 10 00 00 01 F0 10 00 01 02 00 11 00 01 02 10 11 00 00\n");
+    auto dump = parse_key_trace_console(console);
+    EXPECT_EQ(dump.size(), 37u);
+
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    replay_key_trace(dump);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
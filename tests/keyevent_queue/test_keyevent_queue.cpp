@@ -0,0 +1,127 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <functional>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "keyevent_queue.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+namespace {
+
+std::function<bool(uint16_t, keyrecord_t *)> process_record_user_fun = [](uint16_t keycode, keyrecord_t *record) { return true; };
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    return process_record_user_fun(keycode, record);
+}
+
+keyevent_t make_keyevent(uint8_t row, uint8_t col, bool pressed) {
+    keyevent_t event = {};
+    event.key.row    = row;
+    event.key.col    = col;
+    event.pressed    = pressed;
+    event.type       = KEY_EVENT;
+    return event;
+}
+
+class KeyeventQueue : public TestFixture {
+   public:
+    void SetUp() override {
+        process_record_user_fun = [](uint16_t keycode, keyrecord_t *record) { return true; };
+    }
+};
+
+TEST_F(KeyeventQueue, PushAndPopInOrder) {
+    keyevent_t event;
+    EXPECT_TRUE(keyevent_queue_is_empty());
+    EXPECT_FALSE(keyevent_queue_pop(&event));
+
+    // One slot is kept free to tell a full queue from an empty one
+    for (uint8_t col = 0; col < KEYEVENT_QUEUE_SIZE - 1; col++) {
+        EXPECT_TRUE(keyevent_queue_push(make_keyevent(1, col, true)));
+    }
+    EXPECT_FALSE(keyevent_queue_push(make_keyevent(1, 9, true)));
+
+    for (uint8_t col = 0; col < KEYEVENT_QUEUE_SIZE - 1; col++) {
+        EXPECT_TRUE(keyevent_queue_pop(&event));
+        EXPECT_EQ(event.key.col, col);
+    }
+    EXPECT_TRUE(keyevent_queue_is_empty());
+}
+
+TEST_F(KeyeventQueue, ChangesBeyondQueueSizeAreProcessedInSameScan) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+    auto       key_d = KeymapKey(0, 3, 0, KC_D);
+    auto       key_e = KeymapKey(0, 4, 0, KC_E);
+    auto       key_f = KeymapKey(0, 5, 0, KC_F);
+
+    set_keymap({key_a, key_b, key_c, key_d, key_e, key_f});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D, KC_E));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D, KC_E, KC_F));
+    for (auto key : {key_a, key_b, key_c, key_d, key_e, key_f}) {
+        key.press();
+    }
+    run_one_scan_loop();
+    EXPECT_TRUE(keyevent_queue_is_empty());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B, KC_C, KC_D, KC_E, KC_F));
+    EXPECT_REPORT(driver, (KC_C, KC_D, KC_E, KC_F));
+    EXPECT_REPORT(driver, (KC_D, KC_E, KC_F));
+    EXPECT_REPORT(driver, (KC_E, KC_F));
+    EXPECT_REPORT(driver, (KC_F));
+    EXPECT_EMPTY_REPORT(driver);
+    for (auto key : {key_a, key_b, key_c, key_d, key_e, key_f}) {
+        key.release();
+    }
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyeventQueue, EventsAreTimestampedAtScan) {
+    TestDriver            driver;
+    auto                  key_a = KeymapKey(0, 0, 0, KC_A);
+    std::vector<uint16_t> times;
+
+    set_keymap({key_a});
+    process_record_user_fun = [&times](uint16_t keycode, keyrecord_t *record) {
+        times.push_back(record->event.time);
+        return true;
+    };
+
+    EXPECT_REPORT(driver, (KC_A));
+    idle_for(5);
+    key_a.press();
+    uint16_t pressed_at = timer_read();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_EQ(times.size(), 1);
+    EXPECT_EQ(times[0], pressed_at);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+} // namespace
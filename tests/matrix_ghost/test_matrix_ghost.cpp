@@ -0,0 +1,129 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "test_matrix.h"
+}
+
+using testing::_;
+
+// Ghost detection looks for blanks in the compiled keymap, so point it at the keymap of the test
+extern "C" uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
+    return keymap_key_to_keycode(layer_num, keypos_t{column, row});
+}
+
+class MatrixGhost : public TestFixture {
+   protected:
+    KeymapKey key_a = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey key_b = KeymapKey(0, 1, 0, KC_B);
+    KeymapKey key_c = KeymapKey(0, 0, 1, KC_C);
+    KeymapKey key_d = KeymapKey(0, 1, 1, KC_D);
+
+    // Ghost detection looks at every position of a row, so map the rest of the matrix to blanks
+    void set_ghost_keymap(std::initializer_list<KeymapKey> keys) {
+        set_keymap(keys);
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                if (row > 1 || col > 1) {
+                    add_key(KeymapKey(0, col, row, KC_NO));
+                }
+            }
+        }
+    }
+
+    // Holds A and B, both on row 0
+    void hold_a_and_b(TestDriver& driver) {
+        EXPECT_REPORT(driver, (KC_A));
+        key_a.press();
+        run_one_scan_loop();
+
+        EXPECT_REPORT(driver, (KC_A, KC_B));
+        key_b.press();
+        run_one_scan_loop();
+        VERIFY_AND_CLEAR(driver);
+    }
+
+    void release_a_and_b(TestDriver& driver) {
+        EXPECT_REPORT(driver, (KC_B));
+        key_a.release();
+        run_one_scan_loop();
+
+        EXPECT_EMPTY_REPORT(driver);
+        key_b.release();
+        run_one_scan_loop();
+        VERIFY_AND_CLEAR(driver);
+    }
+};
+
+TEST_F(MatrixGhost, RowWithGhostIsIgnored) {
+    TestDriver driver;
+    set_ghost_keymap({key_a, key_b, key_c, key_d});
+
+    hold_a_and_b(driver);
+
+    // Without diodes, pressing C also makes D show up, so row 1 can't be trusted
+    EXPECT_NO_REPORT(driver);
+    press_key(0, 1);
+    press_key(1, 1);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    release_key(0, 1);
+    release_key(1, 1);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    release_a_and_b(driver);
+}
+
+TEST_F(MatrixGhost, BlankPositionsAreNotGhosts) {
+    TestDriver driver;
+    set_ghost_keymap({key_a, key_b, key_c, KeymapKey(0, 1, 1, KC_NO)});
+
+    hold_a_and_b(driver);
+
+    // There is no key at D, so C is the only real key on row 1
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    press_key(0, 1);
+    press_key(1, 1);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    release_key(0, 1);
+    release_key(1, 1);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    release_a_and_b(driver);
+}
+
+TEST_F(MatrixGhost, TwoKeysOnSeparateColumnsAreNotGhosts) {
+    TestDriver driver;
+    set_ghost_keymap({key_a, key_b, key_c, key_d});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_A, KC_D));
+    key_d.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_D));
+    key_a.release();
+    run_one_scan_loop();
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_d.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
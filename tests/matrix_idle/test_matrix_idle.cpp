@@ -0,0 +1,115 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "matrix_idle.h"
+}
+
+using testing::_;
+
+class MatrixIdle : public TestFixture {
+   protected:
+    KeymapKey key_a = KeymapKey(0, 0, 0, KC_A);
+
+    void SetUp() override {
+        set_keymap({key_a});
+    }
+
+    // Types a key so that the idle timeout starts from now
+    void type_key(TestDriver& driver) {
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        tap_key(key_a);
+        VERIFY_AND_CLEAR(driver);
+    }
+};
+
+TEST_F(MatrixIdle, EntersIdleAfterTimeout) {
+    TestDriver driver;
+
+    type_key(driver);
+    EXPECT_FALSE(is_matrix_idle());
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(MATRIX_IDLE_TIMEOUT - 2);
+    EXPECT_FALSE(is_matrix_idle());
+
+    idle_for(2);
+    EXPECT_TRUE(is_matrix_idle());
+
+    // Every further loop sleeps instead of scanning
+    uint32_t sleeps = matrix_idle_get_stats().sleeps;
+    idle_for(10);
+    EXPECT_EQ(matrix_idle_get_stats().sleeps - sleeps, 10);
+    EXPECT_TRUE(is_matrix_idle());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixIdle, KeyPressedWhileIdleIsNotLost) {
+    TestDriver driver;
+
+    type_key(driver);
+    EXPECT_NO_REPORT(driver);
+    idle_for(MATRIX_IDLE_TIMEOUT + 10);
+    EXPECT_TRUE(is_matrix_idle());
+    VERIFY_AND_CLEAR(driver);
+
+    matrix_idle_stats_t stats = matrix_idle_get_stats();
+
+    // The press is reported by the loop that leaves idle
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    EXPECT_FALSE(is_matrix_idle());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(matrix_idle_get_stats().wakeups - stats.wakeups, 1);
+    EXPECT_GE(matrix_idle_get_stats().idle_time - stats.idle_time, 10);
+}
+
+TEST_F(MatrixIdle, SpuriousWakeupReturnsToIdle) {
+    TestDriver driver;
+
+    type_key(driver);
+    EXPECT_NO_REPORT(driver);
+    idle_for(MATRIX_IDLE_TIMEOUT + 10);
+    EXPECT_TRUE(is_matrix_idle());
+
+    // A wakeup without a key scans once, then goes straight back to idle
+    matrix_idle_wakeup();
+    run_one_scan_loop();
+    EXPECT_FALSE(is_matrix_idle());
+    run_one_scan_loop();
+    EXPECT_TRUE(is_matrix_idle());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixIdle, HeldKeyPreventsIdle) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(MATRIX_IDLE_TIMEOUT * 2);
+    EXPECT_FALSE(is_matrix_idle());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,95 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+
+using testing::_;
+using testing::InSequence;
+
+class PointingMotionInterrupt : public TestFixture {
+   public:
+    PointingMotionInterrupt() {
+        // Drain the initial sensor read, and start right after a report interval.
+        TestDriver driver;
+        idle_for(POINTING_DEVICE_REPORT_INTERVAL_MS + 1);
+        pd_clear_report_count();
+    }
+};
+
+TEST_F(PointingMotionInterrupt, SensorIsNotReadWithoutMotion) {
+    TestDriver driver;
+
+    pd_set_x(10);
+    EXPECT_NO_MOUSE_REPORT(driver);
+    idle_for(POINTING_DEVICE_REPORT_INTERVAL_MS * 4);
+
+    EXPECT_EQ(pd_get_report_count(), 0);
+
+    pd_clear_movement();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingMotionInterrupt, SensorIsReadOncePerInterrupt) {
+    TestDriver driver;
+
+    pd_set_x(10);
+    pd_set_y(-5);
+    pointing_device_motion_interrupt();
+    EXPECT_MOUSE_REPORT(driver, (10, -5, 0, 0, 0));
+    idle_for(POINTING_DEVICE_REPORT_INTERVAL_MS);
+
+    EXPECT_EQ(pd_get_report_count(), 1);
+
+    pd_clear_movement();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingMotionInterrupt, MotionIsCoalescedIntoOneReportPerInterval) {
+    TestDriver driver;
+
+    pd_set_x(3);
+    for (int i = 0; i < POINTING_DEVICE_REPORT_INTERVAL_MS - 1; i++) {
+        pointing_device_motion_interrupt();
+        run_one_scan_loop();
+    }
+
+    EXPECT_MOUSE_REPORT(driver, (3 * (POINTING_DEVICE_REPORT_INTERVAL_MS - 1), 0, 0, 0, 0)).Times(1);
+    run_one_scan_loop();
+
+    EXPECT_EQ(pd_get_report_count(), POINTING_DEVICE_REPORT_INTERVAL_MS - 1);
+
+    pd_clear_movement();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingMotionInterrupt, AccumulatedMotionIsCoalesced) {
+    TestDriver driver;
+
+    pointing_device_accumulate({.x = 5, .y = 1});
+    pointing_device_accumulate({.x = 7, .y = 2});
+    pointing_device_accumulate({.x = -2, .v = 1});
+
+    EXPECT_MOUSE_REPORT(driver, (10, 3, 0, 1, 0)).Times(1);
+    idle_for(POINTING_DEVICE_REPORT_INTERVAL_MS);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingMotionInterrupt, MotionBeyondReportRangeIsCarriedOver) {
+    TestDriver driver;
+    InSequence s;
+
+    for (int i = 0; i < 3; i++) {
+        pointing_device_accumulate({.x = 100, .y = -100});
+    }
+
+    EXPECT_MOUSE_REPORT(driver, (127, -128, 0, 0, 0));
+    EXPECT_MOUSE_REPORT(driver, (127, -128, 0, 0, 0));
+    EXPECT_MOUSE_REPORT(driver, (46, -44, 0, 0, 0));
+    idle_for(POINTING_DEVICE_REPORT_INTERVAL_MS * 3);
+
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define POINTING_DEVICE_SUBPIXEL_ENABLE
+#define POINTING_DEVICE_SUBPIXEL_SCALE 0.5
@@ -0,0 +1,179 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+using testing::Invoke;
+
+class PointingSubpixel : public TestFixture {
+   public:
+    PointingSubpixel() {
+        pointing_device_set_subpixel_config(default_config);
+    }
+
+    // Runs scan loops with constant sensor movement, and returns the total movement sent to the host.
+    std::pair<int, int> total_movement(TestDriver& driver, int16_t x, int16_t y, unsigned loops) {
+        int total_x = 0;
+        int total_y = 0;
+        EXPECT_CALL(driver, send_mouse_mock(_)).Times(AnyNumber()).WillRepeatedly(Invoke([&](report_mouse_t& report) {
+            total_x += report.x;
+            total_y += report.y;
+        }));
+
+        pd_set_x(x);
+        pd_set_y(y);
+        idle_for(loops);
+        pd_clear_movement();
+        run_one_scan_loop();
+
+        VERIFY_AND_CLEAR(driver);
+        return {total_x, total_y};
+    }
+
+    const pointing_device_subpixel_config_t default_config = {
+        .scale              = POINTING_DEVICE_Q16(0.5),
+        .rotation           = 0,
+        .acceleration       = 0,
+        .acceleration_limit = POINTING_DEVICE_Q16(4.0),
+    };
+};
+
+TEST_F(PointingSubpixel, SubCountMovementIsCarriedOver) {
+    TestDriver driver;
+    InSequence s;
+
+    pd_set_x(1);
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (1, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (1, 0, 0, 0, 0));
+    run_one_scan_loop();
+
+    pd_clear_movement();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingSubpixel, NegativeMovementIsCarriedOver) {
+    TestDriver driver;
+
+    auto total = total_movement(driver, -3, 5, 10);
+
+    EXPECT_EQ(total.first, -15);
+    EXPECT_EQ(total.second, 25);
+}
+
+TEST_F(PointingSubpixel, Rotation90MatchesRotationDefine) {
+    TestDriver driver;
+
+    pointing_device_set_subpixel_config({.scale = POINTING_DEVICE_Q16(1.0), .rotation = 90});
+
+    pd_set_x(10);
+    pd_set_y(20);
+    EXPECT_MOUSE_REPORT(driver, (20, -10, 0, 0, 0));
+    run_one_scan_loop();
+
+    pd_clear_movement();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingSubpixel, ArbitraryRotationKeepsPrecision) {
+    TestDriver driver;
+
+    pointing_device_set_subpixel_config({.scale = POINTING_DEVICE_Q16(1.0), .rotation = 45});
+
+    // 10 * cos(45) = 7.07 per report, which would be truncated to 7 without carrying
+    auto total = total_movement(driver, 10, 0, 100);
+
+    EXPECT_EQ(total.first, 707);
+    EXPECT_EQ(total.second, -707);
+}
+
+TEST_F(PointingSubpixel, RotationSurvivesLargeAngles) {
+    TestDriver driver;
+
+    pointing_device_set_subpixel_config({.scale = POINTING_DEVICE_Q16(1.0), .rotation = -270});
+
+    pd_set_x(10);
+    EXPECT_MOUSE_REPORT(driver, (0, -10, 0, 0, 0));
+    run_one_scan_loop();
+
+    pd_clear_movement();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingSubpixel, AccelerationScalesWithSpeed) {
+    TestDriver driver;
+
+    pointing_device_set_subpixel_config({.scale = POINTING_DEVICE_Q16(1.0), .acceleration = POINTING_DEVICE_Q16(0.125), .acceleration_limit = POINTING_DEVICE_Q16(2.0)});
+
+    // Speed 5 gives a multiplier of 1.625
+    auto total = total_movement(driver, 5, 0, 10);
+    EXPECT_EQ(total.first, 81);
+
+    // Speed 50 is limited to a multiplier of 2
+    total = total_movement(driver, 50, 0, 2);
+    EXPECT_EQ(total.first, 200);
+}
+
+TEST_F(PointingSubpixel, AccelerationLimitOfZeroIsUnlimited) {
+    TestDriver driver;
+
+    pointing_device_set_subpixel_config({.scale = POINTING_DEVICE_Q16(1.0), .acceleration = POINTING_DEVICE_Q16(0.125), .acceleration_limit = 0});
+
+    // Speed 16 gives a multiplier of 3
+    auto total = total_movement(driver, 16, 0, 2);
+    EXPECT_EQ(total.first, 96);
+}
+
+TEST_F(PointingSubpixel, UnlimitedAccelerationSaturates) {
+    TestDriver driver;
+    InSequence s;
+
+    // Speed 100 gives a multiplier of about 100000, beyond the range of int32_t in Q16
+    pointing_device_set_subpixel_config({.scale = POINTING_DEVICE_Q16(4.0), .acceleration = POINTING_DEVICE_Q16(250.0), .acceleration_limit = 0});
+
+    pd_set_x(100);
+    EXPECT_MOUSE_REPORT(driver, (XY_REPORT_MAX, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    pd_set_x(-100);
+    EXPECT_MOUSE_REPORT(driver, (XY_REPORT_MIN, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    pd_clear_movement();
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingSubpixel, ScrollIsNotScaled) {
+    TestDriver driver;
+
+    pd_set_v(3);
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 3, 0));
+    run_one_scan_loop();
+
+    pd_clear_movement();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,129 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "keycode_config.h"
+#include "send_string.h"
+}
+
+using testing::_;
+using testing::Invoke;
+
+namespace {
+
+bool nkro_key_is_set(const report_nkro_t& report, uint8_t code) {
+    return report.bits[code >> 3] & (1 << (code & 7));
+}
+
+// Emulates the host side of the NKRO endpoint: keys that went down in a report
+// are processed in ascending usage order, with the modifiers of that report.
+std::string host_text(const std::vector<report_nkro_t>& reports) {
+    std::string   text;
+    report_nkro_t previous = {};
+
+    for (const auto& report : reports) {
+        bool shifted = report.mods & (MOD_BIT(KC_LEFT_SHIFT) | MOD_BIT(KC_RIGHT_SHIFT));
+        for (uint16_t code = KC_A; code < NKRO_REPORT_BITS * 8; code++) {
+            if (!nkro_key_is_set(report, code) || nkro_key_is_set(previous, code)) {
+                continue;
+            }
+            for (uint8_t c = 1; c < 128; c++) {
+                bool c_shifted = (pgm_read_byte(&ascii_to_shift_lut[c / 8]) >> (c % 8)) & 0x01;
+                if (pgm_read_byte(&ascii_to_keycode_lut[c]) == code && c_shifted == shifted) {
+                    text += (char)c;
+                    break;
+                }
+            }
+        }
+        previous = report;
+    }
+    return text;
+}
+
+} // namespace
+
+class SendString : public TestFixture {
+   public:
+    SendString() {
+        keymap_config.nkro = true;
+    }
+    ~SendString() {
+        keymap_config.nkro = false;
+    }
+
+    std::vector<report_nkro_t> capture(TestDriver& driver, const char* string, uint8_t interval) {
+        std::vector<report_nkro_t> reports;
+        EXPECT_CALL(driver, send_nkro_mock(_)).WillRepeatedly(Invoke([&](report_nkro_t& report) { reports.push_back(report); }));
+        send_string_with_delay(string, interval);
+        VERIFY_AND_CLEAR(driver);
+        return reports;
+    }
+};
+
+TEST_F(SendString, packs_ascending_run_into_one_report) {
+    TestDriver driver;
+
+    auto reports = capture(driver, "abc", 0);
+
+    ASSERT_EQ(reports.size(), 2);
+    EXPECT_THAT(reports[0], NkroReport(KC_A, KC_B, KC_C));
+    EXPECT_THAT(reports[1], NkroReport());
+    EXPECT_EQ(host_text(reports), "abc");
+}
+
+TEST_F(SendString, splits_runs_on_repeated_and_descending_keys) {
+    TestDriver driver;
+
+    auto reports = capture(driver, "cba", 0);
+
+    EXPECT_EQ(reports.size(), 4);
+    EXPECT_EQ(host_text(reports), "cba");
+
+    reports = capture(driver, "aa", 0);
+
+    EXPECT_EQ(reports.size(), 4);
+    EXPECT_EQ(host_text(reports), "aa");
+}
+
+TEST_F(SendString, changes_modifiers_between_runs) {
+    TestDriver driver;
+
+    auto reports = capture(driver, "ABcd", 0);
+
+    EXPECT_EQ(host_text(reports), "ABcd");
+    for (const auto& report : reports) {
+        if (nkro_key_is_set(report, KC_C)) {
+            EXPECT_EQ(report.mods, 0);
+        }
+    }
+    EXPECT_THAT(reports.back(), NkroReport());
+}
+
+TEST_F(SendString, packed_text_matches_unpacked_with_fewer_reports) {
+    TestDriver  driver;
+    const char* text = "The quick brown fox jumps over the lazy dog! 0123456789 {Hello, World}\n";
+
+    // A non-zero interval needs per-character timing, so it bypasses packing.
+    auto unpacked = capture(driver, text, 1);
+    auto packed   = capture(driver, text, 0);
+
+    EXPECT_EQ(host_text(unpacked), text);
+    EXPECT_EQ(host_text(packed), text);
+    EXPECT_LT(packed.size() * 2, unpacked.size());
+}
+
+TEST_F(SendString, falls_back_for_special_sequences) {
+    TestDriver driver;
+
+    auto reports = capture(driver, "ab" SS_TAP(X_F1) "cd", 0);
+
+    EXPECT_EQ(host_text(reports), "abcd");
+    EXPECT_THAT(reports.back(), NkroReport());
+}
@@ -0,0 +1,10 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Keys only reach the keyboard through DEBOUNCE_TYPE, like on a real matrix
+#define TEST_MATRIX_DEBOUNCE
+#define DEBOUNCE 5
@@ -0,0 +1,48 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+#include "test_simulator.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class SimulationSymEagerPk : public TestFixture {};
+
+TEST_F(SimulationSymEagerPk, press_is_reported_on_the_next_poll) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    Simulator simulator({.scan_period_us = 1000, .usb_poll_interval_us = 8000});
+    simulator.schedule({{300, 0, 0, true}, {40300, 0, 0, false}});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    simulator.run_to_end();
+    VERIFY_AND_CLEAR(driver);
+
+    // seen on the scan at 1ms and sent straight away, the host polls at 8ms
+    const auto& reports = simulator.reports();
+    ASSERT_EQ(reports.size(), 2u);
+    EXPECT_EQ(reports[0].sent_us, 1000u);
+    EXPECT_EQ(reports[0].received_us, 8000u);
+}
+
+TEST_F(SimulationSymEagerPk, bounce_after_press_is_ignored) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    Simulator simulator;
+    simulator.schedule({{0, 0, 0, true}, {1500, 0, 0, false}, {2500, 0, 0, true}, {30000, 0, 0, false}});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    simulator.run_to_end();
+    VERIFY_AND_CLEAR(driver);
+}
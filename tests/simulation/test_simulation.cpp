@@ -0,0 +1,161 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+
+#include "test_common.hpp"
+#include "test_simulator.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class Simulation : public TestFixture {};
+
+TEST_F(Simulation, press_is_reported_after_debounce_and_poll) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    Simulator simulator({.scan_period_us = 1000, .usb_poll_interval_us = 8000});
+    simulator.schedule({{300, 0, 0, true}, {40300, 0, 0, false}});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    simulator.run_to_end();
+    VERIFY_AND_CLEAR(driver);
+
+    const auto& reports = simulator.reports();
+    ASSERT_EQ(reports.size(), 2u);
+    for (const HostReport& report : reports) {
+        EXPECT_GE(report.received_us, report.sent_us);
+        EXPECT_EQ(report.received_us % 8000, 0u);
+    }
+    // seen on the scan at 1ms, stable 5ms later, polled on the next 8ms frame
+    EXPECT_EQ(reports[0].sent_us, 6000u);
+    EXPECT_EQ(reports[0].received_us, 8000u);
+
+    auto latencies = simulator.press_latencies({key_a});
+    ASSERT_EQ(latencies.size(), 1u);
+    EXPECT_EQ(latencies[0], 7700u);
+}
+
+TEST_F(Simulation, bounce_shorter_than_debounce_is_filtered) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    Simulator simulator;
+    simulator.schedule({{0, 0, 0, true}, {1500, 0, 0, false}, {2500, 0, 0, true}, {3500, 0, 0, false}});
+
+    EXPECT_NO_REPORT(driver);
+    simulator.run_to_end();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Simulation, reports_queue_behind_slow_polls) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_a, key_b});
+
+    Simulator simulator({.scan_period_us = 1000, .usb_poll_interval_us = 10000});
+    simulator.schedule(typing_trace({key_a, key_b}, 2000, 10000));
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    simulator.run_to_end();
+    VERIFY_AND_CLEAR(driver);
+
+    // every report is sent within a few ms, but the host only takes one per poll
+    const auto& reports = simulator.reports();
+    ASSERT_EQ(reports.size(), 4u);
+    for (size_t i = 1; i < reports.size(); i++) {
+        EXPECT_EQ(reports[i].received_us - reports[i - 1].received_us, 10000u);
+    }
+}
+
+TEST_F(Simulation, recorded_trace_is_played_back) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_a, key_b});
+
+    std::istringstream recording(
+        "# time_us row col state\n"
+        "1000 0 0 d\n"
+        "\n"
+        "30000 0 1 d\n"
+        "60000 0 0 u\n"
+        "90000 0 1 u\n");
+    auto trace = parse_trace(recording);
+    ASSERT_EQ(trace.size(), 4u);
+
+    Simulator simulator;
+    simulator.schedule(trace);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    simulator.run_to_end();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(simulator.press_latencies({key_a, key_b}).size(), 2u);
+}
+
+TEST_F(Simulation, typing_latency_benchmark) {
+    TestDriver driver;
+    const char text[] = "the quick brown fox jumps over the lazy dog";
+
+    std::vector<KeymapKey> layout;
+    for (uint8_t i = 0; i < 26; i++) {
+        layout.emplace_back(0, i % MATRIX_COLS, i / MATRIX_COLS, KC_A + i);
+    }
+    layout.emplace_back(0, 26 % MATRIX_COLS, 26 / MATRIX_COLS, KC_SPACE);
+    for (const KeymapKey& key : layout) {
+        add_key(key);
+    }
+
+    std::vector<KeymapKey> keys;
+    for (const char* c = text; *c; c++) {
+        keys.push_back(layout[*c == ' ' ? 26 : *c - 'a']);
+    }
+
+    const SimulatorConfig configs[] = {
+        {.scan_period_us = 1000, .usb_poll_interval_us = 1000},
+        {.scan_period_us = 1000, .usb_poll_interval_us = 8000},
+        {.scan_period_us = 250, .usb_poll_interval_us = 125},
+    };
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    for (const SimulatorConfig& config : configs) {
+        Simulator simulator(config);
+        // about 120 words per minute, with some overlap between keys, and not in step with the scans
+        simulator.schedule(typing_trace(keys, 97300, 120000));
+        simulator.run_to_end();
+
+        auto latencies = simulator.press_latencies(keys);
+        // repeated letters are pressed again while still held, which the keyboard cannot report
+        EXPECT_GE(latencies.size(), keys.size() - 2);
+        std::sort(latencies.begin(), latencies.end());
+        const double mean = std::accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
+        // only shown if the test fails, the XML output has the numbers of every run
+        test_logger.info() << "scan " << config.scan_period_us << "us, poll " << config.usb_poll_interval_us << "us: " << latencies.size() << " presses, latency mean " << (uint32_t)mean << "us, median " << latencies[latencies.size() / 2] << "us, max " << latencies.back() << "us" << std::endl;
+        std::ostringstream name;
+        name << "latency_mean_us_scan_" << config.scan_period_us << "_poll_" << config.usb_poll_interval_us;
+        RecordProperty(name.str(), (int)mean);
+    }
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,22 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+#include "tap_dance_defs.h"
+
+uint16_t get_tapping_term_calls = 0;
+
+uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) {
+    get_tapping_term_calls++;
+    switch (keycode) {
+        case TD(TD_SLOW_AB):
+            return SLOW_TAPPING_TERM;
+        default:
+            return TAPPING_TERM;
+    }
+}
+
+tap_dance_action_t tap_dance_actions[] = {
+    [TD_SLOW_AB] = ACTION_TAP_DANCE_DOUBLE(KC_A, KC_B),
+    [TD_CD]      = ACTION_TAP_DANCE_DOUBLE(KC_C, KC_D),
+};
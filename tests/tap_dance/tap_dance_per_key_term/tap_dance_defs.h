@@ -0,0 +1,21 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SLOW_TAPPING_TERM 300
+
+enum tap_dance_ids {
+    TD_SLOW_AB, // ACTION_TAP_DANCE_DOUBLE(KC_A, KC_B) with SLOW_TAPPING_TERM
+    TD_CD,      // ACTION_TAP_DANCE_DOUBLE(KC_C, KC_D)
+};
+
+extern uint16_t get_tapping_term_calls;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,69 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_keymap_key.hpp"
+#include "tap_dance_defs.h"
+
+using testing::_;
+using testing::InSequence;
+
+class TapDancePerKeyTerm : public TestFixture {};
+
+TEST_F(TapDancePerKeyTerm, FinishesAfterPerKeyTerm) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_slow_ab = KeymapKey{0, 1, 0, TD(TD_SLOW_AB)};
+    auto       key_cd      = KeymapKey{0, 2, 0, TD(TD_CD)};
+
+    set_keymap({key_slow_ab, key_cd});
+
+    /* The default term does not finish the slow dance */
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_slow_ab);
+    idle_for(TAPPING_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(SLOW_TAPPING_TERM - TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Other dances keep the default term */
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_cd);
+    idle_for(TAPPING_TERM - 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TapDancePerKeyTerm, TermIsNotLookedUpEveryScan) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_slow_ab = KeymapKey{0, 1, 0, TD(TD_SLOW_AB)};
+
+    set_keymap({key_slow_ab});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_slow_ab);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Waiting for the dance to time out costs no further lookups */
+    uint16_t calls = get_tapping_term_calls;
+    EXPECT_NO_REPORT(driver);
+    idle_for(SLOW_TAPPING_TERM - 10);
+    EXPECT_EQ(get_tapping_term_calls, calls);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,159 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::Invoke;
+
+namespace {
+
+// Emulates the host: every letter that went down in a report is typed, in upper
+// case while a shift modifier is held.
+std::string host_text(const std::vector<report_keyboard_t>& reports) {
+    std::string       text;
+    report_keyboard_t previous = {};
+
+    for (const auto& report : reports) {
+        bool shifted = report.mods & (MOD_BIT(KC_LEFT_SHIFT) | MOD_BIT(KC_RIGHT_SHIFT));
+        for (uint8_t key : report.keys) {
+            if (key < KC_A || key > KC_Z) {
+                continue;
+            }
+            bool was_down = false;
+            for (uint8_t previous_key : previous.keys) {
+                was_down |= previous_key == key;
+            }
+            if (!was_down) {
+                text += (char)((shifted ? 'A' : 'a') + key - KC_A);
+            }
+        }
+        previous = report;
+    }
+    return text;
+}
+
+} // namespace
+
+class WaitingBuffer : public TestFixture {
+   public:
+    std::vector<KeymapKey> keys;
+
+    WaitingBuffer() {
+        // Home row mods on the left and right hand, plain letters elsewhere.
+        const uint16_t keycodes[26] = {
+            LGUI_T(KC_A), KC_B, KC_C, LCTL_T(KC_D), KC_E, LSFT_T(KC_F), KC_G, KC_H, KC_I, RSFT_T(KC_J), RCTL_T(KC_K), RALT_T(KC_L), KC_M,
+            KC_N,         KC_O, KC_P, KC_Q,         KC_R, LALT_T(KC_S), KC_T, KC_U, KC_V, KC_W,         KC_X,         KC_Y,         KC_Z,
+        };
+        for (uint8_t i = 0; i < 26; i++) {
+            keys.push_back(KeymapKey(0, i % MATRIX_COLS, i / MATRIX_COLS, keycodes[i]));
+            add_key(keys.back());
+        }
+    }
+
+    KeymapKey& key(char letter) {
+        return keys[letter - 'a'];
+    }
+
+    /* Rolls over the letters of the text, pressing one every interval and
+     * holding each for hold milliseconds, so that consecutive keys overlap. */
+    void roll(const std::string& text, uint16_t interval, uint16_t hold) {
+        uint16_t end = (text.size() - 1) * interval + hold;
+        for (uint16_t t = 0; t <= end; t++) {
+            for (size_t i = 0; i < text.size(); i++) {
+                if (t == i * interval) {
+                    key(text[i]).press();
+                } else if (t == i * interval + hold) {
+                    key(text[i]).release();
+                }
+            }
+            run_one_scan_loop();
+        }
+    }
+};
+
+TEST_F(WaitingBuffer, roll_at_200_wpm_with_home_row_mods_keeps_every_key) {
+    TestDriver                     driver;
+    std::vector<report_keyboard_t> reports;
+    const std::string              pangram = "thequickbrownfoxjumpsoverthelazydog";
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t& report) { reports.push_back(report); }));
+
+    /* 200 WPM is a key every 60ms, each held for 90ms. */
+    roll(pangram, 60, 90);
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(host_text(reports), pangram);
+    EXPECT_EQ(reports.back(), report_keyboard_t{});
+}
+
+TEST_F(WaitingBuffer, burst_within_buffer_depth_resolves_as_tap) {
+    TestDriver                     driver;
+    std::vector<report_keyboard_t> reports;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t& report) { reports.push_back(report); }));
+
+    /* Press the shift home row mod, then burst six letters, which queues more
+     * records than the default depth would hold. */
+    key('f').press();
+    run_one_scan_loop();
+    roll("qwerty", 15, 20);
+    key('f').release();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(host_text(reports), "fqwerty");
+    EXPECT_EQ(reports.back(), report_keyboard_t{});
+}
+
+TEST_F(WaitingBuffer, overflow_resolves_oldest_tap_hold_as_hold) {
+    TestDriver                     driver;
+    std::vector<report_keyboard_t> reports;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t& report) { reports.push_back(report); }));
+
+    /* Hold the shift home row mod through a burst of 22 letters within the
+     * tapping term, which overflows the waiting buffer. */
+    key('f').press();
+    run_one_scan_loop();
+    roll("qwertyuiopzxcvbnmqwert", 8, 10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(host_text(reports), "QWERTYUIOPZXCVBNMQWERT");
+
+    /* Releasing the mod-tap key releases the shift. */
+    EXPECT_EMPTY_REPORT(driver);
+    key('f').release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(WaitingBuffer, overflow_keeps_the_roll_after_the_tap_hold) {
+    TestDriver                     driver;
+    std::vector<report_keyboard_t> reports;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t& report) { reports.push_back(report); }));
+
+    /* A fast roll that starts with a home row mod held until the end of it. */
+    key('j').press();
+    run_one_scan_loop();
+    roll("thequickbrownfox", 10, 12);
+    key('j').release();
+    run_one_scan_loop();
+    roll("jumps", 60, 90);
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(host_text(reports), "THEQUICKBROWNFOXjumps");
+    EXPECT_EQ(reports.back(), report_keyboard_t{});
+}
@@ -21,6 +21,8 @@
 
 bool operator==(const report_keyboard_t& lhs, const report_keyboard_t& rhs);
 std::ostream& operator<<(std::ostream& stream, const report_keyboard_t& value);
+bool operator==(const report_nkro_t& lhs, const report_nkro_t& rhs);
+std::ostream& operator<<(std::ostream& stream, const report_nkro_t& value);
 
 class KeyboardReportMatcher : public testing::MatcherInterface<report_keyboard_t&> {
  public:
@@ -37,3 +39,19 @@ template<typename... Ts>
 inline testing::Matcher<report_keyboard_t&> KeyboardReport(Ts... keys) {
     return testing::MakeMatcher(new KeyboardReportMatcher(std::vector<uint8_t>({keys...})));
 }
+
+class NkroReportMatcher : public testing::MatcherInterface<const report_nkro_t&> {
+ public:
+    NkroReportMatcher(const std::vector<uint8_t>& keys);
+    virtual bool MatchAndExplain(const report_nkro_t& report, testing::MatchResultListener* listener) const override;
+    virtual void DescribeTo(::std::ostream* os) const override;
+    virtual void DescribeNegationTo(::std::ostream* os) const override;
+private:
+    report_nkro_t m_report;
+};
+
+
+template<typename... Ts>
+inline testing::Matcher<const report_nkro_t&> NkroReport(Ts... keys) {
+    return testing::MakeMatcher(new NkroReportMatcher(std::vector<uint8_t>({keys...})));
+}
@@ -19,19 +19,48 @@
 #include <string.h>
 
 static matrix_row_t matrix[MATRIX_ROWS] = {};
+#ifdef TEST_MATRIX_DEBOUNCE
+#    include "debounce.h"
+// press_key() and release_key() change the raw matrix, the keyboard only sees it after debouncing
+static matrix_row_t debounced_matrix[MATRIX_ROWS] = {};
+static matrix_row_t previous_matrix[MATRIX_ROWS]  = {};
+#endif
+#ifdef MATRIX_IDLE_TIMEOUT
+static matrix_row_t scanned_matrix[MATRIX_ROWS] = {};
+#endif
 
 void matrix_init(void) {
     clear_all_keys();
+#ifdef TEST_MATRIX_DEBOUNCE
+    memset(debounced_matrix, 0, sizeof(debounced_matrix));
+    memset(previous_matrix, 0, sizeof(previous_matrix));
+    debounce_init(MATRIX_ROWS);
+#endif
     matrix_init_kb();
 }
 
 uint8_t matrix_scan(void) {
+#ifdef MATRIX_IDLE_TIMEOUT
+    memcpy(scanned_matrix, matrix, sizeof(matrix));
+#endif
+#ifdef TEST_MATRIX_DEBOUNCE
+    bool changed = memcmp(previous_matrix, matrix, sizeof(matrix)) != 0;
+    if (changed) memcpy(previous_matrix, matrix, sizeof(matrix));
+    changed = debounce(previous_matrix, debounced_matrix, MATRIX_ROWS, changed);
+    matrix_scan_kb();
+    return changed;
+#else
     matrix_scan_kb();
     return 1;
+#endif
 }
 
 matrix_row_t matrix_get_row(uint8_t row) {
+#ifdef TEST_MATRIX_DEBOUNCE
+    return debounced_matrix[row];
+#else
     return matrix[row];
+#endif
 }
 
 void matrix_print(void) {}
@@ -49,11 +78,36 @@ void release_key(uint8_t col, uint8_t row) {
 }
 
 bool matrix_is_on(uint8_t row, uint8_t col) {
-    return (matrix[row] & ((matrix_row_t)1 << col));
+    return (matrix_get_row(row) & ((matrix_row_t)1 << col));
 }
 
 void clear_all_keys(void) {
     memset(matrix, 0, sizeof(matrix));
 }
 
+#ifdef MATRIX_IDLE_TIMEOUT
+#    include "matrix_idle.h"
+
+bool matrix_idle_enter(void) {
+    // Like the standard matrix, stay awake until the last scan has seen every release
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (scanned_matrix[row]) {
+            return false;
+        }
+    }
+    return !matrix_idle_input_active();
+}
+
+void matrix_idle_exit(void) {}
+
+bool matrix_idle_input_active(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix[row]) {
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
 void led_set(uint8_t usb_led) {}
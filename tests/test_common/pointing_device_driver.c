@@ -18,6 +18,7 @@ typedef struct {
     pd_button_state_t button_state[8];
     uint16_t          cpi;
     bool              initiated;
+    uint32_t          report_count;
 } pd_config_t;
 
 static pd_config_t pd_config = {0};
@@ -27,6 +28,7 @@ void pointing_device_driver_init(void) {
 }
 
 report_mouse_t pointing_device_driver_get_report(report_mouse_t mouse_report) {
+    pd_config.report_count++;
     for (uint8_t i = 0; i < 8; i++) {
         if (pd_config.button_state[i].dirty) {
             pd_config.button_state[i].dirty = false;
@@ -107,3 +109,11 @@ void pd_clear_movement(void) {
 void pd_set_init(bool success) {
     pd_config.initiated = success;
 }
+
+uint32_t pd_get_report_count(void) {
+    return pd_config.report_count;
+}
+
+void pd_clear_report_count(void) {
+    pd_config.report_count = 0;
+}
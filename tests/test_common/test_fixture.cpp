@@ -12,6 +12,7 @@
 #include "test_driver.hpp"
 #include "test_logger.hpp"
 #include "test_matrix.h"
+#include "test_key_trace.hpp"
 #include "test_keymap_key.hpp"
 #include "timer.h"
 
@@ -22,6 +23,7 @@ extern "C" {
 #include "action_layer.h"
 #include "debug.h"
 #include "eeconfig.h"
+#include "key_trace.h"
 #include "keyboard.h"
 
 void set_time(uint32_t t);
@@ -185,6 +187,48 @@ void TestFixture::idle_for(unsigned time) {
     }
 }
 
+void TestFixture::replay_key_trace(const std::vector<uint8_t>& dump) {
+    DecodedKeyTrace trace;
+    ASSERT_TRUE(decode_key_trace(dump, &trace)) << "not a valid key trace";
+    if (trace.entries.empty()) {
+        return;
+    }
+
+    const uint16_t first = trace.entries.front().event.time;
+    const uint16_t start = timer_read();
+
+    for (size_t i = 0; i < trace.entries.size(); i++) {
+        const KeyTraceEntry& entry = trace.entries[i];
+
+        idle_for(TIMER_DIFF_16(start + (uint16_t)(entry.event.time - first), timer_read()));
+
+        if (entry.has_state) {
+            if (i == 0 && (trace.flags & KEY_TRACE_WRAPPED)) {
+                layer_state_set(entry.state.layer_state);
+                default_layer_set(entry.state.default_layer_state);
+                set_mods(entry.state.mods);
+                set_oneshot_mods(entry.state.oneshot_mods);
+            } else {
+                EXPECT_EQ(get_mods(), entry.state.mods) << "mods before key trace event " << i;
+                EXPECT_EQ(get_oneshot_mods(), entry.state.oneshot_mods) << "oneshot mods before key trace event " << i;
+                EXPECT_EQ(layer_state, entry.state.layer_state) << "layer state before key trace event " << i;
+                EXPECT_EQ(default_layer_state, entry.state.default_layer_state) << "default layer state before key trace event " << i;
+            }
+        }
+
+        test_logger.trace() << "key trace event " << i << ": (" << +entry.event.key.col << "," << +entry.event.key.row << ") " << (entry.event.pressed ? "pressed" : "released") << std::endl;
+        if (entry.event.pressed) {
+            press_key(entry.event.key.col, entry.event.key.row);
+        } else {
+            release_key(entry.event.key.col, entry.event.key.row);
+        }
+
+        // Scan without moving on, as the next event may have been seen by a later scan within the same millisecond
+        keyboard_task();
+        housekeeping_task();
+    }
+}
+
 void TestFixture::print_test_log() const {
     const ::testing::TestInfo* const test_info = ::testing::UnitTest::GetInstance()->current_test_info();
     if (HasFailure()) {
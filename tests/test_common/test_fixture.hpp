@@ -63,6 +63,15 @@ class TestFixture : public testing::Test {
     void run_one_scan_loop();
     void idle_for(unsigned ms);
 
+    /**
+     * @brief Plays back a dump recorded with KEY_TRACE_ENABLE, with the same timing and order of key events.
+     *
+     * The first event is played at the current time. Before each event, the
+     * layers and mods are checked against those recorded, except that the first
+     * recorded state is applied instead when older records had been dropped.
+     */
+    void replay_key_trace(const std::vector<uint8_t>& dump);
+
     void expect_layer_state(layer_t layer) const;
 
    protected:
@@ -0,0 +1,82 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_key_trace.hpp"
+#include <sstream>
+#include <string>
+
+extern "C" {
+#include "key_trace.h"
+}
+
+namespace {
+uint32_t read_32(const uint8_t* data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+} // namespace
+
+bool decode_key_trace(const std::vector<uint8_t>& dump, DecodedKeyTrace* trace) {
+    if (dump.size() < KEY_TRACE_HEADER_SIZE || dump[0] != KEY_TRACE_MAGIC_0 || dump[1] != KEY_TRACE_MAGIC_1 || dump[2] != KEY_TRACE_VERSION) {
+        return false;
+    }
+    const size_t end = KEY_TRACE_HEADER_SIZE + (dump[4] | (dump[5] << 8));
+    if (dump.size() < end) {
+        return false;
+    }
+
+    trace->flags = dump[3];
+    trace->entries.clear();
+
+    bool          has_state = false;
+    KeyTraceState state     = {};
+
+    for (size_t position = KEY_TRACE_HEADER_SIZE; position < end;) {
+        const uint8_t* record = &dump[position];
+        switch (record[0]) {
+            case KEY_TRACE_STATE:
+                if (position + KEY_TRACE_STATE_SIZE > end) {
+                    return false;
+                }
+                state     = KeyTraceState{record[1], record[2], (layer_state_t)read_32(&record[3]), (layer_state_t)read_32(&record[7])};
+                has_state = true;
+                position += KEY_TRACE_STATE_SIZE;
+                break;
+            case KEY_TRACE_PRESS:
+            case KEY_TRACE_RELEASE: {
+                if (position + KEY_TRACE_KEY_SIZE > end) {
+                    return false;
+                }
+                keyevent_t event = {
+                    .key     = {.col = record[4], .row = record[3]},
+                    .time    = (uint16_t)(record[1] | (record[2] << 8)),
+                    .type    = KEY_EVENT,
+                    .pressed = record[0] == KEY_TRACE_PRESS,
+                };
+                trace->entries.push_back({event, has_state, state});
+                has_state = false;
+                position += KEY_TRACE_KEY_SIZE;
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+std::vector<uint8_t> parse_key_trace_console(std::istream& stream) {
+    std::vector<uint8_t> dump;
+    std::string          line;
+
+    while (std::getline(stream, line)) {
+        if (line.compare(0, 3, "KT ") != 0) {
+            continue;
+        }
+        std::istringstream bytes(line.substr(3));
+        unsigned           byte;
+        while (bytes >> std::hex >> byte) {
+            dump.push_back(byte);
+        }
+    }
+    return dump;
+}
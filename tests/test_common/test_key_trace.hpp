@@ -0,0 +1,47 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <vector>
+
+extern "C" {
+#include "action_layer.h"
+#include "keyboard.h"
+}
+
+/**
+ * @brief The layers and mods recorded along with a key event, see key_trace.h.
+ */
+struct KeyTraceState {
+    uint8_t       mods;
+    uint8_t       oneshot_mods;
+    layer_state_t layer_state;
+    layer_state_t default_layer_state;
+};
+
+struct KeyTraceEntry {
+    keyevent_t event;
+    /* The state right before the event was processed, only recorded when it changed since the previous one. */
+    bool          has_state;
+    KeyTraceState state;
+};
+
+struct DecodedKeyTrace {
+    uint8_t                    flags;
+    std::vector<KeyTraceEntry> entries;
+};
+
+/**
+ * @brief Decodes a dump as read with key_trace_get_buffer().
+ *
+ * @return false if the dump is malformed or incomplete
+ */
+bool decode_key_trace(const std::vector<uint8_t>& dump, DecodedKeyTrace* trace);
+
+/**
+ * @brief Collects the dump from console output of key_trace_print(), skipping all other lines.
+ */
+std::vector<uint8_t> parse_key_trace_console(std::istream& stream);
@@ -27,6 +27,9 @@ void pd_clear_movement(void);
 
 void pd_set_init(bool success);
 
+uint32_t pd_get_report_count(void);
+void     pd_clear_report_count(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,190 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_simulator.hpp"
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <string>
+
+extern "C" {
+#include "keyboard.h"
+#include "keycodes.h"
+#include "modifiers.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+}
+
+Simulator* Simulator::m_this = nullptr;
+
+namespace {
+bool report_has_key(const report_keyboard_t& report, uint16_t code) {
+    if (IS_MODIFIER_KEYCODE(code)) {
+        return report.mods & MOD_BIT(code);
+    }
+    return std::find(std::begin(report.keys), std::end(report.keys), code) != std::end(report.keys);
+}
+} // namespace
+
+Simulator::Simulator(SimulatorConfig config) : m_config(config), m_driver{&Simulator::keyboard_leds, &Simulator::send_keyboard, &Simulator::send_nkro, &Simulator::send_mouse, &Simulator::send_extra} {
+    // carry on from wherever the test fixture got to
+    m_now_us       = timer_read32() * 1000;
+    m_next_scan_us = m_now_us;
+    m_next_poll_us = m_now_us;
+
+    m_host = host_get_driver();
+    host_set_driver(&m_driver);
+    m_this = this;
+}
+
+Simulator::~Simulator() {
+    host_set_driver(m_host);
+    m_this = nullptr;
+}
+
+void Simulator::schedule(const std::vector<TraceEvent>& trace) {
+    for (TraceEvent event : trace) {
+        event.time_us += m_now_us;
+        m_events.push_back(event);
+    }
+    std::stable_sort(m_events.begin() + m_next_event, m_events.end(), [](const TraceEvent& a, const TraceEvent& b) { return a.time_us < b.time_us; });
+}
+
+void Simulator::run_until(uint32_t time_us) {
+    while (true) {
+        const uint32_t next_event_us = m_next_event < m_events.size() ? m_events[m_next_event].time_us : std::numeric_limits<uint32_t>::max();
+        const uint32_t next_us       = std::min({next_event_us, m_next_scan_us, m_next_poll_us});
+        if (next_us > time_us) {
+            break;
+        }
+        m_now_us = next_us;
+
+        // at the same point in time, the matrix changes before it is scanned, and reports are sent before the host polls
+        if (next_event_us == next_us) {
+            const TraceEvent& event = m_events[m_next_event++];
+            if (event.pressed) {
+                press_key(event.col, event.row);
+            } else {
+                release_key(event.col, event.row);
+            }
+        } else if (m_next_scan_us == next_us) {
+            scan();
+            m_next_scan_us += m_config.scan_period_us;
+        } else {
+            poll();
+            m_next_poll_us += m_config.usb_poll_interval_us;
+        }
+    }
+    m_now_us = time_us;
+}
+
+void Simulator::run_for(uint32_t duration_us) {
+    run_until(m_now_us + duration_us);
+}
+
+void Simulator::run_to_end(uint32_t settle_us) {
+    if (m_next_event < m_events.size()) {
+        run_until(m_events.back().time_us);
+    }
+    while (!m_queue.empty()) {
+        run_for(m_config.usb_poll_interval_us);
+    }
+    run_for(settle_us);
+}
+
+std::vector<uint32_t> Simulator::press_latencies(const std::vector<KeymapKey>& keys) const {
+    std::vector<uint32_t> latencies;
+
+    for (const TraceEvent& event : m_events) {
+        if (!event.pressed) {
+            continue;
+        }
+        auto key = std::find_if(keys.begin(), keys.end(), [&](const KeymapKey& k) { return k.position.row == event.row && k.position.col == event.col; });
+        if (key == keys.end()) {
+            continue;
+        }
+        auto report = std::find_if(m_reports.begin(), m_reports.end(), [&](const HostReport& r) { return r.sent_us >= event.time_us && report_has_key(r.report, key->report_code); });
+        if (report != m_reports.end()) {
+            latencies.push_back(report->received_us - event.time_us);
+        }
+    }
+    return latencies;
+}
+
+void Simulator::scan() {
+    set_time(m_now_us / 1000);
+    keyboard_task();
+    housekeeping_task();
+}
+
+void Simulator::poll() {
+    if (m_queue.empty()) {
+        return;
+    }
+    HostReport report = m_queue.front();
+    m_queue.pop_front();
+    report.received_us = m_now_us;
+    m_reports.push_back(report);
+    if (m_host) {
+        m_host->send_keyboard(&report.report);
+    }
+}
+
+uint8_t Simulator::keyboard_leds(void) {
+    return m_this->m_host ? m_this->m_host->keyboard_leds() : 0;
+}
+
+void Simulator::send_keyboard(report_keyboard_t* report) {
+    m_this->m_queue.push_back({m_this->m_now_us, 0, *report});
+}
+
+void Simulator::send_nkro(report_nkro_t* report) {
+    if (m_this->m_host) {
+        m_this->m_host->send_nkro(report);
+    }
+}
+
+void Simulator::send_mouse(report_mouse_t* report) {
+    if (m_this->m_host) {
+        m_this->m_host->send_mouse(report);
+    }
+}
+
+void Simulator::send_extra(report_extra_t* report) {
+    if (m_this->m_host) {
+        m_this->m_host->send_extra(report);
+    }
+}
+
+std::vector<TraceEvent> typing_trace(const std::vector<KeymapKey>& keys, uint32_t interval_us, uint32_t hold_us) {
+    std::vector<TraceEvent> trace;
+    uint32_t                time_us = 0;
+
+    for (const KeymapKey& key : keys) {
+        trace.push_back({time_us, key.position.row, key.position.col, true});
+        trace.push_back({time_us + hold_us, key.position.row, key.position.col, false});
+        time_us += interval_us;
+    }
+    std::stable_sort(trace.begin(), trace.end(), [](const TraceEvent& a, const TraceEvent& b) { return a.time_us < b.time_us; });
+    return trace;
+}
+
+std::vector<TraceEvent> parse_trace(std::istream& stream) {
+    std::vector<TraceEvent> trace;
+    std::string             line;
+
+    while (std::getline(stream, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        uint32_t           time_us;
+        unsigned           row, col;
+        char               state;
+        if (fields >> time_us >> row >> col >> state) {
+            trace.push_back({time_us, (uint8_t)row, (uint8_t)col, state == 'd'});
+        }
+    }
+    return trace;
+}
@@ -0,0 +1,136 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <vector>
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "host.h"
+#include "report.h"
+}
+
+/**
+ * @brief A key changing state at a point in time, in microseconds since the start of a trace.
+ */
+struct TraceEvent {
+    uint32_t time_us;
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+};
+
+/**
+ * @brief A keyboard report, with the time it was sent by the keyboard and the time it was polled by the host.
+ */
+struct HostReport {
+    uint32_t          sent_us;
+    uint32_t          received_us;
+    report_keyboard_t report;
+};
+
+struct SimulatorConfig {
+    /* Time between two runs of the keyboard task, 1000 for a 1kHz scan rate. */
+    uint32_t scan_period_us = 1000;
+    /* Time between two polls of the keyboard endpoint by the host, 1000 for a full-speed device polled every frame. */
+    uint32_t usb_poll_interval_us = 1000;
+};
+
+/**
+ * @brief Runs the keyboard against a virtual clock with microsecond resolution.
+ *
+ * Trace events change the matrix at their exact time, and the keyboard sees
+ * them on its next scan. Debouncing happens in the matrix, see
+ * TEST_MATRIX_DEBOUNCE, with the algorithm of DEBOUNCE_TYPE. Keyboard reports
+ * are queued when they are sent, and the host takes one per poll interval,
+ * passing it on to the host driver which was active when the simulator was
+ * created, so that a TestDriver still sees the reports in order. Only the
+ * keyboard endpoint is simulated this way: NKRO, mouse and extra key reports
+ * are passed on straight away, and do not show up in reports().
+ *
+ * The keyboard timer only has millisecond resolution, so it reads the virtual
+ * clock rounded down. The virtual clock is a uint32_t of microseconds, so it
+ * wraps after about 71 minutes, which is as long as a simulation can run.
+ */
+class Simulator {
+   public:
+    explicit Simulator(SimulatorConfig config = SimulatorConfig());
+    ~Simulator();
+
+    /**
+     * @brief Adds events to be played back, with times relative to the current time.
+     */
+    void schedule(const std::vector<TraceEvent>& trace);
+
+    /**
+     * @brief Runs the keyboard until `time_us` has been reached.
+     */
+    void run_until(uint32_t time_us);
+
+    /**
+     * @brief Runs the keyboard for another `duration_us`.
+     */
+    void run_for(uint32_t duration_us);
+
+    /**
+     * @brief Runs the keyboard until all scheduled events have been played and all reports polled, followed by `settle_us` more.
+     */
+    void run_to_end(uint32_t settle_us = 100000);
+
+    uint32_t now_us() const {
+        return m_now_us;
+    }
+
+    const std::vector<HostReport>& reports() const {
+        return m_reports;
+    }
+
+    /**
+     * @brief Latency of each scheduled press, from the event to the host receiving the first report with its key.
+     *
+     * The report code of each key is looked up in `keys`. Presses which never
+     * made it into a report are skipped.
+     */
+    std::vector<uint32_t> press_latencies(const std::vector<KeymapKey>& keys) const;
+
+   private:
+    static uint8_t keyboard_leds(void);
+    static void    send_keyboard(report_keyboard_t* report);
+    static void    send_nkro(report_nkro_t* report);
+    static void    send_mouse(report_mouse_t* report);
+    static void    send_extra(report_extra_t* report);
+
+    void scan();
+    void poll();
+
+    SimulatorConfig         m_config;
+    host_driver_t           m_driver;
+    host_driver_t*          m_host;
+    uint32_t                m_now_us       = 0;
+    uint32_t                m_next_scan_us = 0;
+    uint32_t                m_next_poll_us = 0;
+    std::vector<TraceEvent> m_events;
+    size_t                  m_next_event = 0;
+    std::deque<HostReport>  m_queue;
+    std::vector<HostReport> m_reports;
+    static Simulator*       m_this;
+};
+
+/**
+ * @brief Builds a trace which types `keys` one after another.
+ *
+ * @param interval_us time from one press to the next
+ * @param hold_us time each key is held
+ */
+std::vector<TraceEvent> typing_trace(const std::vector<KeymapKey>& keys, uint32_t interval_us, uint32_t hold_us);
+
+/**
+ * @brief Reads a recorded trace, one event per line as `<time_us> <row> <col> <d|u>`.
+ *
+ * Empty lines and lines starting with `#` are skipped.
+ */
+std::vector<TraceEvent> parse_trace(std::istream& stream);
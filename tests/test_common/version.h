@@ -0,0 +1,10 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Fixed stand-in for the version.h generated for keyboard builds
+
+#define QMK_VERSION "test"
+#define QMK_BUILDDATE "2024-01-01-00:00:00"
+#define QMK_GIT_HASH "test"
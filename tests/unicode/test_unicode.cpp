@@ -84,3 +84,28 @@ TEST_F(Unicode, sends_unicode_string) {
 
     VERIFY_AND_CLEAR(driver);
 }
+
+TEST_F(Unicode, sends_unicode_string_one_sequence_per_character) {
+    TestDriver driver;
+    led_t      leds = {};
+    leds.caps_lock  = true;
+    driver.set_leds(leds.raw);
+
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+
+    // Without UNICODE_BATCH_ENABLE, Caps Lock is toggled around every character
+    {
+        testing::InSequence s;
+
+        for (uint32_t code_point : {0x03A8, 0x03A9}) {
+            EXPECT_REPORT(driver, (KC_CAPS_LOCK));
+            EXPECT_EMPTY_REPORT(driver);
+            EXPECT_UNICODE(driver, code_point);
+            EXPECT_REPORT(driver, (KC_CAPS_LOCK));
+            EXPECT_EMPTY_REPORT(driver);
+        }
+    }
+    send_unicode_string("ΨΩ");
+
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,10 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define UNICODE_BATCH_ENABLE
+#define UNICODE_QUEUE_SIZE 4
+#define UNICODE_QUEUE_TASK_TIME 15
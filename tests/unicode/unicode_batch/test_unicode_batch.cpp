@@ -0,0 +1,268 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+
+namespace {
+
+/* Expects a tap of each key, with `held` down around them if given */
+void expect_taps(TestDriver &driver, std::initializer_list<uint8_t> keys, uint8_t held = KC_NO) {
+    for (uint8_t key : keys) {
+        if (held == KC_NO) {
+            EXPECT_REPORT(driver, (key));
+            EXPECT_EMPTY_REPORT(driver);
+        } else {
+            EXPECT_REPORT(driver, (held, key));
+            EXPECT_REPORT(driver, (held));
+        }
+    }
+}
+
+/* Ψ and Ω, U+03A8 and U+03A9 */
+const char *psi_omega = "\xCE\xA8\xCE\xA9";
+
+} // namespace
+
+class UnicodeBatch : public TestFixture {};
+
+TEST_F(UnicodeBatch, linux_restores_caps_lock_once_per_string) {
+    TestDriver driver;
+    led_t      leds = {};
+    leds.caps_lock  = true;
+    driver.set_leds(leds.raw);
+
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+
+    {
+        testing::InSequence s;
+
+        expect_taps(driver, {KC_CAPS_LOCK});
+        EXPECT_UNICODE(driver, 0x03A8);
+        EXPECT_UNICODE(driver, 0x03A9);
+        expect_taps(driver, {KC_CAPS_LOCK});
+    }
+    send_unicode_string(psi_omega);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(UnicodeBatch, macos_holds_alt_for_whole_string) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_MACOS);
+
+    {
+        testing::InSequence s;
+
+        EXPECT_REPORT(driver, (KC_LEFT_ALT));
+        expect_taps(driver, {KC_0, KC_3, KC_A, KC_8, KC_0, KC_3, KC_A, KC_9}, KC_LEFT_ALT);
+        // 🧙 as a surrogate pair
+        expect_taps(driver, {KC_D, KC_8, KC_3, KC_E, KC_D, KC_D, KC_D, KC_9}, KC_LEFT_ALT);
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    send_unicode_string("\xCE\xA8\xCE\xA9\xF0\x9F\xA7\x99");
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(UnicodeBatch, windows_toggles_num_lock_once_per_string) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_WINDOWS);
+
+    {
+        testing::InSequence s;
+
+        expect_taps(driver, {KC_NUM_LOCK});
+        EXPECT_REPORT(driver, (KC_LEFT_ALT));
+        expect_taps(driver, {KC_KP_PLUS, KC_KP_0, KC_KP_3, KC_A, KC_KP_8}, KC_LEFT_ALT);
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_LEFT_ALT));
+        expect_taps(driver, {KC_KP_PLUS, KC_KP_0, KC_KP_3, KC_A, KC_KP_9}, KC_LEFT_ALT);
+        EXPECT_EMPTY_REPORT(driver);
+        expect_taps(driver, {KC_NUM_LOCK});
+    }
+    send_unicode_string(psi_omega);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(UnicodeBatch, windows_skips_characters_outside_bmp) {
+    TestDriver driver;
+    led_t      leds = {};
+    leds.num_lock   = true;
+    driver.set_leds(leds.raw);
+
+    set_unicode_input_mode(UNICODE_MODE_WINDOWS);
+
+    {
+        testing::InSequence s;
+
+        EXPECT_REPORT(driver, (KC_LEFT_ALT));
+        expect_taps(driver, {KC_KP_PLUS, KC_KP_0, KC_KP_3, KC_A, KC_KP_8}, KC_LEFT_ALT);
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    send_unicode_string("\xF0\x9F\xA7\x99\xCE\xA8");
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(UnicodeBatch, wincompose_sends_sequence_per_character) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_WINCOMPOSE);
+
+    {
+        testing::InSequence s;
+
+        expect_taps(driver, {KC_RIGHT_ALT, KC_U, KC_0, KC_3, KC_A, KC_8, KC_ENTER});
+        expect_taps(driver, {KC_RIGHT_ALT, KC_U, KC_0, KC_3, KC_A, KC_9, KC_ENTER});
+    }
+    send_unicode_string(psi_omega);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(UnicodeBatch, emacs_sends_sequence_per_character) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_EMACS);
+
+    {
+        testing::InSequence s;
+
+        for (uint8_t last_digit : {KC_8, KC_9}) {
+            EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+            EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_X));
+            EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+            EXPECT_EMPTY_REPORT(driver);
+            expect_taps(driver, {KC_8, KC_ENTER, KC_0, KC_3, KC_A, last_digit, KC_ENTER});
+        }
+    }
+    send_unicode_string(psi_omega);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(UnicodeBatch, restores_mods_once_per_string) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    register_code(KC_LEFT_SHIFT);
+    VERIFY_AND_CLEAR(driver);
+
+    // Shift is left out of both sequences, and only put back afterwards
+    {
+        testing::InSequence s;
+
+        EXPECT_UNICODE(driver, 0x03A8);
+        EXPECT_UNICODE(driver, 0x03A9);
+    }
+    send_unicode_string(psi_omega);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(get_mods(), MOD_BIT(KC_LEFT_SHIFT));
+    clear_mods();
+}
+
+TEST_F(UnicodeBatch, queue_is_drained_by_task_in_batches) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_MACOS);
+
+    // nothing is sent until the task runs
+    EXPECT_NO_REPORT(driver);
+    EXPECT_TRUE(queue_unicode_string("\xCE\xA8\xCE\xA9\xCE\xA3"));
+    EXPECT_FALSE(is_unicode_queue_empty());
+    VERIFY_AND_CLEAR(driver);
+
+    // macOS waits only once per batch, so all of them fit in one task
+    {
+        testing::InSequence s;
+
+        EXPECT_REPORT(driver, (KC_LEFT_ALT));
+        expect_taps(driver, {KC_0, KC_3, KC_A, KC_8, KC_0, KC_3, KC_A, KC_9, KC_0, KC_3, KC_A, KC_3}, KC_LEFT_ALT);
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_TRUE(is_unicode_queue_empty());
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(UnicodeBatch, task_stops_starting_characters_after_task_time) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+    EXPECT_TRUE(queue_unicode_string("\xCE\xA8\xCE\xA9\xCE\xA3"));
+
+    // each Linux sequence waits UNICODE_TYPE_DELAY, so only two start within UNICODE_QUEUE_TASK_TIME
+    {
+        testing::InSequence s;
+
+        EXPECT_UNICODE(driver, 0x03A8);
+        EXPECT_UNICODE(driver, 0x03A9);
+    }
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_UNICODE(driver, 0x03A3);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_TRUE(is_unicode_queue_empty());
+}
+
+TEST_F(UnicodeBatch, queue_string_is_all_or_nothing) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+
+    EXPECT_TRUE(queue_unicode(0x03A3));
+    EXPECT_TRUE(queue_unicode(0x03A0));
+    EXPECT_FALSE(queue_unicode_string(psi_omega));
+    EXPECT_TRUE(queue_unicode_string("\xCE\xA6"));
+
+    // none of the string that did not fit was queued
+    {
+        testing::InSequence s;
+
+        EXPECT_UNICODE(driver, 0x03A3);
+        EXPECT_UNICODE(driver, 0x03A0);
+        EXPECT_UNICODE(driver, 0x03A6);
+    }
+    run_one_scan_loop();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_TRUE(is_unicode_queue_empty());
+}
+
+TEST_F(UnicodeBatch, queue_rejects_characters_when_full) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+
+    EXPECT_TRUE(queue_unicode(0x03A8));
+    EXPECT_TRUE(queue_unicode(0x03A9));
+    EXPECT_TRUE(queue_unicode(0x03A3));
+    EXPECT_FALSE(queue_unicode(0x03A0));
+
+    {
+        testing::InSequence s;
+
+        EXPECT_UNICODE(driver, 0x03A8);
+        EXPECT_UNICODE(driver, 0x03A9);
+        EXPECT_UNICODE(driver, 0x03A3);
+    }
+    run_one_scan_loop();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_TRUE(is_unicode_queue_empty());
+}
@@ -0,0 +1,248 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "raw_hid.h"
+#include "via.h"
+}
+
+namespace {
+
+constexpr uint8_t REPORT_SIZE = 32;
+
+using report_t = std::vector<uint8_t>;
+
+/* Stand-in for the configurator, counting the reports in either direction */
+struct Host {
+    std::vector<report_t> replies;
+    size_t                reports_sent = 0;
+    size_t                round_trips  = 0;
+
+    /* Sends a report without waiting for a reply */
+    void send(report_t report) {
+        report.resize(REPORT_SIZE);
+        reports_sent++;
+        raw_hid_receive(report.data(), REPORT_SIZE);
+    }
+
+    /* Sends a report and waits for its reply */
+    report_t transact(report_t report) {
+        size_t expected = replies.size() + 1;
+        send(report);
+        round_trips++;
+        EXPECT_EQ(replies.size(), expected) << "expected a single reply";
+        return replies.empty() ? report_t(REPORT_SIZE) : replies.back();
+    }
+};
+
+Host host;
+
+report_t get_keycode_command(uint8_t layer, uint8_t row, uint8_t col) {
+    return {id_dynamic_keymap_get_keycode, layer, row, col, 0, 0};
+}
+
+report_t set_keycode_command(uint8_t layer, uint8_t row, uint8_t col, uint16_t keycode) {
+    return {id_dynamic_keymap_set_keycode, layer, row, col, (uint8_t)(keycode >> 8), (uint8_t)(keycode & 0xFF)};
+}
+
+/* Packs commands into an id_batch report */
+report_t batch(std::initializer_list<report_t> commands, uint8_t flags = 0) {
+    report_t report = {id_batch, flags, (uint8_t)commands.size()};
+    for (const report_t &command : commands) {
+        report.insert(report.end(), command.begin(), command.end());
+    }
+    EXPECT_LE(report.size(), REPORT_SIZE);
+    return report;
+}
+
+uint16_t keycode_of(const report_t &reply, size_t offset) {
+    return (reply[offset + 4] << 8) | reply[offset + 5];
+}
+
+} // namespace
+
+extern "C" void raw_hid_send(uint8_t *data, uint8_t length) {
+    host.replies.emplace_back(data, data + length);
+}
+
+class ViaBatch : public TestFixture {
+   protected:
+    ViaBatch() {
+        host = Host();
+        dynamic_keymap_reset();
+    }
+};
+
+TEST_F(ViaBatch, LegacyCommandsAreUnchanged) {
+    report_t reply = host.transact({id_get_protocol_version});
+    EXPECT_EQ(reply[0], id_get_protocol_version);
+    EXPECT_EQ((reply[1] << 8) | reply[2], VIA_PROTOCOL_VERSION);
+
+    host.transact(set_keycode_command(1, 2, 3, KC_B));
+    reply = host.transact(get_keycode_command(1, 2, 3));
+    EXPECT_EQ(reply[0], id_dynamic_keymap_get_keycode);
+    EXPECT_EQ(keycode_of(reply, 0), KC_B);
+
+    reply = host.transact({0x7E});
+    EXPECT_EQ(reply[0], id_unhandled);
+}
+
+TEST_F(ViaBatch, AnswersEveryCommandInPlace) {
+    dynamic_keymap_set_keycode(0, 0, 0, KC_A);
+    dynamic_keymap_set_keycode(0, 0, 1, KC_B);
+    dynamic_keymap_set_keycode(2, 3, 9, KC_C);
+
+    report_t reply = host.transact(batch({get_keycode_command(0, 0, 0), get_keycode_command(0, 0, 1), {id_get_protocol_version, 0, 0}, get_keycode_command(2, 3, 9), {id_dynamic_keymap_get_layer_count, 0}}));
+
+    EXPECT_EQ(reply[0], id_batch);
+    EXPECT_EQ(reply[1], 0);
+    EXPECT_EQ(reply[2], 5);
+    EXPECT_EQ(keycode_of(reply, 3), KC_A);
+    EXPECT_EQ(keycode_of(reply, 9), KC_B);
+    EXPECT_EQ((reply[16] << 8) | reply[17], VIA_PROTOCOL_VERSION);
+    EXPECT_EQ(keycode_of(reply, 18), KC_C);
+    EXPECT_EQ(reply[24], id_dynamic_keymap_get_layer_count);
+    EXPECT_EQ(reply[25], dynamic_keymap_get_layer_count());
+}
+
+TEST_F(ViaBatch, CombinesMatrixStateWithOtherCommands) {
+    press_key(9, 0);
+    press_key(2, 3);
+
+    // The whole 4x10 matrix is two bytes a row
+    report_t reply = host.transact(batch({{id_get_keyboard_value, id_switch_matrix_state, 0, 0, 0, 0, 0, 0, 0, 0, 0}, get_keycode_command(0, 3, 2)}));
+
+    EXPECT_EQ(reply[2], 2);
+    EXPECT_EQ(reply, report_t({id_batch, 0, 2, id_get_keyboard_value, id_switch_matrix_state, 0, 0x02, 0x00, 0, 0, 0, 0, 0x00, 0x04, id_dynamic_keymap_get_keycode, 0, 3, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
+
+    clear_all_keys();
+}
+
+TEST_F(ViaBatch, StopsAtUnsupportedCommand) {
+    report_t reply = host.transact(batch({set_keycode_command(0, 1, 1, KC_X), {id_dynamic_keymap_reset}, set_keycode_command(0, 1, 2, KC_Y)}));
+
+    EXPECT_EQ(reply[1], id_batch_error);
+    EXPECT_EQ(reply[2], 1);
+    EXPECT_EQ(reply[9], id_unhandled);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 1), KC_X);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), KC_NO) << "commands after the unsupported one are skipped";
+}
+
+TEST_F(ViaBatch, StopsAtCommandWhichDoesNotFit) {
+    // A buffer read needs 4 bytes plus the data, which only leaves room for 19 bytes after the first command
+    report_t reply = host.transact(batch({get_keycode_command(0, 0, 0), {id_dynamic_keymap_get_buffer, 0, 0, 20}}));
+
+    EXPECT_EQ(reply[1], id_batch_error);
+    EXPECT_EQ(reply[2], 1);
+    EXPECT_EQ(reply[9], id_unhandled);
+
+    reply = host.transact(batch({get_keycode_command(0, 0, 0), {id_dynamic_keymap_get_buffer, 0, 0, 19}}));
+    EXPECT_EQ(reply[1], 0);
+    EXPECT_EQ(reply[2], 2);
+}
+
+TEST_F(ViaBatch, OnlyAnswersLastReportOfSequence) {
+    host.send(batch({set_keycode_command(0, 0, 0, KC_A), set_keycode_command(0, 0, 1, KC_B)}, id_batch_more));
+    host.send(batch({set_keycode_command(0, 0, 2, KC_C)}, id_batch_more));
+    EXPECT_TRUE(host.replies.empty());
+
+    report_t reply = host.transact(batch({get_keycode_command(0, 0, 2)}));
+    EXPECT_EQ(reply[1], 0);
+    EXPECT_EQ(keycode_of(reply, 3), KC_C);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_A);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 1), KC_B);
+}
+
+TEST_F(ViaBatch, ReportsErrorFromEarlierReportOfSequence) {
+    host.send(batch({{id_custom_save, 0}}, id_batch_more));
+    report_t reply = host.transact(batch({set_keycode_command(0, 0, 0, KC_A)}));
+    EXPECT_EQ(reply[1], id_batch_error);
+    EXPECT_EQ(reply[2], 1);
+
+    // The error is cleared once it has been reported
+    reply = host.transact(batch({set_keycode_command(0, 0, 0, KC_A)}));
+    EXPECT_EQ(reply[1], 0);
+}
+
+TEST_F(ViaBatch, KeymapRoundTripsBenchmark) {
+    const uint8_t layers = dynamic_keymap_get_layer_count();
+    auto          keycode_for = [](uint8_t layer, uint8_t row, uint8_t col) { return (uint16_t)(KC_A + (layer * MATRIX_ROWS * MATRIX_COLS + row * MATRIX_COLS + col) % 26); };
+    const size_t  keys        = layers * MATRIX_ROWS * MATRIX_COLS;
+    const size_t  per_report  = (REPORT_SIZE - 3) / 6;
+
+    // Restore and dump a key at a time with the legacy commands
+    for (uint8_t layer = 0; layer < layers; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                host.transact(set_keycode_command(layer, row, col, keycode_for(layer, row, col)));
+            }
+        }
+    }
+    const size_t legacy_restore = host.round_trips;
+    for (uint8_t layer = 0; layer < layers; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                EXPECT_EQ(keycode_of(host.transact(get_keycode_command(layer, row, col)), 0), keycode_for(layer, row, col));
+            }
+        }
+    }
+    const size_t legacy_dump = host.round_trips - legacy_restore;
+
+    // The same with batches, the restore as a single sequence
+    dynamic_keymap_reset();
+    host = Host();
+    std::vector<report_t> commands;
+    for (uint8_t layer = 0; layer < layers; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                commands.push_back(set_keycode_command(layer, row, col, keycode_for(layer, row, col)));
+            }
+        }
+    }
+    for (size_t i = 0; i < commands.size(); i += per_report) {
+        report_t report = {id_batch, 0, 0};
+        for (size_t j = i; j < i + per_report && j < commands.size(); j++) {
+            report.insert(report.end(), commands[j].begin(), commands[j].end());
+            report[2]++;
+        }
+        if (i + per_report < commands.size()) {
+            report[1] = id_batch_more;
+            host.send(report);
+        } else {
+            EXPECT_EQ(host.transact(report)[1], 0);
+        }
+    }
+    const size_t batch_restore         = host.round_trips;
+    const size_t batch_restore_reports = host.reports_sent;
+
+    for (size_t key = 0; key < keys; key += per_report) {
+        report_t report = {id_batch, 0, 0};
+        for (size_t k = key; k < key + per_report && k < keys; k++) {
+            report_t command = get_keycode_command(k / (MATRIX_ROWS * MATRIX_COLS), (k / MATRIX_COLS) % MATRIX_ROWS, k % MATRIX_COLS);
+            report.insert(report.end(), command.begin(), command.end());
+            report[2]++;
+        }
+        report_t reply = host.transact(report);
+        for (uint8_t i = 0; i < reply[2]; i++) {
+            size_t k = key + i;
+            EXPECT_EQ(keycode_of(reply, 3 + i * 6), keycode_for(k / (MATRIX_ROWS * MATRIX_COLS), (k / MATRIX_COLS) % MATRIX_ROWS, k % MATRIX_COLS));
+        }
+    }
+    const size_t batch_dump = host.round_trips - batch_restore;
+
+    EXPECT_EQ(batch_restore, 1u);
+    EXPECT_EQ(batch_dump, (keys + per_report - 1) / per_report);
+
+    RecordProperty("legacy_restore_round_trips", (int)legacy_restore);
+    RecordProperty("batch_restore_round_trips", (int)batch_restore);
+    RecordProperty("legacy_dump_round_trips", (int)legacy_dump);
+    RecordProperty("batch_dump_round_trips", (int)batch_dump);
+    std::printf("[ BENCHMARK] %zu keys: restore %zu round trips legacy, %zu batched (%zu reports for %zu writes), dump %zu legacy, %zu batched\n", keys, legacy_restore, batch_restore, batch_restore_reports, commands.size(), legacy_dump, batch_dump);
+}
@@ -547,14 +547,43 @@ void raw_hid_task(void) {
 
 #ifdef MIDI_ENABLE
 
-void send_midi_packet(MIDI_EventPacket_t *event) {
-    send_report(USB_ENDPOINT_IN_MIDI, (uint8_t *)event, sizeof(MIDI_EventPacket_t));
+#    include "qmk_midi.h"
+
+/**
+ * @brief Send a batch of MIDI event packets to the host in a single transfer.
+ *
+ * @param packets pointer to the packets
+ * @param count number of packets, at most MIDI_PACKET_BATCH_SIZE
+ * @return true Success
+ * @return false Failure
+ */
+bool send_midi_packets(const midi_packet_t *packets, uint8_t count) {
+    return send_report(USB_ENDPOINT_IN_MIDI, (void *)packets, count * sizeof(midi_packet_t));
 }
 
-bool recv_midi_packet(MIDI_EventPacket_t *const event) {
-    return receive_report(USB_ENDPOINT_OUT_MIDI, (uint8_t *)event, sizeof(MIDI_EventPacket_t));
+#    define MIDI_RECEIVE_BUFFER_SIZE (MIDI_STREAM_EPSIZE / sizeof(midi_packet_t))
+
+static midi_packet_t midi_receive_buffer[MIDI_RECEIVE_BUFFER_SIZE];
+
+/**
+ * @brief Receive the MIDI event packets waiting from the host, up to one
+ * endpoint's worth, through the same queue reads as any other report.
+ *
+ * @param count set to the number of packets received
+ * @return pointer to the packets, or NULL if nothing was received
+ */
+const midi_packet_t *recv_midi_packets(uint8_t *count) {
+    uint8_t received = 0;
+    while (received < MIDI_RECEIVE_BUFFER_SIZE && receive_report(USB_ENDPOINT_OUT_MIDI, &midi_receive_buffer[received], sizeof(midi_packet_t))) {
+        received++;
+    }
+
+    *count = received;
+    return received ? midi_receive_buffer : NULL;
 }
 
+void release_midi_packets(void) {}
+
 #endif
 
 #ifdef VIRTSER_ENABLE
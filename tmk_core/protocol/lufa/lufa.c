@@ -673,14 +673,39 @@ USB_ClassInfo_MIDI_Device_t USB_MIDI_Interface = {
 
 // clang-format on
 
-void send_midi_packet(MIDI_EventPacket_t *event) {
-    MIDI_Device_SendEventPacket(&USB_MIDI_Interface, event);
+/** \brief Send MIDI Packets
+ *
+ * Writes the whole batch into the endpoint bank before handing it to the host.
+ */
+bool send_midi_packets(const midi_packet_t *packets, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (MIDI_Device_SendEventPacket(&USB_MIDI_Interface, (const MIDI_EventPacket_t *)&packets[i]) != ENDPOINT_RWSTREAM_NoError) {
+            return false;
+        }
+    }
+    return MIDI_Device_Flush(&USB_MIDI_Interface) == ENDPOINT_READYWAIT_NoError;
 }
 
-bool recv_midi_packet(MIDI_EventPacket_t *const event) {
-    return MIDI_Device_ReceiveEventPacket(&USB_MIDI_Interface, event);
+/** \brief Receive MIDI Packets
+ *
+ * The endpoint bank cannot be addressed directly, so the packets of one bank are read into a buffer.
+ */
+#    define MIDI_RECEIVE_BUFFER_SIZE (MIDI_STREAM_EPSIZE / sizeof(midi_packet_t))
+
+static midi_packet_t midi_receive_buffer[MIDI_RECEIVE_BUFFER_SIZE];
+
+const midi_packet_t *recv_midi_packets(uint8_t *count) {
+    uint8_t received = 0;
+    while (received < MIDI_RECEIVE_BUFFER_SIZE && MIDI_Device_ReceiveEventPacket(&USB_MIDI_Interface, (MIDI_EventPacket_t *)&midi_receive_buffer[received])) {
+        received++;
+    }
+
+    *count = received;
+    return received ? midi_receive_buffer : NULL;
 }
 
+void release_midi_packets(void) {}
+
 #endif
 
 /*******************************************************************************
@@ -0,0 +1,68 @@
+#!/bin/bash
+
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Compiler wrapper for the unit tests, used as CC_PREFIX by build_test.mk.
+#
+# Every test is built with its own features and config.h, but most objects
+# come out the same for all of them, as only a few sources use the settings
+# which differ. Each source is preprocessed first, and the output hashed
+# together with the flags which do not affect preprocessing. Objects compiled
+# from the same input before are copied from the cache instead.
+#
+# Usage: test_object_cache.sh <cache directory> <compiler> [arguments...]
+
+set -o pipefail
+
+cache_dir=$1
+shift
+
+# Only compilation is cached, linking and everything else is passed through
+if [[ " $* " != *" -c "* ]]; then
+    exec "$@"
+fi
+
+if command -v md5sum >/dev/null 2>&1; then
+    md5=(md5sum)
+else
+    md5=(md5 -q)
+fi
+
+compiler=$1
+preprocess_args=()
+hash_args=()
+output=
+next=
+for arg in "${@:2}"; do
+    case $next in
+        output) output=$arg ;;
+        preprocess) preprocess_args+=("$arg") ;;
+    esac
+    if [[ -n $next ]]; then
+        next=
+        continue
+    fi
+
+    case $arg in
+        -c) ;;
+        -o) next=output ;;
+        -include | -MF | -MT | -MQ) preprocess_args+=("$arg"); next=preprocess ;;
+        -D* | -U* | -I* | -M*) preprocess_args+=("$arg") ;;
+        *.c | *.cpp | *.cc | *.S) preprocess_args+=("$arg"); hash_args+=("${arg##*.}") ;;
+        *) preprocess_args+=("$arg"); hash_args+=("$arg") ;;
+    esac
+done
+
+# Line markers are left out, as they name the config.h of each test. This also
+# writes the dependency file, which the compiler would otherwise.
+key=$( { "$compiler" --version; printf '%s\n' "${hash_args[@]}"; "$compiler" -E -P -MT "$output" "${preprocess_args[@]}" 2>/dev/null; } | "${md5[@]}") || exec "$@"
+object=$cache_dir/${key%% *}.o
+
+if [[ -f $object ]]; then
+    exec cp "$object" "$output"
+fi
+
+"$@" || exit
+mkdir -p "$cache_dir"
+cp "$output" "$object.$$" && mv -f "$object.$$" "$object"